@@ -0,0 +1,491 @@
+/* Enemy AI benchmark: builds synthetic zones (open field, maze, corridor),
+   fills them with a configurable enemy crowd around a ship flown on a fixed
+   path, runs the simulation headless and reports mean/p99 time per system
+   plus query counts as JSON, so two builds can be diffed.
+   Build with `make bench_ai`, run from the repo root (it loads sounds). */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <SDL2/SDL.h>
+
+#include "src/audio.h"
+#include "src/burn.h"
+#include "src/corruptor.h"
+#include "src/defender.h"
+#include "src/enemy_registry.h"
+#include "src/enemy_util.h"
+#include "src/entity.h"
+#include "src/fragment.h"
+#include "src/global_render.h"
+#include "src/global_update.h"
+#include "src/hunter.h"
+#include "src/map.h"
+#include "src/mine.h"
+#include "src/player_stats.h"
+#include "src/seeker.h"
+#include "src/ship.h"
+#include "src/skill_drop.h"
+#include "src/spatial_grid.h"
+#include "src/stalker.h"
+#include "src/timer_wheel.h"
+
+#define TICK_MS 16
+#define WARMUP_FRAMES 60
+
+typedef enum {
+	SCENARIO_OPEN,
+	SCENARIO_MAZE,
+	SCENARIO_CORRIDOR,
+	SCENARIO_COUNT
+} Scenario;
+
+static const char *scenarioNames[SCENARIO_COUNT] = {"open", "maze", "corridor"};
+
+typedef enum {
+	ENEMY_HUNTER,
+	ENEMY_SEEKER,
+	ENEMY_DEFENDER,
+	ENEMY_STALKER,
+	ENEMY_CORRUPTOR,
+	ENEMY_MINE,
+	ENEMY_TYPE_COUNT
+} EnemyType;
+
+static const char *enemyNames[ENEMY_TYPE_COUNT] = {
+	"hunters", "seekers", "defenders", "stalkers", "corruptors", "mines"
+};
+
+/* One frame's systems, in the order Mode_Gameplay_update runs them */
+typedef enum {
+	SYSTEM_TIMERS,          /* TimerWheel_advance: respawns */
+	SYSTEM_PRE_COLLISION,   /* enemy projectiles, spark decay, aura maps */
+	SYSTEM_AI,              /* Entity_ai_update_system */
+	SYSTEM_COLLISION,       /* Entity_collision_system */
+	SYSTEM_POST_COLLISION,  /* hazard damage checks: corridors, pools, auras */
+	SYSTEM_BURN,            /* Burn_update_embers */
+	SYSTEM_FRAME,           /* all of the above */
+	SYSTEM_COUNT
+} System;
+
+static const char *systemNames[SYSTEM_COUNT] = {
+	"timers", "pre_collision", "ai", "collision", "post_collision", "burn", "frame"
+};
+
+typedef enum {
+	COUNT_LOS_TESTS,
+	COUNT_LINE_TESTS,
+	COUNT_LINE_BATCH_SEGMENTS,
+	COUNT_DAMAGE_CHECKS,
+	COUNT_COLLISION_PAIRS,
+	COUNT_COLLISIONS,
+	COUNT_COUNT
+} Count;
+
+static const char *countNames[COUNT_COUNT] = {
+	"los_tests", "map_line_tests", "map_line_batch_segments",
+	"damage_checks", "collision_pairs", "collisions"
+};
+
+typedef struct {
+	int frames;
+	unsigned int seed;
+	ZoneTheme theme;
+	int enemies[ENEMY_TYPE_COUNT];
+	bool run[SCENARIO_COUNT];
+	const char *outPath;
+} Options;
+
+typedef struct {
+	double mean;
+	double p99;
+} Timing;
+
+typedef struct {
+	int spawned[ENEMY_TYPE_COUNT];
+	Timing systems[SYSTEM_COUNT];
+	double counts[COUNT_COUNT];   /* per frame */
+} ScenarioResult;
+
+static int grid[MAP_SIZE][MAP_SIZE];
+static double *samples[SYSTEM_COUNT];
+
+/* --- Scenario geometry --- */
+
+static bool is_wall(Scenario scenario, int cx, int cy)
+{
+	switch (scenario) {
+	case SCENARIO_MAZE: {
+		/* 5x5 rooms with a door in the middle of every wall */
+		if (cx < -48 || cx > 48 || cy < -48 || cy > 48)
+			return false;
+		int mx = ((cx % 6) + 6) % 6;
+		int my = ((cy % 6) + 6) % 6;
+		if (mx == 0 && my == 3) return false;
+		if (my == 0 && mx == 3) return false;
+		return mx == 0 || my == 0;
+	}
+	case SCENARIO_CORRIDOR:
+		/* 8 cells tall, 180 long */
+		return cx >= -90 && cx <= 90 && (cy == -5 || cy == 4);
+	default:
+		return false;
+	}
+}
+
+/* Where enemies may spawn, in cells */
+static void spawn_bounds(Scenario scenario, int *minX, int *maxX, int *minY, int *maxY)
+{
+	switch (scenario) {
+	case SCENARIO_CORRIDOR:
+		*minX = -88; *maxX = 88; *minY = -4; *maxY = 3;
+		break;
+	default:
+		*minX = -47; *maxX = 47; *minY = -47; *maxY = 47;
+		break;
+	}
+}
+
+/* The scripted ship: a loop through open space that every enemy type
+   will notice at some point */
+static Position ship_path(Scenario scenario, int frame)
+{
+	double t = frame * TICK_MS / 1000.0;
+	Position p;
+	switch (scenario) {
+	case SCENARIO_MAZE:
+		/* Row of room centres, through the doors */
+		p.x = 4500.0 * sin(t * 0.15);
+		p.y = 3 * MAP_CELL_SIZE + MAP_CELL_SIZE * 0.5;
+		break;
+	case SCENARIO_CORRIDOR:
+		p.x = 8500.0 * sin(t * 0.08);
+		p.y = 0.0;
+		break;
+	default:
+		p.x = 1500.0 * cos(t * 0.3);
+		p.y = 1500.0 * sin(t * 0.3);
+		break;
+	}
+	return p;
+}
+
+static void build_map(Scenario scenario)
+{
+	for (int x = 0; x < MAP_SIZE; x++)
+		for (int y = 0; y < MAP_SIZE; y++)
+			grid[x][y] = is_wall(scenario, x - HALF_MAP_SIZE, y - HALF_MAP_SIZE) ? 0 : -1;
+
+	MapCell wall = {false, false, {20, 60, 120, 255}, {60, 160, 255, 255}};
+	Map_load_cells((const int (*)[MAP_SIZE])grid, &wall, 1);
+	Map_rebuild_adjacency();
+}
+
+static void teardown(void)
+{
+	Mine_cleanup();
+	Hunter_cleanup();
+	Seeker_cleanup();
+	Defender_cleanup();
+	Stalker_cleanup();
+	Corruptor_cleanup();
+	EnemyRegistry_clear();
+	Entity_destroy_all();
+	TimerWheel_clear();
+	GlobalRender_clear();
+	GlobalUpdate_clear();
+}
+
+static void populate(Scenario scenario, const Options *opt, ScenarioResult *result)
+{
+	teardown();
+	SpatialGrid_init();
+	Map_initialize();
+	Ship_initialize();
+	PlayerStats_initialize();
+	Fragment_initialize();
+	SkillDrop_initialize();
+	build_map(scenario);
+
+	Position start = ship_path(scenario, 0);
+	Ship_force_spawn(start);
+	SpatialGrid_set_player_bucket(start.x, start.y);
+
+	int minX, maxX, minY, maxY;
+	spawn_bounds(scenario, &minX, &maxX, &minY, &maxY);
+	srand(opt->seed + (unsigned int)scenario);
+
+	for (int type = 0; type < ENEMY_TYPE_COUNT; type++) {
+		result->spawned[type] = 0;
+		for (int i = 0; i < opt->enemies[type]; i++) {
+			int cx, cy, tries = 0;
+			do {
+				cx = minX + rand() % (maxX - minX + 1);
+				cy = minY + rand() % (maxY - minY + 1);
+			} while (is_wall(scenario, cx, cy) && ++tries < 64);
+			if (tries >= 64)
+				continue;
+
+			Position pos = {(cx + 0.5) * MAP_CELL_SIZE, (cy + 0.5) * MAP_CELL_SIZE};
+			switch (type) {
+			case ENEMY_HUNTER:    Hunter_initialize(pos, opt->theme); break;
+			case ENEMY_SEEKER:    Seeker_initialize(pos, opt->theme); break;
+			case ENEMY_DEFENDER:  Defender_initialize(pos, opt->theme); break;
+			case ENEMY_STALKER:   Stalker_initialize(pos, opt->theme); break;
+			case ENEMY_CORRUPTOR: Corruptor_initialize(pos, opt->theme); break;
+			case ENEMY_MINE:      Mine_initialize(pos, opt->theme); break;
+			}
+			result->spawned[type]++;
+		}
+	}
+}
+
+/* --- Measurement --- */
+
+static double now_us(void)
+{
+	return (double)SDL_GetPerformanceCounter() * 1e6 / (double)SDL_GetPerformanceFrequency();
+}
+
+static int compare_double(const void *a, const void *b)
+{
+	double x = *(const double *)a;
+	double y = *(const double *)b;
+	return (x > y) - (x < y);
+}
+
+static Timing summarize(double *values, int n)
+{
+	Timing t = {0.0, 0.0};
+	if (n == 0)
+		return t;
+	for (int i = 0; i < n; i++)
+		t.mean += values[i];
+	t.mean /= n;
+	qsort(values, (size_t)n, sizeof(double), compare_double);
+	int idx = (int)ceil(n * 0.99) - 1;
+	t.p99 = values[idx < 0 ? 0 : idx];
+	return t;
+}
+
+static void run_scenario(Scenario scenario, const Options *opt, ScenarioResult *result)
+{
+	populate(scenario, opt, result);
+	memset(result->counts, 0, sizeof(result->counts));
+
+	for (int frame = 0; frame < WARMUP_FRAMES + opt->frames; frame++) {
+		bool measured = frame >= WARMUP_FRAMES;
+		int sample = frame - WARMUP_FRAMES;
+
+		Position shipPos = ship_path(scenario, frame);
+		Ship_set_position(shipPos);
+		SpatialGrid_set_player_bucket(shipPos.x, shipPos.y);
+		Audio_set_listener_position(shipPos.x, shipPos.y);
+		Burn_clear_registrations();
+		Map_reset_query_stats();
+		Enemy_reset_query_stats();
+
+		double t[SYSTEM_FRAME + 1];
+		t[0] = now_us();
+		TimerWheel_advance(TICK_MS);
+		t[1] = now_us();
+		GlobalUpdate_pre_collision(TICK_MS);
+		t[2] = now_us();
+		Entity_ai_update_system(TICK_MS);
+		t[3] = now_us();
+		Entity_collision_system();
+		t[4] = now_us();
+		GlobalUpdate_post_collision(TICK_MS);
+		t[5] = now_us();
+		Burn_update_embers(TICK_MS);
+		t[6] = now_us();
+
+		Audio_flush_sfx();
+
+		if (!measured)
+			continue;
+
+		for (int s = 0; s < SYSTEM_FRAME; s++)
+			samples[s][sample] = t[s + 1] - t[s];
+		samples[SYSTEM_FRAME][sample] = t[SYSTEM_FRAME] - t[0];
+
+		const MapQueryStats *map = Map_get_query_stats();
+		const EnemyQueryStats *enemy = Enemy_get_query_stats();
+		const EntityCollisionStats *collision = Entity_get_collision_stats();
+		result->counts[COUNT_LOS_TESTS] += (double)enemy->losTests;
+		result->counts[COUNT_LINE_TESTS] += (double)map->lineTests;
+		result->counts[COUNT_LINE_BATCH_SEGMENTS] += (double)map->batchSegments;
+		result->counts[COUNT_DAMAGE_CHECKS] += (double)enemy->damageChecks;
+		result->counts[COUNT_COLLISION_PAIRS] += collision->pairsTested;
+		result->counts[COUNT_COLLISIONS] += collision->collisions;
+	}
+
+	for (int s = 0; s < SYSTEM_COUNT; s++)
+		result->systems[s] = summarize(samples[s], opt->frames);
+	for (int c = 0; c < COUNT_COUNT; c++)
+		result->counts[c] /= opt->frames;
+}
+
+/* --- Output --- */
+
+static void write_json(FILE *f, const Options *opt, const ScenarioResult *results)
+{
+	fprintf(f, "{\n");
+	fprintf(f, "  \"benchmark\": \"enemy_ai\",\n");
+	fprintf(f, "  \"frames\": %d,\n", opt->frames);
+	fprintf(f, "  \"warmup_frames\": %d,\n", WARMUP_FRAMES);
+	fprintf(f, "  \"tick_ms\": %d,\n", TICK_MS);
+	fprintf(f, "  \"seed\": %u,\n", opt->seed);
+	fprintf(f, "  \"theme\": \"%s\",\n", opt->theme == THEME_FIRE ? "fire" : "none");
+	fprintf(f, "  \"scenarios\": [");
+
+	bool first = true;
+	for (int sc = 0; sc < SCENARIO_COUNT; sc++) {
+		if (!opt->run[sc])
+			continue;
+		const ScenarioResult *r = &results[sc];
+		fprintf(f, "%s\n    {\n", first ? "" : ",");
+		first = false;
+		fprintf(f, "      \"name\": \"%s\",\n", scenarioNames[sc]);
+
+		fprintf(f, "      \"enemies\": {");
+		for (int e = 0; e < ENEMY_TYPE_COUNT; e++)
+			fprintf(f, "%s\"%s\": %d", e ? ", " : "", enemyNames[e], r->spawned[e]);
+		fprintf(f, "},\n");
+
+		fprintf(f, "      \"systems_us\": {\n");
+		for (int s = 0; s < SYSTEM_COUNT; s++)
+			fprintf(f, "        \"%s\": {\"mean\": %.3f, \"p99\": %.3f}%s\n", systemNames[s],
+				r->systems[s].mean, r->systems[s].p99, s < SYSTEM_COUNT - 1 ? "," : "");
+		fprintf(f, "      },\n");
+
+		fprintf(f, "      \"counts_per_frame\": {\n");
+		for (int c = 0; c < COUNT_COUNT; c++)
+			fprintf(f, "        \"%s\": %.2f%s\n", countNames[c], r->counts[c],
+				c < COUNT_COUNT - 1 ? "," : "");
+		fprintf(f, "      }\n");
+		fprintf(f, "    }");
+	}
+	fprintf(f, "\n  ]\n}\n");
+}
+
+static void print_summary(Scenario scenario, const ScenarioResult *r)
+{
+	printf("\n%s\n", scenarioNames[scenario]);
+	for (int s = 0; s < SYSTEM_COUNT; s++)
+		printf("  %-15s mean %9.2f us   p99 %9.2f us\n", systemNames[s],
+			r->systems[s].mean, r->systems[s].p99);
+	for (int c = 0; c < COUNT_COUNT; c++)
+		printf("  %-24s %10.1f / frame\n", countNames[c], r->counts[c]);
+}
+
+static void usage(void)
+{
+	printf("usage: bench_ai [--frames N] [--seed N] [--scenario open|maze|corridor|all]\n"
+		"                [--theme none|fire] [--out PATH]\n"
+		"                [--hunters N] [--seekers N] [--defenders N] [--stalkers N]\n"
+		"                [--corruptors N] [--mines N]\n");
+}
+
+static bool parse_args(int argc, char **argv, Options *opt)
+{
+	opt->frames = 1200;
+	opt->seed = 1;
+	opt->theme = THEME_FIRE;
+	opt->outPath = "bench_ai.json";
+	int defaults[ENEMY_TYPE_COUNT] = {64, 48, 24, 32, 24, 96};
+	memcpy(opt->enemies, defaults, sizeof(defaults));
+	for (int s = 0; s < SCENARIO_COUNT; s++)
+		opt->run[s] = true;
+
+	for (int i = 1; i < argc; i++) {
+		const char *arg = argv[i];
+		const char *val = i + 1 < argc ? argv[i + 1] : NULL;
+		if (!val)
+			return false;
+		i++;
+
+		if (strcmp(arg, "--frames") == 0) {
+			opt->frames = atoi(val);
+		} else if (strcmp(arg, "--seed") == 0) {
+			opt->seed = (unsigned int)strtoul(val, NULL, 10);
+		} else if (strcmp(arg, "--out") == 0) {
+			opt->outPath = val;
+		} else if (strcmp(arg, "--theme") == 0) {
+			if (strcmp(val, "fire") == 0) opt->theme = THEME_FIRE;
+			else if (strcmp(val, "none") == 0) opt->theme = THEME_NONE;
+			else return false;
+		} else if (strcmp(arg, "--scenario") == 0) {
+			bool all = strcmp(val, "all") == 0;
+			bool found = all;
+			for (int s = 0; s < SCENARIO_COUNT; s++) {
+				opt->run[s] = all || strcmp(val, scenarioNames[s]) == 0;
+				found = found || opt->run[s];
+			}
+			if (!found)
+				return false;
+		} else {
+			bool found = false;
+			for (int e = 0; e < ENEMY_TYPE_COUNT; e++) {
+				if (strncmp(arg, "--", 2) == 0 && strcmp(arg + 2, enemyNames[e]) == 0) {
+					opt->enemies[e] = atoi(val);
+					found = true;
+				}
+			}
+			if (!found)
+				return false;
+		}
+	}
+	return opt->frames > 0;
+}
+
+int main(int argc, char **argv)
+{
+	Options opt;
+	if (!parse_args(argc, argv, &opt)) {
+		usage();
+		return 1;
+	}
+
+	/* Sample loading needs an open mixer; no sound card required */
+	SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+	if (SDL_Init(SDL_INIT_AUDIO | SDL_INIT_TIMER) < 0) {
+		printf("bench_ai: SDL_Init failed: %s\n", SDL_GetError());
+		return 1;
+	}
+	Audio_initialize();
+
+	for (int s = 0; s < SYSTEM_COUNT; s++) {
+		samples[s] = malloc(sizeof(double) * (size_t)opt.frames);
+		if (!samples[s]) {
+			printf("bench_ai: out of memory\n");
+			return 1;
+		}
+	}
+
+	static ScenarioResult results[SCENARIO_COUNT];
+	for (int sc = 0; sc < SCENARIO_COUNT; sc++) {
+		if (!opt.run[sc])
+			continue;
+		run_scenario((Scenario)sc, &opt, &results[sc]);
+		print_summary((Scenario)sc, &results[sc]);
+	}
+	teardown();
+
+	FILE *f = fopen(opt.outPath, "w");
+	if (!f) {
+		printf("bench_ai: cannot write %s\n", opt.outPath);
+		return 1;
+	}
+	write_json(f, &opt, results);
+	fclose(f);
+	printf("\nwrote %s\n", opt.outPath);
+
+	for (int s = 0; s < SYSTEM_COUNT; s++)
+		free(samples[s]);
+	Audio_cleanup();
+	SDL_Quit();
+	return 0;
+}
@@ -0,0 +1,199 @@
+/* ECS system microbenchmark: fills the entity pool, frees a quarter of it,
+   then times each system against the per-slot pointer scan it replaced.
+   Build with `make bench_ecs`. */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <SDL2/SDL.h>
+
+#include "src/entity.h"
+#include "src/spatial_grid.h"
+
+#define REPEATS 200
+
+static volatile unsigned long sink;
+
+static void ai_update(void *state, const PlaceableComponent *placeable, const unsigned int ticks)
+{
+	(void)state;
+	sink += (unsigned long)placeable->position.x + ticks;
+}
+
+static void render_main(const void *state, const PlaceableComponent *placeable)
+{
+	(void)state;
+	sink += (unsigned long)placeable->position.y;
+}
+
+static Collision collide(void *state, const PlaceableComponent *placeable, const Rectangle boundingBox)
+{
+	(void)state;
+	Collision collision = {false, true};
+	Rectangle mine = Collision_transform_bounding_box(placeable->position,
+		(Rectangle){-10.0, 10.0, 10.0, -10.0});
+	collision.collisionDetected = Collision_aabb_test(mine, boundingBox);
+	return collision;
+}
+
+static void resolve(void *state, const Collision collision)
+{
+	(void)state;
+	(void)collision;
+	sink++;
+}
+
+static PlaceableComponent placeables[ENTITY_COUNT];
+static RenderableComponent renderable;
+static CollidableComponent collidable = {{-10.0, 10.0, 10.0, -10.0}, true,
+	COLLISION_LAYER_ENEMY, COLLISION_LAYER_ENEMY, collide, resolve};
+static AIUpdatableComponent updatable = {ai_update};
+
+/* The pre-sparse-set layout: every slot scanned, components behind pointers */
+static Entity legacy[ENTITY_COUNT];
+static int legacyHighest;
+
+static void legacy_ai(unsigned int ticks)
+{
+	for (int i = 0; i <= legacyHighest; i++) {
+		if (legacy[i].empty || legacy[i].disabled || legacy[i].aiUpdatable == 0 ||
+			legacy[i].placeable == 0 || legacy[i].state == 0)
+			continue;
+		legacy[i].aiUpdatable->update(legacy[i].state, legacy[i].placeable, ticks);
+	}
+}
+
+static void legacy_render(void)
+{
+	for (int i = 0; i <= legacyHighest; i++) {
+		if (legacy[i].empty || legacy[i].disabled || legacy[i].renderable == 0 ||
+			legacy[i].placeable == 0)
+			continue;
+		if (!SpatialGrid_is_active(legacy[i].placeable->position.x,
+								   legacy[i].placeable->position.y))
+			continue;
+		RenderFunc fn = legacy[i].renderable->passes[RENDER_PASS_MAIN];
+		if (fn) {
+			PlaceableComponent placeable = *legacy[i].placeable;
+			fn(legacy[i].state, &placeable);
+		}
+	}
+}
+
+static void legacy_collision(void)
+{
+	for (int i = 0; i <= legacyHighest; i++) {
+		if (legacy[i].empty || legacy[i].disabled || legacy[i].collidable == 0 ||
+			legacy[i].placeable == 0)
+			continue;
+		if (!legacy[i].collidable->collidesWithOthers)
+			continue;
+		if (!SpatialGrid_is_active(legacy[i].placeable->position.x,
+								   legacy[i].placeable->position.y))
+			continue;
+		for (int j = 0; j <= legacyHighest; j++) {
+			if (legacy[j].empty || legacy[j].disabled || legacy[j].collidable == 0 ||
+				legacy[j].placeable == 0)
+				continue;
+			if (i == j)
+				continue;
+			if (legacy[j].collidable->collidesWithOthers &&
+				!SpatialGrid_is_active(legacy[j].placeable->position.x,
+									   legacy[j].placeable->position.y))
+				continue;
+			if (!(legacy[i].collidable->mask & legacy[j].collidable->layer))
+				continue;
+			Rectangle box = Collision_transform_bounding_box(
+				legacy[i].placeable->position, legacy[i].collidable->boundingBox);
+			Collision collision = legacy[j].collidable->collide(legacy[j].state,
+				legacy[j].placeable, box);
+			if (collision.collisionDetected)
+				legacy[i].collidable->resolve(legacy[i].state, collision);
+		}
+	}
+}
+
+static void populate(void)
+{
+	renderable.passes[RENDER_PASS_MAIN] = render_main;
+
+	Entity_destroy_all();
+	SpatialGrid_init();
+	SpatialGrid_set_player_bucket(0.0, 0.0);
+	srand(1);
+
+	static EntityHandle handles[ENTITY_COUNT];
+	for (int i = 0; i < ENTITY_COUNT; i++) {
+		placeables[i].position.x = (double)(rand() % 6000 - 3000);
+		placeables[i].position.y = (double)(rand() % 6000 - 3000);
+
+		Entity entity = Entity_initialize_entity();
+		entity.state = &placeables[i];
+		entity.placeable = &placeables[i];
+		if (i % 4 != 3)
+			entity.aiUpdatable = &updatable;
+		if (i % 2 == 0)
+			entity.renderable = &renderable;
+		if (i % 32 == 0)
+			entity.collidable = &collidable;
+
+		handles[i] = Entity_create(entity);
+		legacy[handles[i].index] = *Entity_get(handles[i]);
+		if ((int)handles[i].index > legacyHighest)
+			legacyHighest = (int)handles[i].index;
+	}
+
+	/* Churn: a quarter of the pool dies, leaving holes across the range */
+	for (int i = 1; i < ENTITY_COUNT; i += 4) {
+		legacy[handles[i].index].empty = true;
+		Entity_release(handles[i]);
+	}
+}
+
+static double elapsed_us(Uint64 start)
+{
+	return (double)(SDL_GetPerformanceCounter() - start) * 1e6
+		/ (double)SDL_GetPerformanceFrequency() / REPEATS;
+}
+
+static void report(const char *name, double legacyUs, double denseUs)
+{
+	printf("%-10s  slot scan %9.2f us   dense sets %9.2f us   %5.2fx\n",
+		name, legacyUs, denseUs, denseUs > 0.0 ? legacyUs / denseUs : 0.0);
+}
+
+int main(void)
+{
+	populate();
+	printf("%d slots, %d live after churn, %d repeats\n",
+		ENTITY_COUNT, ENTITY_COUNT - ENTITY_COUNT / 4, REPEATS);
+
+	Uint64 t;
+	double a, b;
+
+	t = SDL_GetPerformanceCounter();
+	for (int r = 0; r < REPEATS; r++) legacy_ai(8);
+	a = elapsed_us(t);
+	t = SDL_GetPerformanceCounter();
+	for (int r = 0; r < REPEATS; r++) Entity_ai_update_system(8);
+	b = elapsed_us(t);
+	report("ai", a, b);
+
+	t = SDL_GetPerformanceCounter();
+	for (int r = 0; r < REPEATS; r++) legacy_render();
+	a = elapsed_us(t);
+	t = SDL_GetPerformanceCounter();
+	for (int r = 0; r < REPEATS; r++) Entity_render_pass(RENDER_PASS_MAIN);
+	b = elapsed_us(t);
+	report("render", a, b);
+
+	t = SDL_GetPerformanceCounter();
+	for (int r = 0; r < REPEATS; r++) legacy_collision();
+	a = elapsed_us(t);
+	t = SDL_GetPerformanceCounter();
+	for (int r = 0; r < REPEATS; r++) Entity_collision_system();
+	b = elapsed_us(t);
+	report("collision", a, b);
+
+	return sink == 0;
+}
@@ -0,0 +1,436 @@
+/* Zone load benchmark: loads every .zone in resources/zones plus two
+   synthetic stress zones for a set of master seeds, times each load phase
+   (parse, procgen hotspots/landmarks/terrain/erosion/obstacles, world
+   apply) and hashes the resulting cell grid and spawn table. Hashes must
+   match across repeats within a run (determinism) and across builds for
+   an optimization to count as output-identical. Results go to JSON.
+   Build with `make bench_zone`, run from the repo root. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <dirent.h>
+
+#include <SDL2/SDL.h>
+
+#include "src/audio.h"
+#include "src/entity.h"
+#include "src/map.h"
+#include "src/procgen.h"
+#include "src/spatial_grid.h"
+#include "src/timer_wheel.h"
+#include "src/zone.h"
+
+#define MAX_ZONES 64
+#define MAX_SEEDS 16
+
+#define SYNTH_CELLS_PATH "./bench_zone_synth_cells.zone"
+#define SYNTH_PROCGEN_PATH "./bench_zone_synth_procgen.zone"
+
+typedef enum {
+	PHASE_PARSE,
+	PHASE_HOTSPOTS,
+	PHASE_LANDMARKS,
+	PHASE_TERRAIN,
+	PHASE_EROSION,
+	PHASE_OBSTACLES,
+	PHASE_PROCGEN,   /* sum of the procgen phases plus overhead */
+	PHASE_APPLY,
+	PHASE_TOTAL,
+	PHASE_COUNT
+} Phase;
+
+static const char *phaseNames[PHASE_COUNT] = {
+	"parse", "hotspots", "landmarks", "terrain", "erosion", "obstacles",
+	"procgen", "apply", "total"
+};
+
+typedef struct {
+	uint32_t seed;
+	uint64_t cellHash;
+	uint64_t spawnHash;
+	int walls;
+	int spawns;
+	bool deterministic;
+	double mean[PHASE_COUNT];
+	double min[PHASE_COUNT];
+} SeedResult;
+
+typedef struct {
+	const char *path;   /* points into zonePaths */
+	SeedResult seeds[MAX_SEEDS];
+} ZoneResult;
+
+static char zonePaths[MAX_ZONES][256];
+static int zoneCount;
+static ZoneResult results[MAX_ZONES];
+
+/* --- Hashing (FNV-1a, 64-bit) --- */
+
+static uint64_t fnv_bytes(uint64_t h, const void *data, size_t n)
+{
+	const uint8_t *p = data;
+	for (size_t i = 0; i < n; i++) {
+		h ^= p[i];
+		h *= 1099511628211ull;
+	}
+	return h;
+}
+
+static uint64_t fnv_u32(uint64_t h, uint32_t v)
+{
+	uint8_t b[4] = {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)};
+	return fnv_bytes(h, b, 4);
+}
+
+static uint64_t fnv_f64(uint64_t h, double v)
+{
+	uint64_t bits;
+	memcpy(&bits, &v, sizeof(bits));
+	h = fnv_u32(h, (uint32_t)bits);
+	return fnv_u32(h, (uint32_t)(bits >> 32));
+}
+
+static void hash_zone(const Zone *z, uint64_t *cellHash, uint64_t *spawnHash, int *walls)
+{
+	uint64_t h = 14695981039346656037ull;
+	*walls = 0;
+	for (int x = 0; x < MAP_SIZE; x++)
+		for (int y = 0; y < MAP_SIZE; y++) {
+			h = fnv_u32(h, (uint32_t)z->cell_grid[x][y]);
+			if (z->cell_grid[x][y] >= 0)
+				(*walls)++;
+		}
+	*cellHash = h;
+
+	h = 14695981039346656037ull;
+	for (int i = 0; i < z->spawn_count; i++) {
+		const ZoneSpawn *sp = &z->spawns[i];
+		h = fnv_bytes(h, sp->enemy_type, strlen(sp->enemy_type) + 1);
+		h = fnv_f64(h, sp->world_x);
+		h = fnv_f64(h, sp->world_y);
+		h = fnv_f64(h, sp->probability);
+	}
+	*spawnHash = h;
+}
+
+/* --- Zone list --- */
+
+static int compare_path(const void *a, const void *b)
+{
+	return strcmp((const char *)a, (const char *)b);
+}
+
+static void add_zone(const char *path)
+{
+	if (zoneCount >= MAX_ZONES)
+		return;
+	if (strlen(path) >= sizeof(zonePaths[0])) {
+		printf("bench_zone: skipping %s (path too long)\n", path);
+		return;
+	}
+	strcpy(zonePaths[zoneCount++], path);
+}
+
+static void scan_zones(void)
+{
+	DIR *dir = opendir("./resources/zones");
+	if (!dir) {
+		printf("bench_zone: cannot open ./resources/zones (run from the repo root)\n");
+		return;
+	}
+	struct dirent *entry;
+	while ((entry = readdir(dir)) != NULL) {
+		size_t len = strlen(entry->d_name);
+		if (len < 6 || strcmp(entry->d_name + len - 5, ".zone") != 0)
+			continue;
+		char path[sizeof(zonePaths[0])];
+		int n = snprintf(path, sizeof(path), "./resources/zones/%s", entry->d_name);
+		if (n < 0 || (size_t)n >= sizeof(path)) {
+			printf("bench_zone: skipping %s (path too long)\n", entry->d_name);
+			continue;
+		}
+		add_zone(path);
+	}
+	closedir(dir);
+	qsort(zonePaths, (size_t)zoneCount, sizeof(zonePaths[0]), compare_path);
+}
+
+/* Hand-authored stress case: a big cell pattern and a dense spawn table,
+   all parsing and world apply, no procgen */
+static bool write_synth_cells(void)
+{
+	FILE *f = fopen(SYNTH_CELLS_PATH, "w");
+	if (!f)
+		return false;
+	fprintf(f, "name Synthetic Cells\nsize 1024\n");
+	fprintf(f, "celltype solid 20 0 20 255 128 0 128 255 none\n");
+	fprintf(f, "celltype circuit 10 20 20 180 64 128 128 255 circuit\n");
+	for (int x = 212; x < 812; x++)
+		for (int y = 212; y < 812; y++)
+			if ((x * 7 + y * 13) % 5 == 0)
+				fprintf(f, "cell %d %d %s\n", x, y, (x + y) % 3 ? "solid" : "circuit");
+
+	static const char *types[] = {"hunter", "seeker", "defender", "stalker", "corruptor", "mine"};
+	uint32_t lcg = 12345u;
+	for (int i = 0; i < 20000; i++) {
+		lcg = lcg * 1664525u + 1013904223u;
+		double wx = (double)((int)(lcg >> 8) % 60000 - 30000);
+		lcg = lcg * 1664525u + 1013904223u;
+		double wy = (double)((int)(lcg >> 8) % 60000 - 30000);
+		fprintf(f, "spawn %s %.1f %.1f\n", types[i % 6], wx, wy);
+	}
+	fclose(f);
+	return true;
+}
+
+/* Procgen stress case: more octaves, hotspots and obstacles than any
+   shipped zone */
+static bool write_synth_procgen(void)
+{
+	FILE *f = fopen(SYNTH_PROCGEN_PATH, "w");
+	if (!f)
+		return false;
+	fprintf(f,
+		"name Synthetic Procgen\n"
+		"size 1024\n"
+		"celltype solid 20 0 20 255 128 0 128 255 none\n"
+		"celltype circuit 10 20 20 180 64 128 128 255 circuit\n"
+		"procgen true\n"
+		"noise_octaves 8\n"
+		"noise_frequency 0.012\n"
+		"noise_lacunarity 2\n"
+		"noise_persistence 0.5\n"
+		"noise_wall_threshold -0.2\n"
+		"hotspot_count 32\n"
+		"hotspot_edge_margin 60\n"
+		"hotspot_min_separation 100\n"
+		"landmark_min_separation 90\n"
+		"landmark player_start resources/chunks/save_001.chunk 1 moderate 80 0.6 2\n"
+		"landmark_savepoint player_start save_start\n");
+	for (int i = 1; i <= 12; i++)
+		fprintf(f, "landmark synth_node_%02d resources/chunks/data_node_001.chunk 2 dense 90 0.7 2\n", i);
+	fprintf(f,
+		"obstacle_density 0.12\n"
+		"obstacle_min_spacing 3\n"
+		"obstacle cross_001 1\n"
+		"obstacle patrol_001 1\n"
+		"obstacle minefield_001 0.5\n");
+	fclose(f);
+	return true;
+}
+
+/* --- Measurement --- */
+
+static void reset_world(void)
+{
+	Zone_unload();
+	Entity_destroy_all();
+	TimerWheel_clear();
+	SpatialGrid_init();
+	Map_initialize();
+}
+
+static void load_once(const char *path, uint32_t seed, double phases[PHASE_COUNT])
+{
+	reset_world();
+	Procgen_set_master_seed(seed);
+
+	Uint64 start = SDL_GetPerformanceCounter();
+	Zone_load(path);
+	double total = (double)(SDL_GetPerformanceCounter() - start) * 1000.0
+		/ (double)SDL_GetPerformanceFrequency();
+
+	const ZoneLoadTimings *zt = Zone_get_load_timings();
+	const ProcgenTimings *pt = Procgen_get_timings();
+	phases[PHASE_PARSE] = zt->parse;
+	phases[PHASE_HOTSPOTS] = pt->hotspots;
+	phases[PHASE_LANDMARKS] = pt->landmarks;
+	phases[PHASE_TERRAIN] = pt->terrain;
+	phases[PHASE_EROSION] = pt->erosion;
+	phases[PHASE_OBSTACLES] = pt->obstacles;
+	phases[PHASE_PROCGEN] = zt->procgen;
+	phases[PHASE_APPLY] = zt->apply;
+	phases[PHASE_TOTAL] = total;
+}
+
+static void bench_zone(const char *path, const uint32_t *seeds, int seedCount,
+	int repeats, ZoneResult *out)
+{
+	out->path = path;
+
+	for (int s = 0; s < seedCount; s++) {
+		SeedResult *r = &out->seeds[s];
+		memset(r, 0, sizeof(*r));
+		r->seed = seeds[s];
+		r->deterministic = true;
+
+		for (int rep = 0; rep < repeats; rep++) {
+			double phases[PHASE_COUNT];
+			load_once(path, seeds[s], phases);
+
+			uint64_t cellHash, spawnHash;
+			int walls;
+			hash_zone(Zone_get(), &cellHash, &spawnHash, &walls);
+			if (rep == 0) {
+				r->cellHash = cellHash;
+				r->spawnHash = spawnHash;
+				r->walls = walls;
+				r->spawns = Zone_get()->spawn_count;
+			} else if (cellHash != r->cellHash || spawnHash != r->spawnHash) {
+				r->deterministic = false;
+			}
+
+			for (int p = 0; p < PHASE_COUNT; p++) {
+				r->mean[p] += phases[p] / repeats;
+				if (rep == 0 || phases[p] < r->min[p])
+					r->min[p] = phases[p];
+			}
+		}
+
+		if (!r->deterministic)
+			printf("WARNING: bench_zone: %s seed %u produced different output across repeats\n",
+				path, seeds[s]);
+	}
+}
+
+/* --- Output --- */
+
+static void write_json(FILE *f, const uint32_t *seeds, int seedCount, int repeats)
+{
+	fprintf(f, "{\n");
+	fprintf(f, "  \"benchmark\": \"zone_load\",\n");
+	fprintf(f, "  \"repeats\": %d,\n", repeats);
+	fprintf(f, "  \"seeds\": [");
+	for (int s = 0; s < seedCount; s++)
+		fprintf(f, "%s%u", s ? ", " : "", seeds[s]);
+	fprintf(f, "],\n");
+	fprintf(f, "  \"zones\": [");
+
+	for (int z = 0; z < zoneCount; z++) {
+		const ZoneResult *zr = &results[z];
+		fprintf(f, "%s\n    {\n", z ? "," : "");
+		fprintf(f, "      \"path\": \"%s\",\n", zr->path);
+		fprintf(f, "      \"runs\": [");
+		for (int s = 0; s < seedCount; s++) {
+			const SeedResult *r = &zr->seeds[s];
+			fprintf(f, "%s\n        {\n", s ? "," : "");
+			fprintf(f, "          \"seed\": %u,\n", r->seed);
+			fprintf(f, "          \"cell_hash\": \"%016llx\",\n", (unsigned long long)r->cellHash);
+			fprintf(f, "          \"spawn_hash\": \"%016llx\",\n", (unsigned long long)r->spawnHash);
+			fprintf(f, "          \"walls\": %d,\n", r->walls);
+			fprintf(f, "          \"spawns\": %d,\n", r->spawns);
+			fprintf(f, "          \"deterministic\": %s,\n", r->deterministic ? "true" : "false");
+			fprintf(f, "          \"ms\": {\n");
+			for (int p = 0; p < PHASE_COUNT; p++)
+				fprintf(f, "            \"%s\": {\"mean\": %.3f, \"min\": %.3f}%s\n", phaseNames[p],
+					r->mean[p], r->min[p], p < PHASE_COUNT - 1 ? "," : "");
+			fprintf(f, "          }\n");
+			fprintf(f, "        }");
+		}
+		fprintf(f, "\n      ]\n");
+		fprintf(f, "    }");
+	}
+	fprintf(f, "\n  ]\n}\n");
+}
+
+static void print_summary(int seedCount)
+{
+	printf("\n%-44s %10s %8s %8s %8s %8s  %-16s\n",
+		"zone", "seed", "parse", "procgen", "apply", "total", "cell hash");
+	for (int z = 0; z < zoneCount; z++) {
+		const ZoneResult *zr = &results[z];
+		for (int s = 0; s < seedCount; s++) {
+			const SeedResult *r = &zr->seeds[s];
+			printf("%-44s %10u %8.2f %8.2f %8.2f %8.2f  %016llx%s\n", zr->path, r->seed,
+				r->mean[PHASE_PARSE], r->mean[PHASE_PROCGEN], r->mean[PHASE_APPLY],
+				r->mean[PHASE_TOTAL], (unsigned long long)r->cellHash,
+				r->deterministic ? "" : "  NONDETERMINISTIC");
+		}
+	}
+}
+
+static void usage(void)
+{
+	printf("usage: bench_zone [--seeds N] [--repeats N] [--zone PATH] [--no-synthetic]\n"
+		"                  [--out PATH]\n"
+		"  --seeds N     master seeds 1..N (default 3)\n"
+		"  --zone PATH   only this zone (repeatable)\n");
+}
+
+int main(int argc, char **argv)
+{
+	int seedCount = 3;
+	int repeats = 3;
+	bool synthetic = true;
+	bool scan = true;
+	const char *outPath = "bench_zone.json";
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--no-synthetic") == 0) {
+			synthetic = false;
+		} else if (i + 1 < argc && strcmp(argv[i], "--seeds") == 0) {
+			seedCount = atoi(argv[++i]);
+		} else if (i + 1 < argc && strcmp(argv[i], "--repeats") == 0) {
+			repeats = atoi(argv[++i]);
+		} else if (i + 1 < argc && strcmp(argv[i], "--out") == 0) {
+			outPath = argv[++i];
+		} else if (i + 1 < argc && strcmp(argv[i], "--zone") == 0) {
+			add_zone(argv[++i]);
+			scan = false;
+		} else {
+			usage();
+			return 1;
+		}
+	}
+	if (seedCount < 1 || seedCount > MAX_SEEDS || repeats < 1) {
+		usage();
+		return 1;
+	}
+
+	/* Savepoints and data nodes load sounds during world apply */
+	SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+	if (SDL_Init(SDL_INIT_AUDIO | SDL_INIT_TIMER) < 0) {
+		printf("bench_zone: SDL_Init failed: %s\n", SDL_GetError());
+		return 1;
+	}
+	Audio_initialize();
+
+	if (scan)
+		scan_zones();
+	if (synthetic) {
+		if (write_synth_cells())
+			add_zone(SYNTH_CELLS_PATH);
+		if (write_synth_procgen())
+			add_zone(SYNTH_PROCGEN_PATH);
+	}
+
+	uint32_t seeds[MAX_SEEDS];
+	for (int s = 0; s < seedCount; s++)
+		seeds[s] = (uint32_t)(s + 1);
+
+	for (int z = 0; z < zoneCount; z++)
+		bench_zone(zonePaths[z], seeds, seedCount, repeats, &results[z]);
+	reset_world();
+
+	if (synthetic) {
+		remove(SYNTH_CELLS_PATH);
+		remove(SYNTH_PROCGEN_PATH);
+	}
+
+	print_summary(seedCount);
+
+	FILE *f = fopen(outPath, "w");
+	if (!f) {
+		printf("bench_zone: cannot write %s\n", outPath);
+		return 1;
+	}
+	write_json(f, seeds, seedCount, repeats);
+	fclose(f);
+	printf("\nwrote %s\n", outPath);
+
+	Audio_cleanup();
+	SDL_Quit();
+	return 0;
+}
@@ -1,5 +1,7 @@
 #include "audio.h"
 #include <math.h>
+#include <stdbool.h>
+#include <string.h>
 
 static Mix_Music *music = NULL;
 
@@ -13,6 +15,36 @@ static float listenerY = 0.0f;
 #define SPATIAL_FULL_RADIUS  1600.0f
 #define SPATIAL_MAX_RADIUS   6400.0f
 
+/* SFX scheduler — play calls are queued and resolved once per frame so
+   identical sounds coalesce and a crowded fight can't saturate the mixer */
+#define SFX_CHANNEL_COUNT    64
+#define SFX_FIRST_CHANNEL    5      /* 0-4 are reserved dedicated channels */
+#define SFX_MAX_PENDING      64
+#define SFX_MAX_INSTANCES    4      /* concurrent voices of one sample */
+#define SFX_MIN_AUDIBLE      0.02f  /* final gain below this is culled */
+#define SFX_PRIORITY_GLOBAL  2.0f   /* non-positional sounds outrank world sounds */
+
+typedef struct {
+	Mix_Chunk *chunk;
+	float volume;
+	float priority;
+} SfxRequest;
+
+typedef struct {
+	Mix_Chunk *chunk;   /* NULL = free */
+	float priority;
+	unsigned int frame;
+} SfxVoice;
+
+static SfxRequest sfxPending[SFX_MAX_PENDING];
+static int sfxPendingCount = 0;
+static SfxVoice sfxVoices[SFX_CHANNEL_COUNT];
+static unsigned int sfxFrame = 0;
+static AudioSfxStats sfxFrameStats;
+static AudioSfxStats sfxLastStats;
+
+static void queue_sfx(Mix_Chunk *chunk, float volume, float priority);
+
 // TODO audio files/resonrces SHOUD be managed here, not in the entities
 
 void Audio_initialize(void)
@@ -21,10 +53,15 @@ void Audio_initialize(void)
 		printf( "SDL_mixer could not initialize! SDL_mixer Error: %s\n", Mix_GetError() );
 		exit(-1);
 	}
-	Mix_AllocateChannels(64);
+	Mix_AllocateChannels(SFX_CHANNEL_COUNT);
 	/* Reserve channels 0-4 so Mix_PlayChannel(-1) won't stomp dedicated channels
 	   (1=rebirth, 2=voice, 4=savepoint charge) */
-	Mix_ReserveChannels(5);
+	Mix_ReserveChannels(SFX_FIRST_CHANNEL);
+
+	memset(sfxVoices, 0, sizeof(sfxVoices));
+	memset(&sfxFrameStats, 0, sizeof(sfxFrameStats));
+	memset(&sfxLastStats, 0, sizeof(sfxLastStats));
+	sfxPendingCount = 0;
 }
 
 void Audio_cleanup(void)
@@ -75,8 +112,8 @@ void Audio_unload_sample(Mix_Chunk **sample)
 
 void Audio_play_sample(Mix_Chunk **sample)
 {
-	if (Mix_PlayChannel(-1, *sample, 0) == -1)
-		printf("WARNING: out of audio channels: %s\n", Mix_GetError());
+	sfxFrameStats.requested++;
+	queue_sfx(*sample, 1.0f, SFX_PRIORITY_GLOBAL);
 }
 
 void Audio_set_listener_position(float x, float y)
@@ -99,15 +136,147 @@ static float spatial_volume(float x, float y)
 
 void Audio_play_sample_at(Mix_Chunk **sample, Position pos)
 {
+	sfxFrameStats.requested++;
 	float vol = spatial_volume((float)pos.x, (float)pos.y);
-	if (vol <= 0.0f)
+	if (vol * masterSFX < SFX_MIN_AUDIBLE) {
+		sfxFrameStats.culled++;
 		return;
-	int ch = Mix_PlayChannel(-1, *sample, 0);
-	if (ch == -1) {
-		printf("WARNING: out of audio channels: %s\n", Mix_GetError());
+	}
+	/* Audibility doubles as priority: near sounds win voices over far ones */
+	queue_sfx(*sample, vol, vol);
+}
+
+static void queue_sfx(Mix_Chunk *chunk, float volume, float priority)
+{
+	if (!chunk)
+		return;
+
+	/* Same sample twice in one frame is one louder-of-the-two sound */
+	for (int i = 0; i < sfxPendingCount; i++) {
+		SfxRequest *r = &sfxPending[i];
+		if (r->chunk != chunk)
+			continue;
+		if (volume > r->volume) r->volume = volume;
+		if (priority > r->priority) r->priority = priority;
+		sfxFrameStats.coalesced++;
+		return;
+	}
+
+	if (sfxPendingCount < SFX_MAX_PENDING) {
+		SfxRequest *r = &sfxPending[sfxPendingCount++];
+		r->chunk = chunk;
+		r->volume = volume;
+		r->priority = priority;
+		return;
+	}
+
+	/* Queue full — displace the least important request */
+	int lowest = 0;
+	for (int i = 1; i < sfxPendingCount; i++) {
+		if (sfxPending[i].priority < sfxPending[lowest].priority)
+			lowest = i;
+	}
+	sfxFrameStats.dropped++;
+	if (sfxPending[lowest].priority < priority) {
+		sfxPending[lowest].chunk = chunk;
+		sfxPending[lowest].volume = volume;
+		sfxPending[lowest].priority = priority;
+	}
+}
+
+/* True if voice a is a better steal candidate than voice b */
+static bool voice_cheaper(const SfxVoice *a, const SfxVoice *b)
+{
+	if (a->priority != b->priority)
+		return a->priority < b->priority;
+	return a->frame < b->frame;
+}
+
+static void start_voice(int ch, const SfxRequest *r)
+{
+	if (Mix_PlayChannel(ch, r->chunk, 0) == -1) {
+		sfxFrameStats.dropped++;
 		return;
 	}
-	Mix_Volume(ch, (int)(vol * masterSFX * MIX_MAX_VOLUME));
+	Mix_Volume(ch, (int)(r->volume * masterSFX * MIX_MAX_VOLUME));
+	sfxVoices[ch].chunk = r->chunk;
+	sfxVoices[ch].priority = r->priority;
+	sfxVoices[ch].frame = sfxFrame;
+	sfxFrameStats.played++;
+}
+
+static void steal_voice(int ch, const SfxRequest *r)
+{
+	Mix_HaltChannel(ch);
+	sfxVoices[ch].chunk = NULL;
+	sfxFrameStats.stolen++;
+	start_voice(ch, r);
+}
+
+void Audio_flush_sfx(void)
+{
+	/* Retire voices the mixer has finished with */
+	for (int ch = SFX_FIRST_CHANNEL; ch < SFX_CHANNEL_COUNT; ch++) {
+		if (sfxVoices[ch].chunk && !Mix_Playing(ch))
+			sfxVoices[ch].chunk = NULL;
+	}
+
+	/* Highest priority first so important sounds claim voices before the rest */
+	for (int i = 1; i < sfxPendingCount; i++) {
+		SfxRequest tmp = sfxPending[i];
+		int j = i - 1;
+		while (j >= 0 && sfxPending[j].priority < tmp.priority) {
+			sfxPending[j + 1] = sfxPending[j];
+			j--;
+		}
+		sfxPending[j + 1] = tmp;
+	}
+
+	for (int i = 0; i < sfxPendingCount; i++) {
+		const SfxRequest *r = &sfxPending[i];
+		int instances = 0;
+		int sameVictim = -1;
+		int freeCh = -1;
+		int victim = -1;
+
+		for (int ch = SFX_FIRST_CHANNEL; ch < SFX_CHANNEL_COUNT; ch++) {
+			SfxVoice *v = &sfxVoices[ch];
+			if (!v->chunk) {
+				if (freeCh < 0) freeCh = ch;
+				continue;
+			}
+			if (v->chunk == r->chunk) {
+				instances++;
+				if (sameVictim < 0 || voice_cheaper(v, &sfxVoices[sameVictim]))
+					sameVictim = ch;
+			}
+			if (victim < 0 || voice_cheaper(v, &sfxVoices[victim]))
+				victim = ch;
+		}
+
+		if (instances >= SFX_MAX_INSTANCES) {
+			if (sfxVoices[sameVictim].priority < r->priority)
+				steal_voice(sameVictim, r);
+			else
+				sfxFrameStats.capped++;
+		} else if (freeCh >= 0) {
+			start_voice(freeCh, r);
+		} else if (victim >= 0 && sfxVoices[victim].priority < r->priority) {
+			steal_voice(victim, r);
+		} else {
+			sfxFrameStats.dropped++;
+		}
+	}
+
+	sfxPendingCount = 0;
+	sfxLastStats = sfxFrameStats;
+	memset(&sfxFrameStats, 0, sizeof(sfxFrameStats));
+	sfxFrame++;
+}
+
+const AudioSfxStats *Audio_get_sfx_stats(void)
+{
+	return &sfxLastStats;
 }
 
 int Audio_play_sample_on_channel(Mix_Chunk **sample, int channel)
@@ -140,7 +309,7 @@ void Audio_set_master_sfx(float vol)
 	if (vol < 0.0f) vol = 0.0f;
 	if (vol > 1.0f) vol = 1.0f;
 	masterSFX = vol;
-	for (int ch = 0; ch < 64; ch++) {
+	for (int ch = 0; ch < SFX_CHANNEL_COUNT; ch++) {
 		if (ch == VOICE_CHANNEL) continue;
 		Mix_Volume(ch, (int)(masterSFX * MIX_MAX_VOLUME));
 	}
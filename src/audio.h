@@ -6,6 +6,17 @@
 
 #define VOICE_CHANNEL 2
 
+/* Per-frame SFX scheduler counters (see Audio_flush_sfx) */
+typedef struct {
+	int requested;   /* play calls made this frame */
+	int coalesced;   /* merged into an identical sound already queued */
+	int culled;      /* too quiet at the listener to bother mixing */
+	int capped;      /* dropped by the per-sample instance cap */
+	int dropped;     /* no voice free and nothing cheaper to steal */
+	int stolen;      /* lower-priority voices cut to make room */
+	int played;      /* voices actually started */
+} AudioSfxStats;
+
 // TODO need to incororate this struct into sample calls
 typedef struct {
 	Mix_Chunk *mix_chunk;
@@ -27,6 +38,8 @@ void Audio_fade_out_channel(int channel, int ms);
 void Audio_boost_sample(Mix_Chunk *chunk, float gain);
 
 void Audio_set_listener_position(float x, float y);
+void Audio_flush_sfx(void);
+const AudioSfxStats *Audio_get_sfx_stats(void);
 
 void  Audio_set_master_music(float vol);
 float Audio_get_master_music(void);
@@ -0,0 +1,86 @@
+#include "aura_map.h"
+
+#include <stdio.h>
+
+#include "cell_hash.h"
+
+void AuraMap_init(AuraMap *map, double cell_size)
+{
+	map->cellSize = cell_size;
+	for (int i = 0; i < AURA_MAP_CAPACITY; i++)
+		map->bucket[i] = -1;
+	for (int b = 0; b < AURA_MAP_BUCKETS; b++)
+		map->head[b] = -1;
+	map->count = 0;
+}
+
+void AuraMap_clear(AuraMap *map)
+{
+	/* Only registered owners have a slot to reset */
+	for (int b = 0; b < AURA_MAP_BUCKETS; b++) {
+		for (int e = map->head[b]; e >= 0; e = map->next[e])
+			map->bucket[e] = -1;
+		map->head[b] = -1;
+	}
+	map->count = 0;
+}
+
+static void unlink_owner(AuraMap *map, int owner)
+{
+	int *link = &map->head[map->bucket[owner]];
+	while (*link != owner)
+		link = &map->next[*link];
+	*link = map->next[owner];
+	map->bucket[owner] = -1;
+	map->count--;
+}
+
+void AuraMap_insert(AuraMap *map, int owner, Position center)
+{
+	if (owner < 0 || owner >= AURA_MAP_CAPACITY) {
+		printf("WARNING: aura map owner %d out of range\n", owner);
+		return;
+	}
+
+	int cx = CellHash_coord(center.x, map->cellSize);
+	int cy = CellHash_coord(center.y, map->cellSize);
+	if (map->bucket[owner] >= 0) {
+		if (map->cellX[owner] == cx && map->cellY[owner] == cy)
+			return;
+		unlink_owner(map, owner);
+	}
+
+	int b = CellHash_bucket(cx, cy, AURA_MAP_BUCKETS);
+	map->bucket[owner] = b;
+	map->cellX[owner] = cx;
+	map->cellY[owner] = cy;
+	map->next[owner] = map->head[b];
+	map->head[b] = owner;
+	map->count++;
+}
+
+int AuraMap_find(const AuraMap *map, Position pos, double reach,
+	AuraMatchFunc match, void *context)
+{
+	if (map->count == 0)
+		return -1;
+
+	int cx0 = CellHash_coord(pos.x - reach, map->cellSize);
+	int cx1 = CellHash_coord(pos.x + reach, map->cellSize);
+	int cy0 = CellHash_coord(pos.y - reach, map->cellSize);
+	int cy1 = CellHash_coord(pos.y + reach, map->cellSize);
+
+	for (int cx = cx0; cx <= cx1; cx++) {
+		for (int cy = cy0; cy <= cy1; cy++) {
+			int b = CellHash_bucket(cx, cy, AURA_MAP_BUCKETS);
+			for (int e = map->head[b]; e >= 0; e = map->next[e]) {
+				/* Skip other cells sharing this bucket */
+				if (map->cellX[e] != cx || map->cellY[e] != cy)
+					continue;
+				if (match(e, pos, context))
+					return e;
+			}
+		}
+	}
+	return -1;
+}
@@ -0,0 +1,47 @@
+#ifndef AURA_MAP_H
+#define AURA_MAP_H
+
+#include <stdbool.h>
+
+#include "position.h"
+
+/*
+ * Per-frame registry of support auras (defender aegis, corruptor
+ * resist/temper, defender escort assignments). Each owner index has one
+ * slot: owners clear and refill their map once per frame from a
+ * pre-collision hook, and re-insert whenever an aura moves or switches on
+ * mid-frame, which moves the slot to the new cell. Slots are only dropped
+ * by the next clear, so queries re-check the owner's live state through a
+ * callback and stop at the first match.
+ */
+#define AURA_MAP_CAPACITY 4096  /* owner indices, matches the enemy pools */
+#define AURA_MAP_BUCKETS 1024
+/* Added to an aura's radius when querying: owners are indexed where they
+   were at their last update, and may have moved since */
+#define AURA_SLACK 50.0
+
+typedef struct {
+	double cellSize;
+	int count;
+	int head[AURA_MAP_BUCKETS];
+	int next[AURA_MAP_CAPACITY];
+	int bucket[AURA_MAP_CAPACITY];	/* -1 = not registered */
+	int cellX[AURA_MAP_CAPACITY];
+	int cellY[AURA_MAP_CAPACITY];
+} AuraMap;
+
+/* Exact test for one candidate: true if owner's aura covers pos */
+typedef bool (*AuraMatchFunc)(int owner, Position pos, void *context);
+
+/* cell_size should be about the aura radius */
+void AuraMap_init(AuraMap *map, double cell_size);
+void AuraMap_clear(AuraMap *map);
+/* Register owner's aura at center, replacing its previous entry */
+void AuraMap_insert(AuraMap *map, int owner, Position center);
+
+/* First owner registered within `reach` of pos (hash neighbours excluded)
+   for which match returns true, or -1. */
+int AuraMap_find(const AuraMap *map, Position pos, double reach,
+	AuraMatchFunc match, void *context);
+
+#endif
@@ -1,6 +1,9 @@
 #include "background.h"
 
+#include <OpenGL/gl3.h>
 #include <math.h>
+#include <stdio.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include "render.h"
@@ -55,6 +58,71 @@ typedef struct {
 static Layer layers[NUM_LAYERS];
 static float bg_time = 0.0f;
 
+/*
+ * Blob shapes never change after Background_initialize, so every blob is
+ * baked once into a static VBO as a triangle fan (center + IRREG_SEGS rim
+ * vertices). Drift, parallax and pulse are evaluated in the vertex shader
+ * from per-layer uniforms, and the tile repeat is instanced — one draw call
+ * per layer.
+ */
+typedef struct {
+	float cx, cy;           /* blob base position */
+	float ox, oy;           /* rim offset at unit pulse (0 for the center) */
+	float r, g, b, a;
+	float drift_dx, drift_dy;
+	float pulse_phase, pulse_speed;
+} BlobVertex;
+
+#define VERTS_PER_BLOB (IRREG_SEGS * 3)
+#define MAX_BLOB_VERTS (NUM_LAYERS * MAX_CLOUDS * BLOBS_PER_CLOUD * VERTS_PER_BLOB)
+
+static const char *bg_vert_src =
+	"#version 330 core\n"
+	"layout(location = 0) in vec2 a_center;\n"
+	"layout(location = 1) in vec2 a_offset;\n"
+	"layout(location = 2) in vec4 a_color;\n"
+	"layout(location = 3) in vec2 a_drift;\n"
+	"layout(location = 4) in vec2 a_pulse;\n"
+	"uniform mat4 u_projection;\n"
+	"uniform mat4 u_view;\n"
+	"uniform vec2 u_camera;\n"
+	"uniform float u_time;\n"
+	"uniform float u_tile_size;\n"
+	"uniform float u_alpha_mult;\n"
+	"uniform ivec2 u_tile_min;\n"
+	"uniform int u_tile_cols;\n"
+	"out vec4 v_color;\n"
+	"void main() {\n"
+	"    vec2 d = a_drift * u_time;\n"
+	"    d -= u_tile_size * trunc(d / u_tile_size);\n"
+	"    float pulse = 1.0 + 0.08 * sin(u_time * a_pulse.y + a_pulse.x);\n"
+	"    ivec2 tile = u_tile_min + ivec2(gl_InstanceID % u_tile_cols,\n"
+	"                                    gl_InstanceID / u_tile_cols);\n"
+	"    vec2 world = a_center + u_camera + d + a_offset * pulse\n"
+	"               + vec2(tile) * u_tile_size;\n"
+	"    gl_Position = u_projection * u_view * vec4(world, 0.0, 1.0);\n"
+	"    v_color = vec4(a_color.rgb, a_color.a * u_alpha_mult);\n"
+	"}\n";
+
+static const char *bg_frag_src =
+	"#version 330 core\n"
+	"in vec4 v_color;\n"
+	"out vec4 fragColor;\n"
+	"void main() {\n"
+	"    fragColor = v_color;\n"
+	"}\n";
+
+static bool glReady = false;
+static GLuint bg_program;
+static GLint u_projection, u_view, u_camera, u_time;
+static GLint u_tile_size, u_alpha_mult, u_tile_min, u_tile_cols;
+static GLuint blob_vao, blob_vbo;
+static int layerFirstVert[NUM_LAYERS];
+static int layerVertCount[NUM_LAYERS];
+static BlobVertex blobVerts[MAX_BLOB_VERTS];
+static int blobVertCount = 0;
+static bool meshDirty = false;  /* blobVerts rebuilt, VBO not yet updated */
+
 /* Default purple hue palette */
 static const float default_palette[4][3] = {
 	{0.35f, 0.10f, 0.55f},  /* violet */
@@ -80,6 +148,150 @@ void Background_reset_palette(void)
 	memcpy(palette, default_palette, sizeof(palette));
 }
 
+static GLuint compile_shader(GLenum type, const char *source)
+{
+	GLuint shader = glCreateShader(type);
+	glShaderSource(shader, 1, &source, NULL);
+	glCompileShader(shader);
+
+	GLint ok;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+	if (!ok) {
+		char log[512];
+		glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+		fprintf(stderr, "Background shader compile error: %s\n", log);
+		exit(1);
+	}
+	return shader;
+}
+
+static void ensure_gl(void)
+{
+	if (glReady)
+		return;
+
+	GLuint vert = compile_shader(GL_VERTEX_SHADER, bg_vert_src);
+	GLuint frag = compile_shader(GL_FRAGMENT_SHADER, bg_frag_src);
+	bg_program = glCreateProgram();
+	glAttachShader(bg_program, vert);
+	glAttachShader(bg_program, frag);
+	glLinkProgram(bg_program);
+
+	GLint ok;
+	glGetProgramiv(bg_program, GL_LINK_STATUS, &ok);
+	if (!ok) {
+		char log[512];
+		glGetProgramInfoLog(bg_program, sizeof(log), NULL, log);
+		fprintf(stderr, "Background shader link error: %s\n", log);
+		exit(1);
+	}
+	glDeleteShader(vert);
+	glDeleteShader(frag);
+
+	u_projection = glGetUniformLocation(bg_program, "u_projection");
+	u_view = glGetUniformLocation(bg_program, "u_view");
+	u_camera = glGetUniformLocation(bg_program, "u_camera");
+	u_time = glGetUniformLocation(bg_program, "u_time");
+	u_tile_size = glGetUniformLocation(bg_program, "u_tile_size");
+	u_alpha_mult = glGetUniformLocation(bg_program, "u_alpha_mult");
+	u_tile_min = glGetUniformLocation(bg_program, "u_tile_min");
+	u_tile_cols = glGetUniformLocation(bg_program, "u_tile_cols");
+
+	glGenVertexArrays(1, &blob_vao);
+	glGenBuffers(1, &blob_vbo);
+	glBindVertexArray(blob_vao);
+	glBindBuffer(GL_ARRAY_BUFFER, blob_vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(blobVerts), NULL, GL_STATIC_DRAW);
+
+	GLsizei stride = sizeof(BlobVertex);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride,
+		(void *)offsetof(BlobVertex, cx));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride,
+		(void *)offsetof(BlobVertex, ox));
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride,
+		(void *)offsetof(BlobVertex, r));
+	glEnableVertexAttribArray(3);
+	glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, stride,
+		(void *)offsetof(BlobVertex, drift_dx));
+	glEnableVertexAttribArray(4);
+	glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, stride,
+		(void *)offsetof(BlobVertex, pulse_phase));
+	glBindVertexArray(0);
+
+	glReady = true;
+}
+
+static void set_blob_vertex(BlobVertex *v, const Blob *blob, float ox, float oy)
+{
+	v->cx = blob->x;
+	v->cy = blob->y;
+	v->ox = ox;
+	v->oy = oy;
+	v->r = blob->r;
+	v->g = blob->g;
+	v->b = blob->b;
+	v->a = blob->a;
+	v->drift_dx = blob->drift_dx;
+	v->drift_dy = blob->drift_dy;
+	v->pulse_phase = blob->pulse_phase;
+	v->pulse_speed = blob->pulse_speed;
+}
+
+/* Bake every blob's fan into blobVerts (init and recolor only). CPU-side,
+   since zone loads recolor without needing a GL context; the VBO picks it
+   up on the next Background_render. */
+static void build_mesh(void)
+{
+	float step = 2.0f * (float)M_PI / (float)IRREG_SEGS;
+	int n = 0;
+
+	for (int l = 0; l < NUM_LAYERS; l++) {
+		layerFirstVert[l] = n;
+		for (int c = 0; c < layers[l].cloud_count; c++) {
+			for (int b = 0; b < BLOBS_PER_CLOUD; b++) {
+				const Blob *blob = &layers[l].clouds[c].blobs[b];
+				for (int i = 0; i < IRREG_SEGS; i++) {
+					int j = (i + 1) % IRREG_SEGS;
+					float a0 = (float)i * step;
+					float a1 = (float)j * step;
+					float r0 = blob->radius * blob->vert_mult[i];
+					float r1 = blob->radius * blob->vert_mult[j];
+					set_blob_vertex(&blobVerts[n++], blob, 0.0f, 0.0f);
+					set_blob_vertex(&blobVerts[n++], blob, r0 * cosf(a0), r0 * sinf(a0));
+					set_blob_vertex(&blobVerts[n++], blob, r1 * cosf(a1), r1 * sinf(a1));
+				}
+			}
+		}
+		layerVertCount[l] = n - layerFirstVert[l];
+	}
+
+	blobVertCount = n;
+	meshDirty = true;
+}
+
+static void upload_mesh(void)
+{
+	glBindBuffer(GL_ARRAY_BUFFER, blob_vbo);
+	glBufferSubData(GL_ARRAY_BUFFER, 0,
+		(GLsizeiptr)(blobVertCount * sizeof(BlobVertex)), blobVerts);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	meshDirty = false;
+}
+
+void Background_cleanup(void)
+{
+	if (!glReady)
+		return;
+	glDeleteBuffers(1, &blob_vbo);
+	glDeleteVertexArrays(1, &blob_vao);
+	glDeleteProgram(bg_program);
+	glReady = false;
+	meshDirty = blobVertCount > 0;
+}
+
 void Background_recolor(void)
 {
 	for (int l = 0; l < NUM_LAYERS; l++) {
@@ -93,6 +305,7 @@ void Background_recolor(void)
 			}
 		}
 	}
+	build_mesh();
 }
 
 static unsigned int bg_xorshift(unsigned int *state)
@@ -199,6 +412,8 @@ void Background_initialize(void)
 			}
 		}
 	}
+
+	build_mesh();
 }
 
 void Background_update(unsigned int ticks)
@@ -229,32 +444,16 @@ void Background_update(unsigned int ticks)
 	}
 }
 
-static void render_blob(Blob *blob, float wx, float wy, float rad, float alpha)
-{
-	BatchRenderer *batch = Graphics_get_batch();
-	float step = 2.0f * (float)M_PI / (float)IRREG_SEGS;
-
-	for (int i = 0; i < IRREG_SEGS; i++) {
-		int j = (i + 1) % IRREG_SEGS;
-		float a0 = (float)i * step;
-		float a1 = (float)j * step;
-		float r0 = rad * blob->vert_mult[i];
-		float r1 = rad * blob->vert_mult[j];
-
-		Batch_push_triangle_vertices(batch,
-			wx, wy,
-			wx + r0 * cosf(a0), wy + r0 * sinf(a0),
-			wx + r1 * cosf(a1), wy + r1 * sinf(a1),
-			blob->r, blob->g, blob->b, alpha);
-	}
-}
-
 void Background_render(void)
 {
 	View v = View_get_view();
 	Screen screen = Graphics_get_screen();
 	Mat4 proj = Graphics_get_world_projection();
 
+	ensure_gl();
+	if (meshDirty)
+		upload_mesh();
+
 	/* Slow ambient drift — sinusoidal wander (directional slide applied per-layer) */
 	float breath_x = sinf(bg_time * 0.017f) * 400.0f
 		+ sinf(bg_time * 0.031f) * 250.0f;
@@ -267,10 +466,14 @@ void Background_render(void)
 	float bg_scale = default_zoom * powf(ratio, 0.5f);
 	Mat4 s = Mat4_scale(bg_scale, bg_scale, 1.0f);
 
+	glUseProgram(bg_program);
+	glUniformMatrix4fv(u_projection, 1, GL_FALSE, proj.m);
+	glUniform1f(u_time, bg_time);
+	glBindVertexArray(blob_vao);
+
 	for (int l = 0; l < NUM_LAYERS; l++) {
 		Layer *layer = &layers[l];
 		float p = layer->parallax;
-		float am = layer->alpha_mult;
 		float ts = layer->tile_size;
 
 		/* Per-layer drift = shared breathing + layer's own directional slide */
@@ -290,23 +493,6 @@ void Background_render(void)
 		float half_vw = (float)(screen.norm_w / 2.0 / bg_scale);
 		float half_vh = (float)(screen.norm_h / 2.0 / bg_scale);
 
-		/* Push all blobs once at base tile position (no tile offset) */
-		for (int c = 0; c < layer->cloud_count; c++) {
-			for (int b = 0; b < BLOBS_PER_CLOUD; b++) {
-				Blob *blob = &layer->clouds[c].blobs[b];
-				float dx = fmodf(blob->drift_dx * bg_time, ts);
-				float dy = fmodf(blob->drift_dy * bg_time, ts);
-				float wx = blob->x + cam_x * (1.0f - p) + dx;
-				float wy = blob->y + cam_y * (1.0f - p) + dy;
-
-				float pulse = 1.0f + 0.08f * sinf(
-					bg_time * blob->pulse_speed + blob->pulse_phase);
-				float rad = blob->radius * pulse;
-				float alpha = blob->a * am;
-				render_blob(blob, wx, wy, rad, alpha);
-			}
-		}
-
 		/* Compute visible tile range (margin accounts for blob radius + bloom bleed).
 		   Extra half-tile covers 20-pass blur at 1/8 FBO res to prevent tile pop. */
 		float margin = 5000.0f + ts * 0.5f;
@@ -316,23 +502,22 @@ void Background_render(void)
 		int tile_max_x = (int)floorf((eff_cx + half_vw + margin) / ts);
 		int tile_min_y = (int)floorf((eff_cy - half_vh - margin) / ts);
 		int tile_max_y = (int)floorf((eff_cy + half_vh + margin) / ts);
-
-		/* Upload geometry once, redraw per tile with offset view */
-		int first = 1;
-		for (int tx = tile_min_x; tx <= tile_max_x; tx++) {
-			for (int ty = tile_min_y; ty <= tile_max_y; ty++) {
-				Mat4 offset = Mat4_translate(
-					(float)tx * ts, (float)ty * ts, 0.0f);
-				Mat4 tile_view = Mat4_multiply(&base_view, &offset);
-
-				if (first) {
-					Render_flush_keep(&proj, &tile_view);
-					first = 0;
-				} else {
-					Render_redraw(&proj, &tile_view);
-				}
-			}
-		}
-		Render_clear();
+		int cols = tile_max_x - tile_min_x + 1;
+		int rows = tile_max_y - tile_min_y + 1;
+
+		/* One instanced draw covers every visible tile of the layer */
+		glUniformMatrix4fv(u_view, 1, GL_FALSE, base_view.m);
+		glUniform2f(u_camera, cam_x * (1.0f - p), cam_y * (1.0f - p));
+		glUniform1f(u_tile_size, ts);
+		glUniform1f(u_alpha_mult, layer->alpha_mult);
+		glUniform2i(u_tile_min, tile_min_x, tile_min_y);
+		glUniform1i(u_tile_cols, cols);
+		glDrawArraysInstanced(GL_TRIANGLES, layerFirstVert[l],
+			layerVertCount[l], cols * rows);
 	}
+
+	glBindVertexArray(0);
+
+	/* Restore color shader for the batch renderer */
+	glUseProgram(Graphics_get_shaders()->color_shader.program);
 }
@@ -2,6 +2,7 @@
 #define BACKGROUND_H
 
 void Background_initialize(void);
+void Background_cleanup(void);
 void Background_update(unsigned int ticks);
 void Background_render(void);
 void Background_set_palette(const float colors[4][3]);
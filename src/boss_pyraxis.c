@@ -309,7 +309,7 @@ static struct {
 
 	/* Entity registration */
 	PlaceableComponent placeable;
-	Entity *entityRef;
+	EntityHandle entityRef;
 	bool pipelineRegistered;
 	bool initialized;
 } boss;
@@ -1065,7 +1065,7 @@ void BossPyraxis_initialize(Position position)
 	entity.collidable = &collidable;
 	entity.aiUpdatable = &updatable;
 
-	boss.entityRef = Entity_add_entity(entity);
+	boss.entityRef = Entity_create(entity);
 
 	SpatialGrid_add((EntityRef){ENTITY_BOSS_PYRAXIS, 0}, position.x, position.y);
 
@@ -1106,10 +1106,8 @@ void BossPyraxis_cleanup(void)
 {
 	if (!boss.initialized) return;
 
-	if (boss.entityRef) {
-		boss.entityRef->empty = true;
-		boss.entityRef = NULL;
-	}
+	Entity_release(boss.entityRef);
+	boss.entityRef = (EntityHandle){0, 0};
 
 	Audio_unload_sample(&sampleHit);
 	Audio_unload_sample(&sampleDeath);
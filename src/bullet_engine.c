@@ -0,0 +1,65 @@
+#include "bullet_engine.h"
+#include "map.h"
+
+#include <stdio.h>
+
+static BulletEngine engine;
+static int reservedCount = 0;
+
+BulletEngine *BulletEngine_get(void)
+{
+	return &engine;
+}
+
+int BulletEngine_reserve(int capacity)
+{
+	if (capacity <= 0 || reservedCount + capacity > BULLET_ENGINE_CAPACITY) {
+		fprintf(stderr, "BULLET: engine full, cannot reserve %d slots (%d/%d used)\n",
+			capacity, reservedCount, BULLET_ENGINE_CAPACITY);
+		return -1;
+	}
+	int base = reservedCount;
+	reservedCount += capacity;
+	return base;
+}
+
+void BulletEngine_move(int dst, int src)
+{
+	engine.x[dst] = engine.x[src];
+	engine.y[dst] = engine.y[src];
+	engine.prevX[dst] = engine.prevX[src];
+	engine.prevY[dst] = engine.prevY[src];
+	engine.dirX[dst] = engine.dirX[src];
+	engine.dirY[dst] = engine.dirY[src];
+	engine.ticksLived[dst] = engine.ticksLived[src];
+	engine.volley[dst] = engine.volley[src];
+}
+
+void BulletEngine_integrate(int first, int count, double step, unsigned int ticks)
+{
+	/* Branch-free over contiguous arrays so the compiler vectorizes it */
+	double *restrict x = engine.x + first;
+	double *restrict y = engine.y + first;
+	double *restrict px = engine.prevX + first;
+	double *restrict py = engine.prevY + first;
+	const double *restrict dx = engine.dirX + first;
+	const double *restrict dy = engine.dirY + first;
+	int *restrict lived = engine.ticksLived + first;
+
+	for (int i = 0; i < count; i++) {
+		px[i] = x[i];
+		py[i] = y[i];
+		x[i] += dx[i] * step;
+		y[i] += dy[i] * step;
+		lived[i] += (int)ticks;
+	}
+}
+
+int BulletEngine_wall_test(int first, int count,
+	bool *hit, double *hit_x, double *hit_y)
+{
+	return Map_line_test_hit_batch(count,
+		engine.prevX + first, engine.prevY + first,
+		engine.x + first, engine.y + first,
+		hit, hit_x, hit_y);
+}
@@ -0,0 +1,45 @@
+#ifndef BULLET_ENGINE_H
+#define BULLET_ENGINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Structure-of-arrays storage shared by every projectile pool.
+ *
+ * Each SubProjectilePool reserves a contiguous slot range once and keeps its
+ * live bullets packed at the front of that range: spawning appends, death
+ * swaps the last live bullet into the hole. Ownership is implied by the
+ * range, so integration, wall tests and hit checks walk contiguous arrays
+ * with no per-slot active flag.
+ */
+#define BULLET_ENGINE_CAPACITY 32768
+
+typedef struct {
+	double x[BULLET_ENGINE_CAPACITY];
+	double y[BULLET_ENGINE_CAPACITY];
+	double prevX[BULLET_ENGINE_CAPACITY];
+	double prevY[BULLET_ENGINE_CAPACITY];
+	double dirX[BULLET_ENGINE_CAPACITY];    /* heading sin * speed multiplier */
+	double dirY[BULLET_ENGINE_CAPACITY];    /* heading cos * speed multiplier */
+	int ticksLived[BULLET_ENGINE_CAPACITY];
+	uint32_t volley[BULLET_ENGINE_CAPACITY];
+} BulletEngine;
+
+BulletEngine *BulletEngine_get(void);
+
+/* Reserve `capacity` contiguous slots; returns the first slot or -1 if full */
+int BulletEngine_reserve(int capacity);
+
+/* Copy every field of slot src into slot dst (swap-remove helper) */
+void BulletEngine_move(int dst, int src);
+
+/* Advance slots [first, first + count): prev = pos, pos += dir * step */
+void BulletEngine_integrate(int first, int count, double step, unsigned int ticks);
+
+/* Batched wall test for slots [first, first + count); fills hit/hit_x/hit_y
+   per bullet (indexed from 0) and returns the number of hits */
+int BulletEngine_wall_test(int first, int count,
+	bool *hit, double *hit_x, double *hit_y);
+
+#endif
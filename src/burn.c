@@ -24,9 +24,11 @@ static double burnDamageAccum = 0.0;
 
 /* --- Registration system --- */
 
-#define BURN_MAX_REGISTERED   128
+/* Enough for every enemy of a full pool burning at once */
+#define BURN_MAX_REGISTERED   4096
 #define BURN_EMBERS_PER_ENTITY 6
-#define BURN_MAX_INSTANCES    1024
+#define BURN_MAX_KERNELS      8
+#define BURN_MAX_INSTANCES    (BURN_MAX_REGISTERED * (BURN_MAX_KERNELS + BURN_EMBERS_PER_ENTITY))
 
 typedef struct {
 	bool active;
@@ -39,9 +41,10 @@ typedef struct {
 } BurnEmber;
 
 typedef struct {
-	const BurnState *key; /* pointer identity for cross-frame tracking */
+	const BurnState *key; /* owner; a copied or reset state won't match */
 	bool active;
 	bool seenThisFrame;
+	int listIndex;        /* position in activeList */
 	int stacks;
 	Position pos;
 	BurnEmber embers[BURN_EMBERS_PER_ENTITY];
@@ -49,6 +52,14 @@ typedef struct {
 } BurnRegistration;
 
 static BurnRegistration registrations[BURN_MAX_REGISTERED];
+
+/* Active registrations packed for the per-frame walks, plus a stack of
+   free slots; both touch only what is burning */
+static int activeList[BURN_MAX_REGISTERED];
+static int activeCount = 0;
+static int freeRegs[BURN_MAX_REGISTERED];
+static int freeRegCount = 0;
+static bool registryReady = false;
 static ParticleInstanceData burnInstances[BURN_MAX_INSTANCES];
 
 /* --- Core burn logic (works on any BurnState) --- */
@@ -175,39 +186,58 @@ static void ember_color(float t, float *r, float *g, float *b, float *a)
 
 /* --- Registration API --- */
 
+static void reset_registry(void)
+{
+	for (int i = 0; i < BURN_MAX_REGISTERED; i++) {
+		registrations[i].active = false;
+		freeRegs[i] = BURN_MAX_REGISTERED - 1 - i;
+	}
+	freeRegCount = BURN_MAX_REGISTERED;
+	activeCount = 0;
+	registryReady = true;
+}
+
+static void release_registration(int i)
+{
+	BurnRegistration *reg = &registrations[i];
+	int last = activeList[--activeCount];
+	activeList[reg->listIndex] = last;
+	registrations[last].listIndex = reg->listIndex;
+	reg->active = false;
+	freeRegs[freeRegCount++] = i;
+}
+
 void Burn_clear_registrations(void)
 {
-	for (int i = 0; i < BURN_MAX_REGISTERED; i++)
-		registrations[i].seenThisFrame = false;
+	for (int k = 0; k < activeCount; k++)
+		registrations[activeList[k]].seenThisFrame = false;
 }
 
-void Burn_register(const BurnState *state, Position pos)
+void Burn_register(BurnState *state, Position pos)
 {
 	if (!state || state->stacks <= 0)
 		return;
-
-	/* Find existing registration by pointer identity */
-	for (int i = 0; i < BURN_MAX_REGISTERED; i++) {
-		if (registrations[i].active && registrations[i].key == state) {
-			registrations[i].seenThisFrame = true;
-			registrations[i].stacks = state->stacks;
-			registrations[i].pos = pos;
+	if (!registryReady)
+		reset_registry();
+
+	/* Same registration as last frame, unless the slot moved on */
+	int i = state->visual - 1;
+	if (i < 0 || i >= BURN_MAX_REGISTERED || !registrations[i].active ||
+			registrations[i].key != state) {
+		if (freeRegCount == 0)
 			return;
-		}
+		i = freeRegs[--freeRegCount];
+		memset(&registrations[i], 0, sizeof(BurnRegistration));
+		registrations[i].key = state;
+		registrations[i].active = true;
+		registrations[i].listIndex = activeCount;
+		activeList[activeCount++] = i;
+		state->visual = i + 1;
 	}
 
-	/* Allocate new slot */
-	for (int i = 0; i < BURN_MAX_REGISTERED; i++) {
-		if (!registrations[i].active) {
-			memset(&registrations[i], 0, sizeof(BurnRegistration));
-			registrations[i].key = state;
-			registrations[i].active = true;
-			registrations[i].seenThisFrame = true;
-			registrations[i].stacks = state->stacks;
-			registrations[i].pos = pos;
-			return;
-		}
-	}
+	registrations[i].seenThisFrame = true;
+	registrations[i].stacks = state->stacks;
+	registrations[i].pos = pos;
 }
 
 /* --- Ember simulation --- */
@@ -229,16 +259,16 @@ void Burn_update_embers(unsigned int ticks)
 {
 	float dt = (float)ticks / 1000.0f;
 
-	for (int i = 0; i < BURN_MAX_REGISTERED; i++) {
-		BurnRegistration *reg = &registrations[i];
+	for (int k = 0; k < activeCount; k++) {
+		BurnRegistration *reg = &registrations[activeList[k]];
 
-		/* Deactivate entries not seen this frame */
-		if (reg->active && !reg->seenThisFrame) {
-			reg->active = false;
+		/* Deactivate entries not seen this frame; the last entry moves
+		   into this position, so look at it again */
+		if (!reg->seenThisFrame) {
+			release_registration(activeList[k]);
+			k--;
 			continue;
 		}
-		if (!reg->active)
-			continue;
 
 		/* Update existing embers */
 		for (int e = 0; e < BURN_EMBERS_PER_ENTITY; e++) {
@@ -287,9 +317,8 @@ static int fill_flame_instances(ParticleInstanceData *out, float colorBoost, flo
 	int count = 0;
 	unsigned int ticks = SDL_GetTicks();
 
-	for (int i = 0; i < BURN_MAX_REGISTERED; i++) {
-		BurnRegistration *reg = &registrations[i];
-		if (!reg->active) continue;
+	for (int k = 0; k < activeCount; k++) {
+		BurnRegistration *reg = &registrations[activeList[k]];
 
 		int stacks = reg->stacks;
 		float px = (float)reg->pos.x;
@@ -299,7 +328,7 @@ static int fill_flame_instances(ParticleInstanceData *out, float colorBoost, flo
 		switch (stacks) {
 		case 1:  kernel_count = 3; break;
 		case 2:  kernel_count = 5; break;
-		default: kernel_count = 8; break;
+		default: kernel_count = BURN_MAX_KERNELS; break;
 		}
 
 		float jitter_range = 4.0f + stacks * 1.5f;
@@ -343,9 +372,8 @@ static int fill_ember_instances(ParticleInstanceData *out, float colorBoost, flo
 {
 	int count = 0;
 
-	for (int i = 0; i < BURN_MAX_REGISTERED; i++) {
-		BurnRegistration *reg = &registrations[i];
-		if (!reg->active) continue;
+	for (int k = 0; k < activeCount; k++) {
+		BurnRegistration *reg = &registrations[activeList[k]];
 
 		for (int e = 0; e < BURN_EMBERS_PER_ENTITY && count < BURN_MAX_INSTANCES; e++) {
 			BurnEmber *em = &reg->embers[e];
@@ -402,9 +430,8 @@ void Burn_render_bloom_source(void)
 
 void Burn_render_light_source(void)
 {
-	for (int i = 0; i < BURN_MAX_REGISTERED; i++) {
-		BurnRegistration *reg = &registrations[i];
-		if (!reg->active) continue;
+	for (int k = 0; k < activeCount; k++) {
+		BurnRegistration *reg = &registrations[activeList[k]];
 
 		float radius = 120.0f + reg->stacks * 40.0f;
 		float alpha = 0.3f + reg->stacks * 0.15f;
@@ -461,7 +488,7 @@ void Burn_update_player(unsigned int ticks)
 			burnPulseTimer = BURN_PULSE_INTERVAL_MS;
 
 			if (sndBurnTick)
-				Mix_PlayChannel(-1, sndBurnTick, 0);
+				Audio_play_sample(&sndBurnTick);
 		}
 	} else {
 		burnPulseTimer = 0;
@@ -13,6 +13,7 @@ typedef struct {
 	int stacks;
 	int duration_ms[BURN_MAX_STACKS]; /* remaining ms per stack */
 	int immune_ms;  /* when > 0, Burn_apply is no-op */
+	int visual;     /* burn renderer registration + 1, 0 = none (owned by burn.c) */
 } BurnState;
 
 /* Apply a burn stack. If at max stacks, refreshes the shortest remaining. */
@@ -50,8 +51,10 @@ bool Burn_player_is_burning(void);
 void Burn_grant_immunity_player(int duration_ms);
 bool Burn_player_is_immune(void);
 
-/* Registration system — centralized batch rendering */
-void Burn_register(const BurnState *state, Position pos);
+/* Registration system — centralized batch rendering. A burning state
+   registers every frame it should be drawn; the registration it gets is
+   remembered in state->visual so the next frame finds it directly. */
+void Burn_register(BurnState *state, Position pos);
 void Burn_render_all(void);
 void Burn_render_bloom_source(void);
 void Burn_render_light_source(void);
@@ -0,0 +1,24 @@
+#ifndef CELL_HASH_H
+#define CELL_HASH_H
+
+#include <math.h>
+
+/*
+ * Grid cell hashing shared by the small fixed-table spatial indices
+ * (hazard grid, aura map). World positions map to integer cells, and
+ * cells hash into a power-of-two bucket table.
+ */
+
+static inline int CellHash_coord(double v, double cellSize)
+{
+	return (int)floor(v / cellSize);
+}
+
+/* buckets must be a power of two */
+static inline int CellHash_bucket(int cx, int cy, int buckets)
+{
+	unsigned int h = (unsigned int)cx * 73856093u ^ (unsigned int)cy * 19349663u;
+	return (int)(h & (unsigned int)(buckets - 1));
+}
+
+#endif
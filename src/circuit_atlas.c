@@ -2,6 +2,10 @@
 
 #include <math.h>
 #include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <sys/stat.h>
 #include <OpenGL/gl3.h>
 
 #include "map.h"
@@ -19,6 +23,19 @@
 #define ATLAS_WIDTH  (TILE_SIZE * ATLAS_COLS)   /* 2560 */
 #define ATLAS_HEIGHT (TILE_SIZE * ATLAS_ROWS)   /* 2048 */
 
+/* Generator seeds per tile (tile index as seed source) */
+#define TILE_SEED_X(i) ((i) + 1)
+#define TILE_SEED_Y(i) ((i) * 7 + 3)
+
+/* Baked atlas cache: 20-byte header, then every mip level's GL_RED bytes
+   from level 0 down. The key hashes everything that shapes the pixels, so
+   a stale cache is simply rebaked. */
+#define ATLAS_CACHE_DIR "./cache"
+#define ATLAS_CACHE_PATH "./cache/circuit_atlas.bin"
+#define ATLAS_CACHE_MAGIC "HCAT"
+#define ATLAS_CACHE_VERSION 1
+#define ATLAS_CACHE_HEADER_SIZE 20
+
 /* Connectivity classes:
    0 = island (0-edge)      4 base patterns
    1 = 1-edge (N)           4 base patterns
@@ -142,18 +159,173 @@ static void push_tri(float x0, float y0, float x1, float y1,
 	push_vertex(x2, y2, r, g, b, a, ou2, ov2);
 }
 
+/* --- Atlas disk cache --- */
+
+static void put_u16(unsigned char *p, unsigned int v)
+{
+	p[0] = v & 0xFF;
+	p[1] = (v >> 8) & 0xFF;
+}
+
+static void put_u32(unsigned char *p, uint32_t v)
+{
+	put_u16(p, v & 0xFFFF);
+	put_u16(p + 2, v >> 16);
+}
+
+static unsigned int get_u16(const unsigned char *p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+static uint32_t get_u32(const unsigned char *p)
+{
+	return get_u16(p) | ((uint32_t)get_u16(p + 2) << 16);
+}
+
+static int mip_count(void)
+{
+	int n = 1;
+	while ((ATLAS_WIDTH >> n) > 0 || (ATLAS_HEIGHT >> n) > 0)
+		n++;
+	return n;
+}
+
+static int mip_dim(int size, int level)
+{
+	int d = size >> level;
+	return d > 0 ? d : 1;
+}
+
+static size_t mip_chain_bytes(void)
+{
+	size_t total = 0;
+	for (int l = 0; l < mip_count(); l++)
+		total += (size_t)mip_dim(ATLAS_WIDTH, l) * (size_t)mip_dim(ATLAS_HEIGHT, l);
+	return total;
+}
+
+static uint32_t hash_ints(uint32_t h, const int *v, int n)
+{
+	/* FNV-1a */
+	for (int i = 0; i < n; i++) {
+		for (int b = 0; b < 4; b++) {
+			h ^= ((uint32_t)v[i] >> (b * 8)) & 0xFFu;
+			h *= 16777619u;
+		}
+	}
+	return h;
+}
+
+static uint32_t cache_key(void)
+{
+	int layout[] = {MAP_CIRCUIT_GENERATOR_VERSION, TILE_SIZE, ATLAS_COLS,
+		ATLAS_ROWS, TILE_COUNT, (int)MAP_CELL_SIZE};
+	uint32_t h = hash_ints(2166136261u, layout, 6);
+	for (int i = 0; i < TILE_COUNT; i++) {
+		int tile[] = {TILE_SEED_X(i), TILE_SEED_Y(i),
+			tile_adj[i].adjN, tile_adj[i].adjE,
+			tile_adj[i].adjS, tile_adj[i].adjW};
+		h = hash_ints(h, tile, 6);
+	}
+	return h;
+}
+
+/* Upload a cached mip chain into the bound atlas texture */
+static bool load_cached_atlas(void)
+{
+	FILE *f = fopen(ATLAS_CACHE_PATH, "rb");
+	if (!f)
+		return false;
+
+	size_t size = mip_chain_bytes();
+	unsigned char header[ATLAS_CACHE_HEADER_SIZE];
+	unsigned char *pixels = NULL;
+	bool ok = false;
+	if (fread(header, 1, sizeof(header), f) == sizeof(header) &&
+		memcmp(header, ATLAS_CACHE_MAGIC, 4) == 0 &&
+		get_u16(header + 4) == ATLAS_CACHE_VERSION &&
+		get_u16(header + 6) == (unsigned int)mip_count() &&
+		get_u16(header + 8) == ATLAS_WIDTH &&
+		get_u16(header + 10) == ATLAS_HEIGHT &&
+		get_u32(header + 12) == cache_key() &&
+		get_u32(header + 16) == (uint32_t)size) {
+		pixels = malloc(size);
+		ok = pixels && fread(pixels, 1, size, f) == size;
+	}
+	fclose(f);
+
+	if (!ok) {
+		printf("CircuitAtlas: stale or unreadable cache, rebaking\n");
+		free(pixels);
+		return false;
+	}
+
+	/* Small mips are not 4-byte aligned rows */
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	const unsigned char *p = pixels;
+	int levels = mip_count();
+	for (int l = 0; l < levels; l++) {
+		int w = mip_dim(ATLAS_WIDTH, l), h = mip_dim(ATLAS_HEIGHT, l);
+		glTexImage2D(GL_TEXTURE_2D, l, GL_RED, w, h, 0,
+			GL_RED, GL_UNSIGNED_BYTE, p);
+		p += (size_t)w * (size_t)h;
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+	free(pixels);
+	return true;
+}
+
+/* Read the freshly baked mip chain back and write it out */
+static void save_cached_atlas(void)
+{
+	size_t size = mip_chain_bytes();
+	unsigned char *pixels = malloc(size);
+	if (!pixels)
+		return;
+
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	unsigned char *p = pixels;
+	for (int l = 0; l < mip_count(); l++) {
+		glGetTexImage(GL_TEXTURE_2D, l, GL_RED, GL_UNSIGNED_BYTE, p);
+		p += (size_t)mip_dim(ATLAS_WIDTH, l) * (size_t)mip_dim(ATLAS_HEIGHT, l);
+	}
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+	unsigned char header[ATLAS_CACHE_HEADER_SIZE];
+	memcpy(header, ATLAS_CACHE_MAGIC, 4);
+	put_u16(header + 4, ATLAS_CACHE_VERSION);
+	put_u16(header + 6, (unsigned int)mip_count());
+	put_u16(header + 8, ATLAS_WIDTH);
+	put_u16(header + 10, ATLAS_HEIGHT);
+	put_u32(header + 12, cache_key());
+	put_u32(header + 16, (uint32_t)size);
+
+#ifdef _WIN32
+	_mkdir(ATLAS_CACHE_DIR);
+#else
+	mkdir(ATLAS_CACHE_DIR, 0755);
+#endif
+	FILE *f = fopen(ATLAS_CACHE_PATH, "wb");
+	if (!f) {
+		printf("CircuitAtlas: failed to write %s\n", ATLAS_CACHE_PATH);
+		free(pixels);
+		return;
+	}
+	fwrite(header, sizeof(header), 1, f);
+	fwrite(pixels, 1, size, f);
+	fclose(f);
+	free(pixels);
+}
+
 /* --- Atlas generation --- */
 
-void CircuitAtlas_initialize(void)
+static void bake_atlas(void)
 {
-	/* Create atlas texture */
-	glGenTextures(1, &s_atlas_tex);
-	glBindTexture(GL_TEXTURE_2D, s_atlas_tex);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RED,
 		ATLAS_WIDTH, ATLAS_HEIGHT, 0,
 		GL_RED, GL_UNSIGNED_BYTE, NULL);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
 	/* Create temporary FBO */
 	GLuint fbo;
@@ -178,9 +350,8 @@ void CircuitAtlas_initialize(void)
 		glViewport(col * TILE_SIZE, row * TILE_SIZE,
 			TILE_SIZE, TILE_SIZE);
 
-		/* Use tile index as seed source (cellX) */
 		Map_render_circuit_pattern_for_atlas(
-			i + 1, i * 7 + 3,
+			TILE_SEED_X(i), TILE_SEED_Y(i),
 			0.0f, 0.0f,
 			tile_adj[i].adjN, tile_adj[i].adjE,
 			tile_adj[i].adjS, tile_adj[i].adjW);
@@ -202,6 +373,22 @@ void CircuitAtlas_initialize(void)
 	Graphics_get_drawable_size(&draw_w, &draw_h);
 	glViewport(0, 0, draw_w, draw_h);
 
+	glBindTexture(GL_TEXTURE_2D, s_atlas_tex);
+	save_cached_atlas();
+}
+
+void CircuitAtlas_initialize(void)
+{
+	/* Create atlas texture */
+	glGenTextures(1, &s_atlas_tex);
+	glBindTexture(GL_TEXTURE_2D, s_atlas_tex);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	/* Later launches upload the cached mip chain and skip the generator */
+	if (!load_cached_atlas())
+		bake_atlas();
+
 	/* Create VAO/VBO for circuit quad rendering */
 	glGenVertexArrays(1, &s_vao);
 	glGenBuffers(1, &s_vbo);
@@ -284,17 +471,12 @@ void CircuitAtlas_render(void)
 			float bx = ax + (float)MAP_CELL_SIZE;
 			float by = ay + (float)MAP_CELL_SIZE;
 
-			/* Neighbor lookup */
-			const MapCell *nPtr = Map_get_cell(x, y + 1);
-			const MapCell *ePtr = Map_get_cell(x + 1, y);
-			const MapCell *sPtr = Map_get_cell(x, y - 1);
-			const MapCell *wPtr = Map_get_cell(x - 1, y);
-
 			/* Connectivity mask: NESW bits */
-			int adjN = !nPtr->empty;
-			int adjE = !ePtr->empty;
-			int adjS = !sPtr->empty;
-			int adjW = !wPtr->empty;
+			uint8_t solid = Map_get_solid_neighbours(x, y);
+			int adjN = (solid & MAP_ADJ_N) != 0;
+			int adjE = (solid & MAP_ADJ_E) != 0;
+			int adjS = (solid & MAP_ADJ_S) != 0;
+			int adjW = (solid & MAP_ADJ_W) != 0;
 			int conn = (adjN << 3) | (adjE << 2) | (adjS << 1) | adjW;
 
 			ConnLookup cl = conn_table[conn];
@@ -332,8 +514,8 @@ void CircuitAtlas_render(void)
 
 			/* Chamfer (same logic as render_cell in map.c) */
 			float chamf = MAP_CELL_SIZE * 0.17f;
-			int chamfer_ne = nPtr->empty && ePtr->empty;
-			int chamfer_sw = sPtr->empty && wPtr->empty;
+			int chamfer_ne = !adjN && !adjE;
+			int chamfer_sw = !adjS && !adjW;
 
 			if (chamfer_ne || chamfer_sw) {
 				/* Build chamfered polygon (same as render_cell) */
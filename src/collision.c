@@ -1,5 +1,7 @@
 #include "collision.h"
 
+#include <math.h>
+
 bool Collision_aabb_test(const Rectangle rect1,
 						 const Rectangle rect2)
 {
@@ -70,6 +72,58 @@ bool Collision_line_aabb_test(double x0, double y0, double x1, double y1,
 	return true;
 }
 
+bool Collision_sweep_aabb(const Rectangle moving, double dx, double dy,
+						  const Rectangle rect, double *t_out,
+						  double *nx_out, double *ny_out)
+{
+	/* Sweep the centre of `moving` against rect grown by its half extents */
+	double halfW = fabs(moving.bX - moving.aX) * 0.5;
+	double halfH = fabs(moving.aY - moving.bY) * 0.5;
+	double cx = (moving.aX + moving.bX) * 0.5;
+	double cy = (moving.aY + moving.bY) * 0.5;
+
+	double minX = (rect.aX < rect.bX ? rect.aX : rect.bX) - halfW;
+	double maxX = (rect.aX > rect.bX ? rect.aX : rect.bX) + halfW;
+	double minY = (rect.aY < rect.bY ? rect.aY : rect.bY) - halfH;
+	double maxY = (rect.aY > rect.bY ? rect.aY : rect.bY) + halfH;
+
+	double tmin = 0.0;
+	double tmax = 1.0;
+	double nx = 0.0, ny = 0.0;
+
+	if (dx != 0.0) {
+		double t1 = (minX - cx) / dx;
+		double t2 = (maxX - cx) / dx;
+		double n = -1.0;
+		if (t1 > t2) { double tmp = t1; t1 = t2; t2 = tmp; n = 1.0; }
+		if (t1 >= tmin) { tmin = t1; nx = n; ny = 0.0; }
+		if (t2 < tmax) tmax = t2;
+		if (tmin >= tmax) return false;
+	} else {
+		if (cx <= minX || cx >= maxX) return false;
+	}
+
+	if (dy != 0.0) {
+		double t1 = (minY - cy) / dy;
+		double t2 = (maxY - cy) / dy;
+		double n = -1.0;
+		if (t1 > t2) { double tmp = t1; t1 = t2; t2 = tmp; n = 1.0; }
+		if (t1 >= tmin) { tmin = t1; nx = 0.0; ny = n; }
+		if (t2 < tmax) tmax = t2;
+		if (tmin >= tmax) return false;
+	} else {
+		if (cy <= minY || cy >= maxY) return false;
+	}
+
+	if (t_out)
+		*t_out = tmin;
+	if (nx_out)
+		*nx_out = nx;
+	if (ny_out)
+		*ny_out = ny;
+	return true;
+}
+
 Rectangle Collision_transform_bounding_box(const Position position, const Rectangle boundingBox)
 {
 	Rectangle transformedBoundingBox = {
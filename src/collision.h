@@ -27,4 +27,11 @@ Rectangle Collision_transform_bounding_box(const Position position, const Rectan
 bool Collision_line_aabb_test(double x0, double y0, double x1, double y1,
 							 const Rectangle rect, double *t_out);
 
+/* Swept AABB: `moving` travels by (dx, dy) against a static `rect`. Returns
+   the time of impact in [0, 1] and the contact normal (pointing out of
+   rect). If the boxes already overlap, t is 0 and the normal is zero. */
+bool Collision_sweep_aabb(const Rectangle moving, double dx, double dy,
+						  const Rectangle rect, double *t_out,
+						  double *nx_out, double *ny_out);
+
 #endif
@@ -21,8 +21,10 @@
 #include "audio.h"
 #include "map.h"
 #include "spatial_grid.h"
+#include "timer_wheel.h"
 #include "global_render.h"
 #include "global_update.h"
+#include "aura_map.h"
 
 #include <math.h>
 #include <stdlib.h>
@@ -30,6 +32,9 @@
 #include <SDL2/SDL_mixer.h>
 
 #define CORRUPTOR_COUNT 4096
+#if CORRUPTOR_COUNT > AURA_MAP_CAPACITY
+#error "aura map slots are indexed by corruptor index"
+#endif
 #define CORRUPTOR_HP 70.0
 #define NORMAL_SPEED 200.0
 #define SPRINT_SPEED 600.0
@@ -121,7 +126,6 @@ typedef struct {
 
 	/* Death/respawn */
 	int deathTimer;
-	int respawnTimer;
 
 	/* Feedback */
 	EnemyFeedback fb;
@@ -162,13 +166,17 @@ static const ColorFloat colorAggro = {1.0f, 0.95f, 0.3f, 1.0f};
 /* State arrays */
 static CorruptorState corruptors[CORRUPTOR_COUNT];
 static PlaceableComponent placeables[CORRUPTOR_COUNT];
-static Entity *entityRefs[CORRUPTOR_COUNT];
+static EntityHandle entityRefs[CORRUPTOR_COUNT];
+static TimerHandle respawnEvents[CORRUPTOR_COUNT];
 static int highestUsedIndex = 0;
 static int corruptorTypeId = -1;
 
 /* Self-exclusion for find_wounded/find_aggro */
 static int currentUpdaterIdx = -1;
 
+/* Resist/temper auras, rebuilt each frame (see aura_map.h) */
+static AuraMap resistAuras;
+
 /* Sparks */
 #define SPARK_DURATION 80
 #define SPARK_SIZE 12.0
@@ -203,6 +211,79 @@ static void pick_wander_target(CorruptorState *c)
 		&c->wanderTarget, &c->wanderTimer);
 }
 
+/* Spark decay runs once per frame, not from an entity that may be dormant
+   or waiting to respawn outside the AI walk */
+static void decay_sparks(const unsigned int ticks)
+{
+	for (int si = 0; si < SPARK_POOL_SIZE; si++) {
+		if (sparks[si].active) {
+			sparks[si].ticksLeft -= ticks;
+			if (sparks[si].ticksLeft <= 0)
+				sparks[si].active = false;
+		}
+	}
+}
+
+static void respawn(int idx)
+{
+	CorruptorState *c = &corruptors[idx];
+	PlaceableComponent *pl = &placeables[idx];
+	bool dormant = !SpatialGrid_is_active(pl->position.x, pl->position.y);
+
+	c->alive = true;
+	c->hp = CORRUPTOR_HP;
+	c->aiState = CORRUPTOR_IDLE;
+	c->killedByPlayer = false;
+	Burn_reset(&c->burn);
+	if (c->theme == THEME_FIRE) {
+		SubScorch_init(&c->scorchCore);
+		SubHeatwave_init(&c->heatwaveCore);
+		SubTemper_init(&c->temperCore);
+	} else {
+		SubSprint_init(&c->sprintCore);
+		SubEmp_init(&c->empCore);
+		SubResist_init(&c->resistCore);
+	}
+	c->hasResistTarget = false;
+	EnemyFeedback_reset(&c->fb);
+	Position oldPos = pl->position;
+	pl->position = c->spawnPoint;
+	pick_wander_target(c);
+	/* NO respawn sound while dormant */
+	if (!dormant)
+		Audio_play_sample_at(&sampleRespawn, pl->position);
+	SpatialGrid_update((EntityRef){ENTITY_CORRUPTOR, idx},
+		oldPos.x, oldPos.y, pl->position.x, pl->position.y);
+	Entity_set_ai_suspended(entityRefs[idx], false);
+}
+
+/* The dead leave the AI walk until their respawn event fires; if the
+   wheel is full they stay in it and retry from the DEAD state */
+static void schedule_respawn(int idx)
+{
+	respawnEvents[idx] = TimerWheel_schedule(RESPAWN_MS, respawn, idx);
+	if (TimerWheel_is_pending(respawnEvents[idx]))
+		Entity_set_ai_suspended(entityRefs[idx], true);
+}
+
+static bool has_aura(CorruptorState *c)
+{
+	if (!c->alive)
+		return false;
+	return (c->theme == THEME_FIRE) ?
+		SubTemper_is_active(&c->temperCore) : c->resistCore.active;
+}
+
+static void rebuild_auras(const unsigned int ticks)
+{
+	(void)ticks;
+	AuraMap_clear(&resistAuras);
+	for (int i = 0; i < highestUsedIndex; i++) {
+		if (has_aura(&corruptors[i]))
+			AuraMap_insert(&resistAuras, i, placeables[i].position);
+	}
+}
+
 static bool can_engage_player(CorruptorState *c, Position myPos)
 {
 	if (Ship_is_destroyed() || Sub_Stealth_is_stealthed())
@@ -357,7 +438,6 @@ void Corruptor_initialize(Position position, ZoneTheme theme)
 	c->hasResistTarget = false;
 	c->resistBeamTarget = position;
 	c->deathTimer = 0;
-	c->respawnTimer = 0;
 	EnemyFeedback_init(&c->fb);
 	pick_wander_target(c);
 
@@ -371,7 +451,7 @@ void Corruptor_initialize(Position position, ZoneTheme theme)
 	entity.collidable = &collidable;
 	entity.aiUpdatable = &updatable;
 
-	entityRefs[idx] = Entity_add_entity(entity);
+	entityRefs[idx] = Entity_create(entity);
 
 	highestUsedIndex++;
 
@@ -398,6 +478,9 @@ void Corruptor_initialize(Position position, ZoneTheme theme)
 		GlobalRender_register(RENDER_PASS_LIGHT_SOURCE, Corruptor_render_footprint_light_source);
 		GlobalUpdate_register_post_collision(Corruptor_update_footprints);
 		GlobalUpdate_register_post_collision(corruptor_footprint_burn_wrapper);
+		GlobalUpdate_register_pre_collision(decay_sparks);
+		GlobalUpdate_register_pre_collision(rebuild_auras);
+		AuraMap_init(&resistAuras, RESIST_RANGE);
 		pipelineRegistered = true;
 	}
 
@@ -411,13 +494,13 @@ void Corruptor_initialize(Position position, ZoneTheme theme)
 void Corruptor_cleanup(void)
 {
 	for (int i = 0; i < highestUsedIndex; i++) {
-		if (entityRefs[i]) {
-			entityRefs[i]->empty = true;
-			entityRefs[i] = NULL;
-		}
+		TimerWheel_cancel(respawnEvents[i]);
+		Entity_release(entityRefs[i]);
+		entityRefs[i] = (EntityHandle){0, 0};
 	}
 	highestUsedIndex = 0;
 	corruptorTypeId = -1;
+	AuraMap_clear(&resistAuras);
 	for (int i = 0; i < SPARK_POOL_SIZE; i++)
 		sparks[i].active = false;
 
@@ -468,46 +551,10 @@ void Corruptor_update(void *state, const PlaceableComponent *placeable, unsigned
 	PlaceableComponent *pl = &placeables[idx];
 	double dt = ticks / 1000.0;
 
-	/* Spark decay — idx 0 only */
-	if (idx == 0) {
-		for (int si = 0; si < SPARK_POOL_SIZE; si++) {
-			if (sparks[si].active) {
-				sparks[si].ticksLeft -= ticks;
-				if (sparks[si].ticksLeft <= 0)
-					sparks[si].active = false;
-			}
-		}
-	}
-
-	/* Dormancy check */
+	/* Dormancy check — nothing to do while dormant */
 	if (!SpatialGrid_is_active(pl->position.x, pl->position.y)) {
-		if (c->aiState == CORRUPTOR_DEAD) {
-			c->respawnTimer += ticks;
-			if (c->respawnTimer >= RESPAWN_MS) {
-				c->alive = true;
-				c->hp = CORRUPTOR_HP;
-				c->aiState = CORRUPTOR_IDLE;
-				c->killedByPlayer = false;
-				Burn_reset(&c->burn);
-				if (c->theme == THEME_FIRE) {
-					SubScorch_init(&c->scorchCore);
-					SubHeatwave_init(&c->heatwaveCore);
-					SubTemper_init(&c->temperCore);
-				} else {
-					SubSprint_init(&c->sprintCore);
-					SubEmp_init(&c->empCore);
-					SubResist_init(&c->resistCore);
-				}
-				c->hasResistTarget = false;
-				EnemyFeedback_reset(&c->fb);
-				Position oldPos = pl->position;
-				pl->position = c->spawnPoint;
-				pick_wander_target(c);
-				SpatialGrid_update((EntityRef){ENTITY_CORRUPTOR, idx},
-					oldPos.x, oldPos.y,
-					c->spawnPoint.x, c->spawnPoint.y);
-			}
-		}
+		if (c->aiState == CORRUPTOR_DEAD && !TimerWheel_is_pending(respawnEvents[idx]))
+			schedule_respawn(idx);
 		return;
 	}
 
@@ -793,7 +840,7 @@ void Corruptor_update(void *state, const PlaceableComponent *placeable, unsigned
 		c->deathTimer += ticks;
 		if (c->deathTimer >= DEATH_FLASH_MS) {
 			c->aiState = CORRUPTOR_DEAD;
-			c->respawnTimer = 0;
+			schedule_respawn(idx);
 
 			if (c->killedByPlayer) {
 				int count;
@@ -805,28 +852,9 @@ void Corruptor_update(void *state, const PlaceableComponent *placeable, unsigned
 		break;
 
 	case CORRUPTOR_DEAD:
-		c->respawnTimer += ticks;
-		if (c->respawnTimer >= RESPAWN_MS) {
-			c->alive = true;
-			c->hp = CORRUPTOR_HP;
-			c->aiState = CORRUPTOR_IDLE;
-			c->killedByPlayer = false;
-			Burn_reset(&c->burn);
-			if (c->theme == THEME_FIRE) {
-				SubScorch_init(&c->scorchCore);
-				SubHeatwave_init(&c->heatwaveCore);
-				SubTemper_init(&c->temperCore);
-			} else {
-				SubSprint_init(&c->sprintCore);
-				SubEmp_init(&c->empCore);
-				SubResist_init(&c->resistCore);
-			}
-			c->hasResistTarget = false;
-			EnemyFeedback_reset(&c->fb);
-			pl->position = c->spawnPoint;
-			pick_wander_target(c);
-			Audio_play_sample_at(&sampleRespawn, c->spawnPoint);
-		}
+		/* Respawn is a timer event; only reached if scheduling failed */
+		if (!TimerWheel_is_pending(respawnEvents[idx]))
+			schedule_respawn(idx);
 		break;
 	}
 
@@ -837,6 +865,10 @@ void Corruptor_update(void *state, const PlaceableComponent *placeable, unsigned
 	/* Update spatial grid */
 	SpatialGrid_update((EntityRef){ENTITY_CORRUPTOR, idx},
 		oldPos.x, oldPos.y, pl->position.x, pl->position.y);
+
+	/* Aura may have moved or switched on this update — index where it is now */
+	if (has_aura(c))
+		AuraMap_insert(&resistAuras, idx, pl->position);
 }
 
 static void render_circle(Position pos, float radius, float thickness,
@@ -1044,7 +1076,8 @@ void Corruptor_reset_all(void)
 		}
 		c->hasResistTarget = false;
 		c->deathTimer = 0;
-		c->respawnTimer = 0;
+		TimerWheel_cancel(respawnEvents[i]);
+		Entity_set_ai_suspended(entityRefs[i], false);
 		EnemyFeedback_reset(&c->fb);
 		placeables[i].position = c->spawnPoint;
 		c->prevPosition = c->spawnPoint;
@@ -1057,21 +1090,18 @@ void Corruptor_reset_all(void)
 		SubScorch_deactivate_all_footprints();
 }
 
+static bool resist_match(int owner, Position pos, void *context)
+{
+	(void)context;
+	if (!has_aura(&corruptors[owner]))
+		return false;
+	return Enemy_distance_between(placeables[owner].position, pos) < RESIST_RANGE;
+}
+
 bool Corruptor_is_resist_buffing(Position pos)
 {
-	for (int i = 0; i < highestUsedIndex; i++) {
-		CorruptorState *c = &corruptors[i];
-		if (!c->alive)
-			continue;
-		bool hasAura = (c->theme == THEME_FIRE) ?
-			SubTemper_is_active(&c->temperCore) : c->resistCore.active;
-		if (!hasAura)
-			continue;
-		double dist = Enemy_distance_between(placeables[i].position, pos);
-		if (dist < RESIST_RANGE)
-			return true;
-	}
-	return false;
+	return AuraMap_find(&resistAuras, pos, RESIST_RANGE + AURA_SLACK,
+		resist_match, NULL) >= 0;
 }
 
 bool Corruptor_find_wounded(Position from, double range, double hp_threshold, Position *out_pos, int *out_index)
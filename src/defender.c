@@ -19,14 +19,19 @@
 #include "audio.h"
 #include "map.h"
 #include "spatial_grid.h"
+#include "timer_wheel.h"
 #include "global_render.h"
 #include "global_update.h"
+#include "aura_map.h"
 
 #include <math.h>
 #include <stdlib.h>
 #include <SDL2/SDL_mixer.h>
 
 #define DEFENDER_COUNT 4096
+#if DEFENDER_COUNT > AURA_MAP_CAPACITY
+#error "aura map slots are indexed by defender index"
+#endif
 #define DEFENDER_HP 80.0
 #define NORMAL_SPEED 250.0
 #define FLEE_SPEED 400.0
@@ -141,7 +146,6 @@ typedef struct {
 
 	/* Death/respawn */
 	int deathTimer;
-	int respawnTimer;
 
 	/* Feedback */
 	EnemyFeedback fb;
@@ -174,13 +178,18 @@ static const ColorFloat colorAggro  = {0.5f, 0.8f, 1.0f, 1.0f};
 /* State arrays */
 static DefenderState defenders[DEFENDER_COUNT];
 static PlaceableComponent placeables[DEFENDER_COUNT];
-static Entity *entityRefs[DEFENDER_COUNT];
+static EntityHandle entityRefs[DEFENDER_COUNT];
+static TimerHandle respawnEvents[DEFENDER_COUNT];
 static int highestUsedIndex = 0;
 static int defenderTypeId = -1;
 
 /* Self-exclusion: skip this index in find_wounded/find_aggro to prevent self-targeting */
 static int currentUpdaterIdx = -1;
 
+/* Aegis auras and escort targets, rebuilt each frame (see aura_map.h) */
+static AuraMap shieldAuras;
+static AuraMap assignments;
+
 /* Sparks */
 #define SPARK_DURATION 80
 #define SPARK_SIZE 12.0
@@ -220,6 +229,55 @@ static void pick_wander_target(DefenderState *d)
 		&d->wanderTarget, &d->wanderTimer);
 }
 
+/* Spark decay runs once per frame, not from an entity that may be dormant
+   or waiting to respawn outside the AI walk */
+static void decay_sparks(const unsigned int ticks)
+{
+	for (int si = 0; si < SPARK_POOL_SIZE; si++) {
+		if (sparks[si].active) {
+			sparks[si].ticksLeft -= ticks;
+			if (sparks[si].ticksLeft <= 0)
+				sparks[si].active = false;
+		}
+	}
+}
+
+static void respawn(int idx)
+{
+	DefenderState *d = &defenders[idx];
+	PlaceableComponent *pl = &placeables[idx];
+	bool dormant = !SpatialGrid_is_active(pl->position.x, pl->position.y);
+
+	d->alive = true;
+	d->hp = DEFENDER_HP;
+	d->aiState = DEFENDER_IDLE;
+	d->killedByPlayer = false;
+	SubHeal_init(&d->healCore);
+	SubShield_init(&d->shieldCore);
+	SubCauterize_init(&d->cauterizeCore);
+	SubImmolate_init(&d->immolateCore);
+	EnemyFeedback_reset(&d->fb);
+	Burn_reset(&d->burn);
+	Position oldPos = pl->position;
+	pl->position = d->spawnPoint;
+	pick_wander_target(d);
+	/* NO respawn sound while dormant */
+	if (!dormant)
+		Audio_play_sample_at(&sampleRespawn, pl->position);
+	SpatialGrid_update((EntityRef){ENTITY_DEFENDER, idx},
+		oldPos.x, oldPos.y, pl->position.x, pl->position.y);
+	Entity_set_ai_suspended(entityRefs[idx], false);
+}
+
+/* The dead leave the AI walk until their respawn event fires; if the
+   wheel is full they stay in it and retry from the DEAD state */
+static void schedule_respawn(int idx)
+{
+	respawnEvents[idx] = TimerWheel_schedule(RESPAWN_MS, respawn, idx);
+	if (TimerWheel_is_pending(respawnEvents[idx]))
+		Entity_set_ai_suspended(entityRefs[idx], true);
+}
+
 static bool is_shield_active(DefenderState *d)
 {
 	if (d->theme == THEME_FIRE)
@@ -234,36 +292,61 @@ static bool is_shield_in_grace(DefenderState *d)
 	return SubShield_in_grace(&d->shieldCore);
 }
 
+static bool shield_may_cover(DefenderState *d)
+{
+	return d->alive && (d->aegisWasActive || is_shield_active(d) || is_shield_in_grace(d));
+}
+
+static void register_auras(int idx)
+{
+	DefenderState *d = &defenders[idx];
+	if (shield_may_cover(d))
+		AuraMap_insert(&shieldAuras, idx, placeables[idx].position);
+	if (d->alive && d->hasAssignment && d->aiState == DEFENDER_SUPPORTING)
+		AuraMap_insert(&assignments, idx, d->assignedTarget);
+}
+
+static void rebuild_auras(const unsigned int ticks)
+{
+	(void)ticks;
+	AuraMap_clear(&shieldAuras);
+	AuraMap_clear(&assignments);
+	for (int i = 0; i < highestUsedIndex; i++)
+		register_auras(i);
+}
+
+static bool shielding_match(int owner, Position pos, void *context)
+{
+	if (owner == *(int *)context)
+		return false;
+	DefenderState *other = &defenders[owner];
+	if (!other->alive || !is_shield_active(other))
+		return false;
+	return Enemy_distance_between(placeables[owner].position, pos) < PROTECT_RADIUS;
+}
+
 static bool another_defender_shielding(int selfIdx, Position targetPos)
 {
-	for (int i = 0; i < highestUsedIndex; i++) {
-		if (i == selfIdx)
-			continue;
-		DefenderState *other = &defenders[i];
-		if (!other->alive || !is_shield_active(other))
-			continue;
-		double dist = Enemy_distance_between(placeables[i].position, targetPos);
-		if (dist < PROTECT_RADIUS)
-			return true;
-	}
-	return false;
+	return AuraMap_find(&shieldAuras, targetPos, PROTECT_RADIUS + AURA_SLACK,
+		shielding_match, &selfIdx) >= 0;
+}
+
+static bool assigned_match(int owner, Position pos, void *context)
+{
+	if (owner == *(int *)context)
+		return false;
+	DefenderState *other = &defenders[owner];
+	if (!other->alive || !other->hasAssignment)
+		return false;
+	if (other->aiState != DEFENDER_SUPPORTING)
+		return false;
+	return Enemy_distance_between(other->assignedTarget, pos) < PROTECT_RADIUS * 2;
 }
 
 static bool another_defender_assigned(int selfIdx, Position targetPos)
 {
-	for (int i = 0; i < highestUsedIndex; i++) {
-		if (i == selfIdx)
-			continue;
-		DefenderState *other = &defenders[i];
-		if (!other->alive || !other->hasAssignment)
-			continue;
-		if (other->aiState != DEFENDER_SUPPORTING)
-			continue;
-		double dist = Enemy_distance_between(other->assignedTarget, targetPos);
-		if (dist < PROTECT_RADIUS * 2)
-			return true;
-	}
-	return false;
+	return AuraMap_find(&assignments, targetPos, PROTECT_RADIUS * 2,
+		assigned_match, &selfIdx) >= 0;
 }
 
 static bool find_best_wounded(Position from, int *outType, Position *outPos, int *outIdx)
@@ -407,7 +490,6 @@ void Defender_initialize(Position position, ZoneTheme theme)
 	d->boosting = false;
 	d->prevPosition = position;
 	d->deathTimer = 0;
-	d->respawnTimer = 0;
 	EnemyFeedback_init(&d->fb);
 	pick_wander_target(d);
 
@@ -421,7 +503,7 @@ void Defender_initialize(Position position, ZoneTheme theme)
 	entity.collidable = &collidable;
 	entity.aiUpdatable = &updatable;
 
-	entityRefs[idx] = Entity_add_entity(entity);
+	entityRefs[idx] = Entity_create(entity);
 
 	highestUsedIndex++;
 
@@ -443,6 +525,10 @@ void Defender_initialize(Position position, ZoneTheme theme)
 		GlobalRender_register(RENDER_PASS_BLOOM_SOURCE, Defender_render_fire_aura_bloom);
 		GlobalRender_register(RENDER_PASS_LIGHT_SOURCE, Defender_render_fire_aura_light);
 		GlobalUpdate_register_post_collision(Defender_update_fire_auras);
+		GlobalUpdate_register_pre_collision(decay_sparks);
+		GlobalUpdate_register_pre_collision(rebuild_auras);
+		AuraMap_init(&shieldAuras, PROTECT_RADIUS * 2);
+		AuraMap_init(&assignments, PROTECT_RADIUS * 2);
 		pipelineRegistered = true;
 	}
 
@@ -457,13 +543,14 @@ void Defender_initialize(Position position, ZoneTheme theme)
 void Defender_cleanup(void)
 {
 	for (int i = 0; i < highestUsedIndex; i++) {
-		if (entityRefs[i]) {
-			entityRefs[i]->empty = true;
-			entityRefs[i] = NULL;
-		}
+		TimerWheel_cancel(respawnEvents[i]);
+		Entity_release(entityRefs[i]);
+		entityRefs[i] = (EntityHandle){0, 0};
 	}
 	highestUsedIndex = 0;
 	defenderTypeId = -1;
+	AuraMap_clear(&shieldAuras);
+	AuraMap_clear(&assignments);
 	for (int i = 0; i < SPARK_POOL_SIZE; i++)
 		sparks[i].active = false;
 
@@ -512,41 +599,10 @@ void Defender_update(void *state, const PlaceableComponent *placeable, unsigned
 	PlaceableComponent *pl = &placeables[idx];
 	double dt = ticks / 1000.0;
 
-	/* Spark decay must run unconditionally (shared pool, not per-entity) */
-	if (idx == 0) {
-		for (int si = 0; si < SPARK_POOL_SIZE; si++) {
-			if (sparks[si].active) {
-				sparks[si].ticksLeft -= ticks;
-				if (sparks[si].ticksLeft <= 0)
-					sparks[si].active = false;
-			}
-		}
-	}
-
-	/* Dormancy check — only tick respawn timer if dormant */
+	/* Dormancy check — nothing to do while dormant */
 	if (!SpatialGrid_is_active(pl->position.x, pl->position.y)) {
-		if (d->aiState == DEFENDER_DEAD) {
-			d->respawnTimer += ticks;
-			if (d->respawnTimer >= RESPAWN_MS) {
-				d->alive = true;
-				d->hp = DEFENDER_HP;
-				d->aiState = DEFENDER_IDLE;
-				d->killedByPlayer = false;
-				SubHeal_init(&d->healCore);
-				SubShield_init(&d->shieldCore);
-				SubCauterize_init(&d->cauterizeCore);
-				SubImmolate_init(&d->immolateCore);
-				EnemyFeedback_reset(&d->fb);
-				Burn_reset(&d->burn);
-				Position oldPos = pl->position;
-				pl->position = d->spawnPoint;
-				pick_wander_target(d);
-				/* NO respawn sound while dormant */
-				SpatialGrid_update((EntityRef){ENTITY_DEFENDER, idx},
-					oldPos.x, oldPos.y,
-					d->spawnPoint.x, d->spawnPoint.y);
-			}
-		}
+		if (d->aiState == DEFENDER_DEAD && !TimerWheel_is_pending(respawnEvents[idx]))
+			schedule_respawn(idx);
 		return;
 	}
 
@@ -763,6 +819,7 @@ void Defender_update(void *state, const PlaceableComponent *placeable, unsigned
 		if (hasTarget) {
 			d->hasAssignment = true;
 			d->assignedTarget = allyPos;
+			AuraMap_insert(&assignments, idx, allyPos);
 		}
 
 		if (hasTarget) {
@@ -827,7 +884,7 @@ void Defender_update(void *state, const PlaceableComponent *placeable, unsigned
 		d->deathTimer += ticks;
 		if (d->deathTimer >= DEATH_FLASH_MS) {
 			d->aiState = DEFENDER_DEAD;
-			d->respawnTimer = 0;
+			schedule_respawn(idx);
 
 			/* Drop fragment */
 			if (d->killedByPlayer) {
@@ -840,22 +897,9 @@ void Defender_update(void *state, const PlaceableComponent *placeable, unsigned
 		break;
 
 	case DEFENDER_DEAD:
-		d->respawnTimer += ticks;
-		if (d->respawnTimer >= RESPAWN_MS) {
-			d->alive = true;
-			d->hp = DEFENDER_HP;
-			d->aiState = DEFENDER_IDLE;
-			d->killedByPlayer = false;
-			SubHeal_init(&d->healCore);
-			SubShield_init(&d->shieldCore);
-			SubCauterize_init(&d->cauterizeCore);
-			SubImmolate_init(&d->immolateCore);
-			EnemyFeedback_reset(&d->fb);
-			Burn_reset(&d->burn);
-			pl->position = d->spawnPoint;
-			pick_wander_target(d);
-			Audio_play_sample_at(&sampleRespawn, pl->position);
-		}
+		/* Respawn is a timer event; only reached if scheduling failed */
+		if (!TimerWheel_is_pending(respawnEvents[idx]))
+			schedule_respawn(idx);
 		break;
 	}
 
@@ -866,6 +910,10 @@ void Defender_update(void *state, const PlaceableComponent *placeable, unsigned
 	/* Update spatial grid if position changed */
 	SpatialGrid_update((EntityRef){ENTITY_DEFENDER, idx},
 		oldPos.x, oldPos.y, pl->position.x, pl->position.y);
+
+	/* Aegis may have moved or popped this update — index where it is now */
+	if (shield_may_cover(d))
+		AuraMap_insert(&shieldAuras, idx, pl->position);
 }
 
 static void render_hexagon(Position pos, float radius, float thickness,
@@ -1026,13 +1074,27 @@ void Defender_reset_all(void)
 		Burn_reset(&d->burn);
 		d->boosting = false;
 		d->deathTimer = 0;
-		d->respawnTimer = 0;
+		TimerWheel_cancel(respawnEvents[i]);
+		Entity_set_ai_suspended(entityRefs[i], false);
 		placeables[i].position = d->spawnPoint;
 		d->prevPosition = d->spawnPoint;
 		pick_wander_target(d);
 	}
 	for (int i = 0; i < SPARK_POOL_SIZE; i++)
 		sparks[i].active = false;
+	rebuild_auras(0);
+}
+
+static bool protecting_match(int owner, Position pos, void *context)
+{
+	(void)context;
+	DefenderState *d = &defenders[owner];
+	if (!d->alive)
+		return false;
+	/* Protected if aegis was active this frame OR in post-break grace */
+	if (!d->aegisWasActive && !is_shield_in_grace(d))
+		return false;
+	return Enemy_distance_between(placeables[owner].position, pos) < PROTECT_RADIUS;
 }
 
 bool Defender_is_protecting(Position pos, bool ambush)
@@ -1041,37 +1103,33 @@ bool Defender_is_protecting(Position pos, bool ambush)
 	if (ambush)
 		return false;
 
-	for (int i = 0; i < highestUsedIndex; i++) {
-		DefenderState *d = &defenders[i];
-		if (!d->alive)
-			continue;
-		/* Protected if aegis was active this frame OR in post-break grace */
-		if (!d->aegisWasActive && !is_shield_in_grace(d))
-			continue;
-		double dist = Enemy_distance_between(placeables[i].position, pos);
-		if (dist < PROTECT_RADIUS)
-			return true;
-	}
-	return false;
+	return AuraMap_find(&shieldAuras, pos, PROTECT_RADIUS + AURA_SLACK,
+		protecting_match, NULL) >= 0;
+}
+
+static bool shield_hit_match(int owner, Position pos, void *context)
+{
+	(void)context;
+	DefenderState *d = &defenders[owner];
+	if (!d->alive)
+		return false;
+	if (!is_shield_active(d) && !is_shield_in_grace(d))
+		return false;
+	return Enemy_distance_between(placeables[owner].position, pos) < PROTECT_RADIUS;
 }
 
 void Defender_notify_shield_hit(Position pos)
 {
-	for (int i = 0; i < highestUsedIndex; i++) {
-		DefenderState *d = &defenders[i];
-		if (!d->alive)
-			continue;
-		if (!is_shield_active(d) && !is_shield_in_grace(d))
-			continue;
-		double dist = Enemy_distance_between(placeables[i].position, pos);
-		if (dist < PROTECT_RADIUS) {
-			if (d->theme == THEME_FIRE)
-				SubImmolate_on_hit(&d->immolateCore, placeables[i].position);
-			else
-				SubShield_on_hit(&d->shieldCore, placeables[i].position);
-			return;
-		}
-	}
+	int i = AuraMap_find(&shieldAuras, pos, PROTECT_RADIUS + AURA_SLACK,
+		shield_hit_match, NULL);
+	if (i < 0)
+		return;
+
+	DefenderState *d = &defenders[i];
+	if (d->theme == THEME_FIRE)
+		SubImmolate_on_hit(&d->immolateCore, placeables[i].position);
+	else
+		SubShield_on_hit(&d->shieldCore, placeables[i].position);
 }
 
 bool Defender_find_wounded(Position from, double range, double hp_threshold, Position *out_pos, int *out_index)
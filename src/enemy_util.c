@@ -32,11 +32,26 @@
 #include "enemy_registry.h"
 
 #include <math.h>
+#include <string.h>
 #include <stdlib.h>
 #include <SDL2/SDL.h>
 
+static EnemyQueryStats queryStats;
+
+const EnemyQueryStats *Enemy_get_query_stats(void)
+{
+	return &queryStats;
+}
+
+void Enemy_reset_query_stats(void)
+{
+	memset(&queryStats, 0, sizeof(queryStats));
+}
+
 static PlayerDamageResult check_player_damage_internal(Rectangle hitBox, Position enemyPos, int volley_cap)
 {
+	queryStats.damageChecks++;
+
 	PlayerDamageResult r = {false, false, false, 0.0, 0.0};
 	double dist = Enemy_distance_between(enemyPos, Ship_get_position());
 	double mul = Sub_Stealth_get_damage_multiplier(dist);
@@ -213,6 +228,7 @@ double Enemy_distance_between(Position a, Position b)
 
 bool Enemy_has_line_of_sight(Position from, Position to)
 {
+	queryStats.losTests++;
 	double hx, hy;
 	return !Map_line_test_hit(from.x, from.y, to.x, to.y, &hx, &hy);
 }
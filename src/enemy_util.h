@@ -24,6 +24,14 @@ PlayerDamageResult Enemy_check_player_damage(Rectangle hitBox, Position enemyPos
    hits per firing event. 0 = unlimited. Use for large targets like bosses. */
 PlayerDamageResult Enemy_check_player_damage_capped(Rectangle hitBox, Position enemyPos, int max_per_volley);
 
+/* Query counters since the last reset (see bench/bench_ai.c) */
+typedef struct {
+	unsigned long losTests;       /* Enemy_has_line_of_sight calls */
+	unsigned long damageChecks;   /* Enemy_check_player_damage(_capped) calls */
+} EnemyQueryStats;
+const EnemyQueryStats *Enemy_get_query_stats(void);
+void Enemy_reset_query_stats(void);
+
 /* Call when an enemy is killed by the player. Handles ambush kill rewards. */
 void Enemy_on_player_kill(const PlayerDamageResult *dmg);
 
@@ -1,12 +1,57 @@
 #include "entity.h"
 #include "spatial_grid.h"
+#include "timer.h"
 
 #include <stdio.h>
 
-static unsigned int highestIndex = 0;
 static Entity entities[ENTITY_COUNT];
 static unsigned int highestCollisionIndex = 0;
 static ResolveCollisionCommand collisions[COLLISION_COUNT];
+static EntityCollisionStats collisionStats;
+
+/* Slot allocator: a stack of free slots (lowest index on top after a reset)
+   and a generation per slot, bumped on every free so old handles go stale */
+static unsigned int freeSlots[ENTITY_COUNT];
+static unsigned int freeCount = 0;
+static unsigned int generations[ENTITY_COUNT];
+static bool allocatorReady = false;
+
+/* One dense set per component the systems walk. An entity joins a set at
+   creation when it has that component and a placeable; each entry packs
+   the pointers the system calls with, so a walk reads contiguous entries
+   and never tests for missing components. Frees tombstone the entry and
+   the set is compacted, order preserved, before its next walk. */
+#define TOMBSTONE ENTITY_COUNT
+
+typedef struct {
+	unsigned int slot;
+	void *state;
+	PlaceableComponent *placeable;
+	const void *component;
+} ComponentEntry;
+
+typedef struct {
+	ComponentEntry dense[ENTITY_COUNT];
+	int sparse[ENTITY_COUNT];	/* slot -> entry index + 1, 0 = absent */
+	int count;
+	bool holes;
+} ComponentSet;
+
+enum {
+	SET_PLACEABLE,
+	SET_USER_UPDATE,
+	SET_AI_UPDATE,
+	SET_RENDER,
+	SET_COLLIDE,
+	SET_COUNT
+};
+
+static ComponentSet sets[SET_COUNT];
+
+/* Positions at the start of the current simulation step, for rendering
+   between steps. Moves longer than INTERP_SNAP_DISTANCE snap. */
+static Position prevPositions[ENTITY_COUNT];
+static bool hasPrevPosition[ENTITY_COUNT];
 
 Entity Entity_initialize_entity() 
 {
@@ -23,86 +68,233 @@ Entity Entity_initialize_entity()
 	return entity;
 }
 
-Entity* Entity_add_entity(const Entity entity)
+static ComponentSet *compacted(int which)
 {
-	unsigned int entityId;
-	for(entityId = 0; entityId < ENTITY_COUNT; ++entityId)
-	{
-		if(entities[entityId].empty)
-			break;
+	ComponentSet *set = &sets[which];
+	if (!set->holes)
+		return set;
+	int n = 0;
+	for (int k = 0; k < set->count; k++) {
+		if (set->dense[k].slot == TOMBSTONE)
+			continue;
+		set->dense[n] = set->dense[k];
+		set->sparse[set->dense[n].slot] = n + 1;
+		n++;
 	}
+	set->count = n;
+	set->holes = false;
+	return set;
+}
+
+static void set_insert(int which, unsigned int slot, const void *component)
+{
+	ComponentSet *set = &sets[which];
+	if (set->count >= ENTITY_COUNT)
+		compacted(which);
+	ComponentEntry *e = &set->dense[set->count++];
+	e->slot = slot;
+	e->state = entities[slot].state;
+	e->placeable = entities[slot].placeable;
+	e->component = component;
+	set->sparse[slot] = set->count;
+}
+
+static void set_remove(int which, unsigned int slot)
+{
+	ComponentSet *set = &sets[which];
+	int k = set->sparse[slot];
+	if (k == 0)
+		return;
+	set->dense[k - 1].slot = TOMBSTONE;
+	set->sparse[slot] = 0;
+	set->holes = true;
+}
+
+/* Component composition is fixed at creation */
+static void join_sets(unsigned int slot)
+{
+	const Entity *e = &entities[slot];
+	if (e->disabled || e->placeable == 0)
+		return;
+	set_insert(SET_PLACEABLE, slot, e->placeable);
+	if (e->userUpdatable)
+		set_insert(SET_USER_UPDATE, slot, e->userUpdatable);
+	if (e->aiUpdatable && e->state)
+		set_insert(SET_AI_UPDATE, slot, e->aiUpdatable);
+	if (e->renderable)
+		set_insert(SET_RENDER, slot, e->renderable);
+	if (e->collidable)
+		set_insert(SET_COLLIDE, slot, e->collidable);
+}
+
+static void free_slot(unsigned int entityId)
+{
+	entities[entityId].empty = true;
+	generations[entityId]++;
+	freeSlots[freeCount++] = entityId;
+	for (int i = 0; i < SET_COUNT; i++)
+		set_remove(i, entityId);
+}
 
-	if (entityId >= ENTITY_COUNT) {
+EntityHandle Entity_create(const Entity entity)
+{
+	if (!allocatorReady)
+		Entity_destroy_all();
+
+	if (freeCount == 0) {
 		printf("WARNING: Entity pool full (%d)\n", ENTITY_COUNT);
-		return NULL;
+		return (EntityHandle){0, 0};
 	}
 
-	if (highestIndex < entityId)
-		highestIndex = entityId;
-
+	unsigned int entityId = freeSlots[--freeCount];
+	entities[entityId] = entity;
 	entities[entityId].empty = false;
-	entities[entityId].disabled = entity.disabled;
-	entities[entityId].state = entity.state;
-	entities[entityId].placeable = entity.placeable;
-	entities[entityId].renderable = entity.renderable;
-	entities[entityId].collidable = entity.collidable;
-	entities[entityId].dynamics = entity.dynamics;
-	entities[entityId].userUpdatable = entity.userUpdatable;
-	entities[entityId].aiUpdatable = entity.aiUpdatable;
+	hasPrevPosition[entityId] = false;
+	join_sets(entityId);
 
-	return &entities[entityId];
+	return (EntityHandle){entityId, generations[entityId]};
+}
+
+Entity* Entity_add_entity(const Entity entity)
+{
+	EntityHandle handle = Entity_create(entity);
+	return Entity_get(handle);
+}
+
+Entity *Entity_get(EntityHandle handle)
+{
+	if (!Entity_is_alive(handle)) {
+#ifndef NDEBUG
+		if (handle.generation != 0)
+			printf("WARNING: stale entity handle (slot %u, gen %u, now %u)\n",
+				handle.index, handle.generation,
+				handle.index < ENTITY_COUNT ? generations[handle.index] : 0);
+#endif
+		return NULL;
+	}
+	return &entities[handle.index];
+}
+
+bool Entity_is_alive(EntityHandle handle)
+{
+	return handle.index < ENTITY_COUNT && handle.generation != 0 &&
+		generations[handle.index] == handle.generation &&
+		!entities[handle.index].empty;
+}
+
+void Entity_release(EntityHandle handle)
+{
+	if (Entity_is_alive(handle)) {
+		free_slot(handle.index);
+		return;
+	}
+#ifndef NDEBUG
+	/* Already gone is fine (e.g. after Entity_destroy_all); a reused slot
+	   means the owner kept the handle past a reset and respawned over it */
+	if (handle.generation != 0 && handle.index < ENTITY_COUNT &&
+			!entities[handle.index].empty)
+		printf("WARNING: release of stale entity handle (slot %u, gen %u, now %u)\n",
+			handle.index, handle.generation, generations[handle.index]);
+#endif
 }
 
 void Entity_destroy_all(void)
 {
-	for (unsigned int entityId = 0; entityId < ENTITY_COUNT; ++entityId)
+	/* Generations start at 1 so a zeroed handle is never live */
+	for (unsigned int entityId = 0; entityId < ENTITY_COUNT; ++entityId) {
 		entities[entityId].empty = true;
-	highestIndex = 0;
+		generations[entityId]++;
+		freeSlots[entityId] = ENTITY_COUNT - 1 - entityId;
+	}
+	freeCount = ENTITY_COUNT;
+	for (int i = 0; i < SET_COUNT; i++) {
+		for (int k = 0; k < sets[i].count; k++)
+			if (sets[i].dense[k].slot != TOMBSTONE)
+				sets[i].sparse[sets[i].dense[k].slot] = 0;
+		sets[i].count = 0;
+		sets[i].holes = false;
+	}
+	allocatorReady = true;
 }
 
 void Entity_destroy(const unsigned int entityId)
 {
-	if (entityId >= ENTITY_COUNT)
+	if (entityId >= ENTITY_COUNT || entities[entityId].empty)
 		return;
-
-	entities[entityId].empty = true;
-
-	if (entityId == highestIndex) {
-		while (highestIndex > 0 && entities[highestIndex].empty)
-			highestIndex--;
-	}
+	free_slot(entityId);
 }
 
-void Entity_recalculate_highest_index(void)
+void Entity_set_ai_suspended(EntityHandle handle, bool suspended)
 {
-	while (highestIndex > 0 && entities[highestIndex].empty)
-		highestIndex--;
+	if (!Entity_is_alive(handle))
+		return;
+	unsigned int slot = handle.index;
+	const Entity *e = &entities[slot];
+	if (e->disabled || e->placeable == 0 || e->aiUpdatable == 0 || e->state == 0)
+		return;
+	bool member = sets[SET_AI_UPDATE].sparse[slot] != 0;
+	if (suspended && member)
+		set_remove(SET_AI_UPDATE, slot);
+	else if (!suspended && !member)
+		set_insert(SET_AI_UPDATE, slot, e->aiUpdatable);
 }
 
+/* Entries freed during a walk are tombstoned in place, so every loop
+   still checks the slot */
+
 void Entity_user_update_system(const Input *input, const unsigned int ticks)
 {
-	for(int i = 0; i <= highestIndex; i++) 
+	ComponentSet *set = compacted(SET_USER_UPDATE);
+	for (int k = 0; k < set->count; k++)
 	{
-		if (entities[i].empty || entities[i].disabled || entities[i].userUpdatable == 0 ||
-				entities[i].placeable == 0)
+		const ComponentEntry *e = &set->dense[k];
+		if (e->slot == TOMBSTONE)
 			continue;
-
-		entities[i].userUpdatable->update(input, ticks, entities[i].placeable);
+		((const UserUpdatableComponent *)e->component)->update(input, ticks, e->placeable);
 	}
 }
 
 void Entity_ai_update_system(const unsigned int ticks)
 {
-	for(int i = 0; i <= highestIndex; i++) 
+	ComponentSet *set = compacted(SET_AI_UPDATE);
+	for (int k = 0; k < set->count; k++)
 	{
-		if (entities[i].empty || entities[i].disabled || entities[i].aiUpdatable == 0 ||
-			entities[i].placeable == 0 || entities[i].state == 0)
+		const ComponentEntry *e = &set->dense[k];
+		if (e->slot == TOMBSTONE)
 			continue;
+		((const AIUpdatableComponent *)e->component)->update(e->state, e->placeable, ticks);
+	}
+}
 
-		entities[i].aiUpdatable->update(entities[i].state, entities[i].placeable, ticks);
+void Entity_snapshot_positions(void)
+{
+	ComponentSet *set = compacted(SET_PLACEABLE);
+	for (int k = 0; k < set->count; k++) {
+		unsigned int i = set->dense[k].slot;
+		if (i == TOMBSTONE)
+			continue;
+		hasPrevPosition[i] = true;
+		prevPositions[i] = set->dense[k].placeable->position;
 	}
 }
 
+static PlaceableComponent interpolated_placeable(unsigned int i, const PlaceableComponent *current)
+{
+	PlaceableComponent placeable = *current;
+	double alpha = timer_render_alpha();
+	if (!hasPrevPosition[i] || alpha >= 1.0)
+		return placeable;
+
+	double dx = placeable.position.x - prevPositions[i].x;
+	double dy = placeable.position.y - prevPositions[i].y;
+	if (dx * dx + dy * dy > INTERP_SNAP_DISTANCE * INTERP_SNAP_DISTANCE)
+		return placeable;
+
+	placeable.position.x = prevPositions[i].x + dx * alpha;
+	placeable.position.y = prevPositions[i].y + dy * alpha;
+	return placeable;
+}
+
 void Entity_render_system(void)
 {
 	Entity_render_pass(RENDER_PASS_MAIN);
@@ -110,73 +302,77 @@ void Entity_render_system(void)
 
 void Entity_render_pass(RenderPass pass)
 {
-	for (int i = 0; i <= highestIndex; i++)
+	ComponentSet *set = compacted(SET_RENDER);
+	for (int k = 0; k < set->count; k++)
 	{
-		if (entities[i].empty || entities[i].disabled || entities[i].renderable == 0 ||
-			entities[i].placeable == 0)
+		const ComponentEntry *e = &set->dense[k];
+		if (e->slot == TOMBSTONE)
+			continue;
+
+		RenderFunc fn = ((const RenderableComponent *)e->component)->passes[pass];
+		if (!fn)
 			continue;
 
-		if (!SpatialGrid_is_active(entities[i].placeable->position.x,
-								   entities[i].placeable->position.y))
+		if (!SpatialGrid_is_active(e->placeable->position.x,
+								   e->placeable->position.y))
 			continue;
 
-		RenderFunc fn = entities[i].renderable->passes[pass];
-		if (fn)
-			fn(entities[i].state, entities[i].placeable);
+		PlaceableComponent placeable = interpolated_placeable(e->slot, e->placeable);
+		fn(e->state, &placeable);
 	}
 }
 
 void Entity_collision_system(void)
 {
 	highestCollisionIndex = 0;
+	collisionStats.pairsTested = 0;
 
-	for(int i = 0; i <= highestIndex; i++)
+	ComponentSet *set = compacted(SET_COLLIDE);
+	for (int k = 0; k < set->count; k++)
 	{
-		if (entities[i].empty || entities[i].disabled || entities[i].collidable == 0 ||
-			entities[i].placeable == 0)
+		const ComponentEntry *a = &set->dense[k];
+		if (a->slot == TOMBSTONE)
 			continue;
 
-		if (!entities[i].collidable->collidesWithOthers)
+		const CollidableComponent *ac = a->component;
+		if (!ac->collidesWithOthers)
 			continue;
 
-		if (!SpatialGrid_is_active(entities[i].placeable->position.x,
-								   entities[i].placeable->position.y))
+		if (!SpatialGrid_is_active(a->placeable->position.x,
+								   a->placeable->position.y))
 			continue;
 
-		for (int j = 0; j <= highestIndex; j++)
-		{
-			if (entities[j].empty || entities[j].disabled || entities[j].collidable == 0 ||
-				entities[j].placeable == 0)
-				continue;
+		// create a transformed bounding box for i
+		Position position = a->placeable->position;
+		Rectangle transformedBoundingBox = Collision_transform_bounding_box(position, ac->boundingBox);
 
-			if (i == j)
+		for (int m = 0; m < set->count; m++)
+		{
+			const ComponentEntry *b = &set->dense[m];
+			if (m == k || b->slot == TOMBSTONE)
 				continue;
 
-			if (entities[j].collidable->collidesWithOthers &&
-				!SpatialGrid_is_active(entities[j].placeable->position.x,
-									   entities[j].placeable->position.y))
+			const CollidableComponent *bc = b->component;
+			if (!(ac->mask & bc->layer))
 				continue;
 
-			if (!(entities[i].collidable->mask & entities[j].collidable->layer))
+			if (bc->collidesWithOthers &&
+				!SpatialGrid_is_active(b->placeable->position.x,
+									   b->placeable->position.y))
 				continue;
 
-			// create a transformed bounding box for i
-			Position position = entities[i].placeable->position;
-			Rectangle boundingBox = entities[i].collidable->boundingBox;
-			Rectangle transformedBoundingBox = Collision_transform_bounding_box(position, boundingBox);
-
 			// call j's collide with i's transformed bounding box
-			Collision collision = entities[j].collidable->collide(entities[j].state, 
-																	entities[j].placeable, 
-																	transformedBoundingBox);
-			
+			collisionStats.pairsTested++;
+			Collision collision = bc->collide(b->state, b->placeable,
+				transformedBoundingBox);
+
 			// call i's collision resolver if there was a collision
 			if (collision.collisionDetected)
-				Entity_create_collision_command(entities[i].collidable->resolve, 
-					entities[i].state, collision);
+				Entity_create_collision_command(ac->resolve, a->state, collision);
 		}
 	}
 
+	collisionStats.collisions = highestCollisionIndex;
 	for (int i = 0; i < highestCollisionIndex; i++) 
 	{
 		ResolveCollisionCommand collision = collisions[i];
@@ -184,6 +380,11 @@ void Entity_collision_system(void)
 	}
 }
 
+const EntityCollisionStats *Entity_get_collision_stats(void)
+{
+	return &collisionStats;
+}
+
 void Entity_create_collision_command(void (*resolve)(void *state, const Collision collision),
 	void *state, Collision collision)
 {
@@ -9,6 +9,13 @@
 #define ENTITY_COUNT 16384
 #define COLLISION_COUNT 4096
 
+/* Render interpolation treats moves longer than this within one step as
+   teleports and snaps to the new position */
+#define INTERP_SNAP_DISTANCE 500.0
+
+/* Components and the disabled flag are read once, when the entity is
+   created, to place it in the per-component system sets; changing them
+   afterwards has no effect */
 typedef struct {
 	bool empty;
 	bool disabled;
@@ -21,6 +28,14 @@ typedef struct {
 	AIUpdatableComponent *aiUpdatable;
 } Entity;
 
+/* Slot index plus the slot's generation when the entity was created. Goes
+   stale once that entity is destroyed, even if the slot is reused. A zeroed
+   handle never refers to anything. */
+typedef struct {
+	unsigned int index;
+	unsigned int generation;
+} EntityHandle;
+
 typedef struct {
 	void (*resolve)(void *state, const Collision collision);
 	void *state;
@@ -28,16 +43,34 @@ typedef struct {
 } ResolveCollisionCommand;
 
 Entity Entity_initialize_entity();
+EntityHandle Entity_create(const Entity entity);
 Entity* Entity_add_entity(const Entity entity);
+/* NULL when the handle is stale (reported in debug builds) */
+Entity *Entity_get(EntityHandle handle);
+bool Entity_is_alive(EntityHandle handle);
+/* Destroy the entity if the handle is still live; no-op otherwise */
+void Entity_release(EntityHandle handle);
 void Entity_destroy_all(void);
 void Entity_destroy(const unsigned int entityId);
-void Entity_recalculate_highest_index(void);
+/* Take the entity out of the AI update walk, or put it back at the end.
+   For entities that only wait on a scheduled event (see timer_wheel.h).
+   No-op for stale handles. */
+void Entity_set_ai_suspended(EntityHandle handle, bool suspended);
 
 void Entity_user_update_system(const Input *input, const unsigned int ticks);
 void Entity_ai_update_system(const unsigned int ticks);
+/* Record positions at the start of a simulation step; render passes draw
+   entities interpolated between these and the current positions */
+void Entity_snapshot_positions(void);
 void Entity_render_system(void);
 void Entity_render_pass(RenderPass pass);
 void Entity_collision_system(void);
+/* Narrow-phase counts from the last Entity_collision_system run */
+typedef struct {
+	int pairsTested;   /* collide callbacks made */
+	int collisions;    /* resolve commands queued */
+} EntityCollisionStats;
+const EntityCollisionStats *Entity_get_collision_stats(void);
 void Entity_create_collision_command(void (*resolve)(void *state, const Collision collision),
 	void *state, Collision collision);
 
@@ -4,26 +4,51 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
 #include <math.h>
 #include <sys/stat.h>
 #include <dirent.h>
 
+/* Per-zone fog files from before the save container; still read for zones
+   the container does not cover yet */
 #define FOW_SAVE_DIR "./save/"
 #define FOW_SAVE_PREFIX "fog_"
 #define FOW_SAVE_EXT ".bin"
-#define FOW_BLOCK_SIZE 16
-#define FOW_MAX_ZONES 16
+#define FOW_MAX_ZONES 64
+
+/* Reveals only ever happen a whole block at a time, so fog is stored as one
+   bit per 16x16 block: row by is a 64-bit word, bit bx = block revealed.
+   512 bytes per zone instead of a 1 MB bool grid. */
+#if FOW_BLOCKS != 64
+#error "fog bitset assumes 64 blocks per side"
+#endif
+typedef uint64_t FowBits[FOW_BLOCKS];
+
+/* Per-zone file format: 12-byte header, then the payload in the given
+   encoding. Legacy saves (raw MAP_SIZE x MAP_SIZE bools, no header) are
+   still read. The save container's fog section reuses the encodings. */
+#define FOW_FILE_MAGIC "HFOW"
+#define FOW_FILE_VERSION 2
+#define FOW_HEADER_SIZE 12
+#define FOW_ENCODING_RAW 0   /* FOW_BLOCKS little-endian u64 rows */
+#define FOW_ENCODING_RLE 1   /* alternating run lengths (unrevealed first), LEB128 */
+#define FOW_PAYLOAD_MAX (FOW_BLOCKS * FOW_BLOCKS * 2)
 
 /* Active zone's revealed grid — what the map window reads */
-static bool revealed[MAP_SIZE][MAP_SIZE];
-static bool fowDirty = true;
+static FowBits revealed;
+
+/* Change feed for the map window — blocks revealed since last consumed */
+static FowBits pendingBlocks;
+static bool pendingFull = true;
 static int lastBlockX = -1;
 static int lastBlockY = -1;
 
-/* Per-zone in-memory cache — persists across zone transitions until death or save */
+/* Per-zone in-memory cache — persists across zone transitions; every
+   cached zone goes into the save container */
 typedef struct {
 	char zone_path[256];
-	bool data[MAP_SIZE][MAP_SIZE];
+	FowBits data;
 	bool in_use;
 } FowZoneCache;
 
@@ -73,27 +98,131 @@ static FowZoneCache *alloc_cache(const char *zone_path)
 	return &zoneCache[0];
 }
 
-static void save_zone_to_disk(const char *zone_path, const bool data[MAP_SIZE][MAP_SIZE])
+static void stash_active(void)
 {
-#ifdef _WIN32
-	_mkdir("./save");
-#else
-	mkdir("./save", 0755);
-#endif
+	if (!activeZonePath[0])
+		return;
+	FowZoneCache *cur = find_cache(activeZonePath);
+	if (!cur) cur = alloc_cache(activeZonePath);
+	memcpy(cur->data, revealed, sizeof(revealed));
+}
 
-	char path[512];
-	build_save_path(zone_path, path, sizeof(path));
+static bool block_bit(const FowBits data, int i)
+{
+	return (data[i / FOW_BLOCKS] >> (i % FOW_BLOCKS)) & 1u;
+}
 
-	FILE *f = fopen(path, "wb");
-	if (!f) {
-		printf("FogOfWar: failed to write %s\n", path);
-		return;
+static int encode_rle(const FowBits data, unsigned char *out, int out_size)
+{
+	int n = 0;
+	int i = 0;
+	bool value = false;
+	while (i < FOW_BLOCKS * FOW_BLOCKS) {
+		unsigned int run = 0;
+		while (i < FOW_BLOCKS * FOW_BLOCKS && block_bit(data, i) == value) {
+			run++;
+			i++;
+		}
+		do {
+			if (n >= out_size)
+				return -1;
+			unsigned char byte = run & 0x7F;
+			run >>= 7;
+			out[n++] = run ? (byte | 0x80) : byte;
+		} while (run);
+		value = !value;
 	}
-	fwrite(data, MAP_SIZE * MAP_SIZE * sizeof(bool), 1, f);
-	fclose(f);
+	return n;
+}
+
+static bool decode_rle(const unsigned char *in, int len, FowBits data)
+{
+	memset(data, 0, sizeof(FowBits));
+	int pos = 0;
+	int i = 0;
+	bool value = false;
+	while (pos < len) {
+		unsigned int run = 0;
+		int shift = 0;
+		unsigned char byte;
+		do {
+			if (pos >= len || shift > 14)
+				return false;
+			byte = in[pos++];
+			run |= (unsigned int)(byte & 0x7F) << shift;
+			shift += 7;
+		} while (byte & 0x80);
+		if (run > (unsigned int)(FOW_BLOCKS * FOW_BLOCKS - i))
+			return false;
+		if (value) {
+			for (unsigned int k = 0; k < run; k++, i++)
+				data[i / FOW_BLOCKS] |= (uint64_t)1 << (i % FOW_BLOCKS);
+		} else {
+			i += run;
+		}
+		value = !value;
+	}
+	return i == FOW_BLOCKS * FOW_BLOCKS;
+}
+
+static unsigned int get_u16(const unsigned char *p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+/* RLE when it wins (typical explored zones are a few big blobs), raw otherwise */
+static int encode_zone(const FowBits data, unsigned char payload[FOW_PAYLOAD_MAX], int *encoding)
+{
+	*encoding = FOW_ENCODING_RLE;
+	int len = encode_rle(data, payload, FOW_PAYLOAD_MAX);
+	if (len < 0 || len >= FOW_BLOCKS * 8) {
+		*encoding = FOW_ENCODING_RAW;
+		len = 0;
+		for (int by = 0; by < FOW_BLOCKS; by++)
+			for (int b = 0; b < 8; b++)
+				payload[len++] = (unsigned char)(data[by] >> (b * 8));
+	}
+	return len;
+}
+
+static bool decode_zone(int encoding, const unsigned char *payload, unsigned int len, FowBits data)
+{
+	if (encoding == FOW_ENCODING_RLE)
+		return decode_rle(payload, (int)len, data);
+	if (encoding == FOW_ENCODING_RAW && len == FOW_BLOCKS * 8) {
+		for (int by = 0; by < FOW_BLOCKS; by++) {
+			data[by] = 0;
+			for (int b = 0; b < 8; b++)
+				data[by] |= (uint64_t)payload[by * 8 + b] << (b * 8);
+		}
+		return true;
+	}
+	return false;
+}
+
+/* Pre-bitset saves were a raw bool per cell; a block is revealed if its first cell is */
+static bool load_legacy_file(FILE *f, FowBits data)
+{
+	size_t size = MAP_SIZE * MAP_SIZE * sizeof(bool);
+	bool *cells = malloc(size);
+	if (!cells)
+		return false;
+	fseek(f, 0, SEEK_SET);
+	size_t r = fread(cells, 1, size, f);
+	if (r != size) {
+		free(cells);
+		return false;
+	}
+	memset(data, 0, sizeof(FowBits));
+	for (int bx = 0; bx < FOW_BLOCKS; bx++)
+		for (int by = 0; by < FOW_BLOCKS; by++)
+			if (cells[(bx * FOW_BLOCK_SIZE) * MAP_SIZE + by * FOW_BLOCK_SIZE])
+				data[by] |= (uint64_t)1 << bx;
+	free(cells);
+	return true;
 }
 
-static bool load_zone_from_disk(const char *zone_path, bool data[MAP_SIZE][MAP_SIZE])
+static bool load_zone_from_disk(const char *zone_path, FowBits data)
 {
 	char path[512];
 	build_save_path(zone_path, path, sizeof(path));
@@ -101,14 +230,29 @@ static bool load_zone_from_disk(const char *zone_path, bool data[MAP_SIZE][MAP_S
 	FILE *f = fopen(path, "rb");
 	if (!f)
 		return false;
-	size_t r = fread(data, 1, MAP_SIZE * MAP_SIZE * sizeof(bool), f);
+
+	unsigned char header[FOW_HEADER_SIZE];
+	unsigned char payload[FOW_PAYLOAD_MAX];
+	bool ok = false;
+	if (fread(header, 1, sizeof(header), f) == sizeof(header) &&
+		memcmp(header, FOW_FILE_MAGIC, 4) == 0) {
+		unsigned int len = get_u16(header + 10);
+		if (header[4] == FOW_FILE_VERSION &&
+			get_u16(header + 6) == FOW_BLOCKS &&
+			get_u16(header + 8) == FOW_BLOCK_SIZE &&
+			len <= sizeof(payload) &&
+			fread(payload, 1, len, f) == len)
+			ok = decode_zone(header[5], payload, len, data);
+	} else {
+		ok = load_legacy_file(f, data);
+	}
 	fclose(f);
-	if (r != MAP_SIZE * MAP_SIZE * sizeof(bool)) {
-		printf("FogOfWar: save file size mismatch for %s, resetting\n", path);
-		memset(data, 0, MAP_SIZE * MAP_SIZE * sizeof(bool));
-		return false;
+
+	if (!ok) {
+		printf("FogOfWar: unreadable save file %s, resetting\n", path);
+		memset(data, 0, sizeof(FowBits));
 	}
-	return true;
+	return ok;
 }
 
 /* --- Public API --- */
@@ -118,7 +262,7 @@ void FogOfWar_initialize(void)
 	memset(revealed, 0, sizeof(revealed));
 	memset(zoneCache, 0, sizeof(zoneCache));
 	activeZonePath[0] = '\0';
-	fowDirty = true;
+	pendingFull = true;
 	lastBlockX = -1;
 	lastBlockY = -1;
 }
@@ -130,7 +274,7 @@ void FogOfWar_cleanup(void)
 void FogOfWar_reset_active(void)
 {
 	memset(revealed, 0, sizeof(revealed));
-	fowDirty = true;
+	pendingFull = true;
 	lastBlockX = -1;
 	lastBlockY = -1;
 }
@@ -144,13 +288,10 @@ void FogOfWar_set_zone(const char *zone_path)
 		return;
 
 	/* Stash current active grid into cache */
-	if (activeZonePath[0]) {
-		FowZoneCache *cur = find_cache(activeZonePath);
-		if (!cur) cur = alloc_cache(activeZonePath);
-		memcpy(cur->data, revealed, sizeof(revealed));
-	}
+	stash_active();
 
-	/* Load destination from cache, then disk, then start fresh */
+	/* Load destination from cache (which holds the save container's zones),
+	   then an old per-zone file, then start fresh */
 	FowZoneCache *dest = find_cache(zone_path);
 	if (dest) {
 		memcpy(revealed, dest->data, sizeof(revealed));
@@ -160,49 +301,74 @@ void FogOfWar_set_zone(const char *zone_path)
 
 	strncpy(activeZonePath, zone_path, sizeof(activeZonePath) - 1);
 	activeZonePath[sizeof(activeZonePath) - 1] = '\0';
-	fowDirty = true;
+	pendingFull = true;
 	lastBlockX = -1;
 	lastBlockY = -1;
 }
 
-void FogOfWar_save_all_to_disk(void)
+void FogOfWar_write_save(SaveWriter *w)
 {
 	/* Sync active grid back to cache first */
-	if (activeZonePath[0]) {
-		FowZoneCache *cur = find_cache(activeZonePath);
-		if (!cur) cur = alloc_cache(activeZonePath);
-		memcpy(cur->data, revealed, sizeof(revealed));
-	}
+	stash_active();
 
-	/* Write all cached zones to disk */
-	for (int i = 0; i < FOW_MAX_ZONES; i++) {
+	int count = 0;
+	for (int i = 0; i < FOW_MAX_ZONES; i++)
 		if (zoneCache[i].in_use)
-			save_zone_to_disk(zoneCache[i].zone_path, zoneCache[i].data);
+			count++;
+	SaveFile_put_u16(w, (uint16_t)count);
+	SaveFile_put_u16(w, FOW_BLOCKS);
+
+	unsigned char payload[FOW_PAYLOAD_MAX];
+	for (int i = 0; i < FOW_MAX_ZONES; i++) {
+		if (!zoneCache[i].in_use)
+			continue;
+		int encoding;
+		int len = encode_zone(zoneCache[i].data, payload, &encoding);
+		SaveFile_put_str(w, zoneCache[i].zone_path);
+		SaveFile_put_u8(w, (uint8_t)encoding);
+		SaveFile_put_u16(w, (uint16_t)len);
+		SaveFile_put_bytes(w, payload, (size_t)len);
 	}
 }
 
-void FogOfWar_load_all_from_disk(void)
+bool FogOfWar_read_save(SaveReader *r)
 {
-	/* Reload all cached zones from disk — discard unsaved in-memory progress */
-	for (int i = 0; i < FOW_MAX_ZONES; i++) {
-		if (zoneCache[i].in_use) {
-			if (!load_zone_from_disk(zoneCache[i].zone_path, zoneCache[i].data))
-				memset(zoneCache[i].data, 0, sizeof(zoneCache[i].data));
+	int count = SaveFile_get_u16(r);
+	if (SaveFile_get_u16(r) != FOW_BLOCKS) {
+		printf("WARNING: FogOfWar: saved fog has a different block layout, ignoring\n");
+		return false;
+	}
+
+	unsigned char payload[FOW_PAYLOAD_MAX];
+	for (int i = 0; i < count && !r->failed; i++) {
+		char path[256];
+		SaveFile_get_str(r, path, sizeof(path));
+		int encoding = SaveFile_get_u8(r);
+		unsigned int len = SaveFile_get_u16(r);
+		if (len > sizeof(payload)) {
+			r->failed = true;
+			break;
+		}
+		SaveFile_get_bytes(r, payload, len);
+
+		FowZoneCache *zc = find_cache(path);
+		if (!zc) zc = alloc_cache(path);
+		if (r->failed || !decode_zone(encoding, payload, len, zc->data)) {
+			printf("WARNING: FogOfWar: unreadable saved fog for %s, resetting\n", path);
+			memset(zc->data, 0, sizeof(zc->data));
 		}
 	}
 
-	/* Reload active zone — from cache if present, otherwise directly from disk */
+	/* Active zone picks up its saved grid */
 	if (activeZonePath[0]) {
 		FowZoneCache *cur = find_cache(activeZonePath);
-		if (cur) {
+		if (cur)
 			memcpy(revealed, cur->data, sizeof(revealed));
-		} else if (!load_zone_from_disk(activeZonePath, revealed)) {
-			memset(revealed, 0, sizeof(revealed));
-		}
 	}
-	fowDirty = true;
+	pendingFull = true;
 	lastBlockX = -1;
 	lastBlockY = -1;
+	return !r->failed;
 }
 
 void FogOfWar_delete_all_saves(void)
@@ -242,49 +408,53 @@ void FogOfWar_update(Position player_pos)
 	int min_by = block_y - radius_blocks;
 	int max_by = block_y + radius_blocks;
 
-	int max_block = MAP_SIZE / FOW_BLOCK_SIZE;
 	if (min_bx < 0) min_bx = 0;
 	if (min_by < 0) min_by = 0;
-	if (max_bx >= max_block) max_bx = max_block - 1;
-	if (max_by >= max_block) max_by = max_block - 1;
+	if (max_bx >= FOW_BLOCKS) max_bx = FOW_BLOCKS - 1;
+	if (max_by >= FOW_BLOCKS) max_by = FOW_BLOCKS - 1;
+	if (min_bx > max_bx || min_by > max_by)
+		return;
 
+	/* One word op per block row */
+	int width = max_bx - min_bx + 1;
+	uint64_t mask = (width >= 64 ? ~(uint64_t)0 : (((uint64_t)1 << width) - 1)) << min_bx;
 	for (int by = min_by; by <= max_by; by++) {
-		for (int bx = min_bx; bx <= max_bx; bx++) {
-			int x0 = bx * FOW_BLOCK_SIZE;
-			int y0 = by * FOW_BLOCK_SIZE;
-
-			if (revealed[x0][y0] && revealed[x0 + FOW_BLOCK_SIZE - 1][y0 + FOW_BLOCK_SIZE - 1])
-				goto next_block;
-
-			for (int y = y0; y < y0 + FOW_BLOCK_SIZE; y++)
-				for (int x = x0; x < x0 + FOW_BLOCK_SIZE; x++)
-					if (!revealed[x][y]) {
-						revealed[x][y] = true;
-						fowDirty = true;
-					}
-			next_block:;
+		uint64_t fresh = mask & ~revealed[by];
+		if (fresh) {
+			revealed[by] |= fresh;
+			pendingBlocks[by] |= fresh;
 		}
 	}
 }
 
 void FogOfWar_reveal_all(void)
 {
-	memset(revealed, 1, sizeof(revealed));
-	fowDirty = true;
+	memset(revealed, 0xFF, sizeof(revealed));
+	pendingFull = true;
 }
 
 bool FogOfWar_is_revealed(int gx, int gy)
 {
 	if (gx < 0 || gx >= MAP_SIZE || gy < 0 || gy >= MAP_SIZE)
 		return false;
-	return revealed[gx][gy];
+	return (revealed[gy / FOW_BLOCK_SIZE] >> (gx / FOW_BLOCK_SIZE)) & 1u;
 }
 
-bool FogOfWar_consume_dirty(void)
+const uint64_t *FogOfWar_get_block_rows(void)
 {
-	if (!fowDirty)
-		return false;
-	fowDirty = false;
-	return true;
+	return revealed;
 }
 
+bool FogOfWar_consume_dirty_blocks(uint64_t out[FOW_BLOCKS], bool *full)
+{
+	*full = pendingFull;
+	bool any = pendingFull;
+	for (int by = 0; by < FOW_BLOCKS; by++) {
+		out[by] = pendingBlocks[by];
+		if (pendingBlocks[by])
+			any = true;
+	}
+	memset(pendingBlocks, 0, sizeof(pendingBlocks));
+	pendingFull = false;
+	return any;
+}
@@ -2,7 +2,14 @@
 #define FOG_OF_WAR_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "entity.h"
+#include "map.h"
+#include "save_file.h"
+
+/* Fog is revealed in whole blocks; one bit per block */
+#define FOW_BLOCK_SIZE 16
+#define FOW_BLOCKS (MAP_SIZE / FOW_BLOCK_SIZE)
 
 void FogOfWar_initialize(void);
 void FogOfWar_cleanup(void);
@@ -14,15 +21,23 @@ bool FogOfWar_is_revealed(int gx, int gy);
 /* Zone transitions — swaps active revealed grid with in-memory buffer */
 void FogOfWar_set_zone(const char *zone_path);
 
-/* Checkpoint save — flush all in-memory buffers (active + cached) to disk */
-void FogOfWar_save_all_to_disk(void);
+/* Checkpoint save — write every zone's grid (active + cached) as the
+   payload of the save container's fog section */
+void FogOfWar_write_save(SaveWriter *w);
 
-/* Death / load-from-save — reload all buffers from disk, discard unsaved progress */
-void FogOfWar_load_all_from_disk(void);
+/* Load-from-save — fill the zone cache from a fog section. Zones missing
+   from it still fall back to their old per-zone file on entry. */
+bool FogOfWar_read_save(SaveReader *r);
 
-/* Delete all per-zone fog save files */
+/* Delete all old per-zone fog save files */
 void FogOfWar_delete_all_saves(void);
 
-bool FogOfWar_consume_dirty(void);
+/* Revealed blocks — FOW_BLOCKS rows, bit bx of row by = block (bx, by) revealed */
+const uint64_t *FogOfWar_get_block_rows(void);
+
+/* Blocks revealed since the last call, same layout as the block rows.
+   Returns false if nothing changed. *full is set when the whole grid was
+   replaced (zone swap, reload, reveal-all) and the caller should rebuild. */
+bool FogOfWar_consume_dirty_blocks(uint64_t out[FOW_BLOCKS], bool *full);
 
 #endif
@@ -5,6 +5,9 @@
 #include "particle_instance.h"
 #include "circuit_atlas.h"
 #include "map_window.h"
+#include "map_minimap.h"
+#include "noise_heatmap.h"
+#include "background.h"
 
 #include <OpenGL/gl3.h>
 
@@ -23,6 +26,8 @@ static bool multisamplingEnabled = true;
 static bool antialiasingEnabled = true;
 static bool bloomEnabled = true;
 static float uiScale = 1.0f;
+/* Cached on resize so per-frame callers never query the window */
+static int drawableW = 0, drawableH = 0;
 #define UI_SCALE_MIN 0.50f
 #define UI_SCALE_MAX 2.50f
 #define BASE_FONT_SIZE 14.0f
@@ -59,6 +64,9 @@ void Graphics_initialize(void)
 
 void Graphics_cleanup(void)
 {
+	Background_cleanup();
+	MapMinimap_cleanup();
+	NoiseHeatmap_cleanup();
 	MapWindow_cleanup();
 	CircuitAtlas_cleanup();
 	ParticleInstance_cleanup();
@@ -82,8 +90,8 @@ void Graphics_resize_window(const unsigned int width,
 	graphics.screen.height = height;
 	compute_normalized_size();
 
-	int draw_w, draw_h;
-	SDL_GL_GetDrawableSize(graphics.window, &draw_w, &draw_h);
+	SDL_GL_GetDrawableSize(graphics.window, &drawableW, &drawableH);
+	int draw_w = drawableW, draw_h = drawableH;
 	glViewport(0, 0, draw_w, draw_h);
 	Bloom_resize(&bloom, draw_w, draw_h);
 	Bloom_resize(&bg_bloom, draw_w, draw_h);
@@ -167,7 +175,8 @@ Bloom *Graphics_get_light_bloom(void)
 
 void Graphics_get_drawable_size(int *w, int *h)
 {
-	SDL_GL_GetDrawableSize(graphics.window, w, h);
+	*w = drawableW;
+	*h = drawableH;
 }
 
 void Graphics_set_multisampling(bool enabled)
@@ -299,8 +308,8 @@ static void initialize_gl(void)
 		glDisable(GL_MULTISAMPLE);
 	glClearColor(0, 0, 0, 1);
 
-	int draw_w, draw_h;
-	SDL_GL_GetDrawableSize(graphics.window, &draw_w, &draw_h);
+	SDL_GL_GetDrawableSize(graphics.window, &drawableW, &drawableH);
+	int draw_w = drawableW, draw_h = drawableH;
 	glViewport(0, 0, draw_w, draw_h);
 
 	Shaders_initialize(&shaders);
@@ -317,6 +326,8 @@ static void initialize_gl(void)
 	MapLighting_initialize();
 	CircuitAtlas_initialize();
 	MapWindow_initialize();
+	MapMinimap_initialize();
+	NoiseHeatmap_initialize();
 }
 
 static void destroy_window(void)
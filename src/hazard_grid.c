@@ -0,0 +1,91 @@
+#include "hazard_grid.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#include "cell_hash.h"
+
+/* Query dedupes buckets with a 64-bit mask */
+#if HAZARD_GRID_BUCKETS > 64
+#error "hazard grid bucket mask assumes at most 64 buckets"
+#endif
+
+void HazardGrid_init(HazardGrid *grid, double cell_size)
+{
+	grid->cellSize = cell_size;
+	for (int i = 0; i < HAZARD_GRID_CAPACITY; i++)
+		grid->bucket[i] = -1;
+	for (int b = 0; b < HAZARD_GRID_BUCKETS; b++)
+		grid->head[b] = -1;
+	grid->count = 0;
+}
+
+void HazardGrid_clear(HazardGrid *grid)
+{
+	HazardGrid_init(grid, grid->cellSize);
+}
+
+void HazardGrid_insert(HazardGrid *grid, int item, Position center)
+{
+	if (item < 0 || item >= HAZARD_GRID_CAPACITY) {
+		printf("WARNING: hazard grid item %d out of range\n", item);
+		return;
+	}
+	if (grid->bucket[item] >= 0)
+		HazardGrid_remove(grid, item);
+
+	int b = CellHash_bucket(CellHash_coord(center.x, grid->cellSize),
+		CellHash_coord(center.y, grid->cellSize), HAZARD_GRID_BUCKETS);
+	grid->bucket[item] = b;
+	grid->next[item] = grid->head[b];
+	grid->head[b] = item;
+	grid->count++;
+}
+
+void HazardGrid_remove(HazardGrid *grid, int item)
+{
+	if (item < 0 || item >= HAZARD_GRID_CAPACITY || grid->bucket[item] < 0)
+		return;
+
+	int *link = &grid->head[grid->bucket[item]];
+	while (*link != item)
+		link = &grid->next[*link];
+	*link = grid->next[item];
+	grid->bucket[item] = -1;
+	grid->count--;
+}
+
+int HazardGrid_query(const HazardGrid *grid, Rectangle box, double reach,
+	int *out, int max)
+{
+	if (grid->count == 0)
+		return 0;
+
+	double minX = fmin(box.aX, box.bX) - reach, maxX = fmax(box.aX, box.bX) + reach;
+	double minY = fmin(box.aY, box.bY) - reach, maxY = fmax(box.aY, box.bY) + reach;
+	int cx0 = CellHash_coord(minX, grid->cellSize), cx1 = CellHash_coord(maxX, grid->cellSize);
+	int cy0 = CellHash_coord(minY, grid->cellSize), cy1 = CellHash_coord(maxY, grid->cellSize);
+
+	int n = 0;
+	if ((double)(cx1 - cx0 + 1) * (double)(cy1 - cy0 + 1) >= HAZARD_GRID_BUCKETS) {
+		/* Box covers more cells than there are buckets: take everything */
+		for (int b = 0; b < HAZARD_GRID_BUCKETS; b++)
+			for (int item = grid->head[b]; item >= 0 && n < max; item = grid->next[item])
+				out[n++] = item;
+		return n;
+	}
+
+	/* Several cells can hash to one bucket; visit each bucket once */
+	unsigned long long seen = 0;
+	for (int cx = cx0; cx <= cx1; cx++) {
+		for (int cy = cy0; cy <= cy1; cy++) {
+			int b = CellHash_bucket(cx, cy, HAZARD_GRID_BUCKETS);
+			if (seen & (1ull << b))
+				continue;
+			seen |= 1ull << b;
+			for (int item = grid->head[b]; item >= 0 && n < max; item = grid->next[item])
+				out[n++] = item;
+		}
+	}
+	return n;
+}
@@ -0,0 +1,37 @@
+#ifndef HAZARD_GRID_H
+#define HAZARD_GRID_H
+
+#include "position.h"
+#include "collision.h"
+
+/*
+ * Spatial index over a pool of stationary hazards (corridor segments,
+ * footprints). Items are pool indices bucketed by the grid cell of their
+ * center; cells hash into a fixed bucket table. Owners insert on spawn and
+ * remove on expiry, and burn checks ask for the items near a hitbox
+ * instead of scanning the whole pool for every enemy and for the player.
+ */
+#define HAZARD_GRID_CAPACITY 256
+#define HAZARD_GRID_BUCKETS 64
+
+typedef struct {
+	double cellSize;
+	int count;
+	int head[HAZARD_GRID_BUCKETS];
+	int next[HAZARD_GRID_CAPACITY];
+	int bucket[HAZARD_GRID_CAPACITY];	/* -1 = not indexed */
+} HazardGrid;
+
+/* cell_size should be a few hazard radii */
+void HazardGrid_init(HazardGrid *grid, double cell_size);
+void HazardGrid_clear(HazardGrid *grid);
+void HazardGrid_insert(HazardGrid *grid, int item, Position center);
+void HazardGrid_remove(HazardGrid *grid, int item);
+
+/* Items whose center may lie within `reach` of box (hash neighbours
+   included), so callers still run their exact overlap test. Returns the
+   number written to out. */
+int HazardGrid_query(const HazardGrid *grid, Rectangle box, double reach,
+	int *out, int max);
+
+#endif
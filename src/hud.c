@@ -4,6 +4,7 @@
 #include "graphics.h"
 #include "mat4.h"
 #include "map.h"
+#include "map_minimap.h"
 #include "ship.h"
 #include "skillbar.h"
 #include "portal.h"
@@ -55,7 +56,7 @@ static void render_radar(const Screen *screen)
 
 	/* Map cells — same RADAR_RANGE so same terrain coverage at any scale */
 	Position ship_pos = Ship_get_position();
-	Map_render_minimap((float)ship_pos.x, (float)ship_pos.y,
+	MapMinimap_render((float)ship_pos.x, (float)ship_pos.y,
 		rx, ry, radar_size, RADAR_RANGE);
 
 	/* Portal blips */
@@ -21,6 +21,7 @@
 #include "global_render.h"
 #include "global_update.h"
 #include "spatial_grid.h"
+#include "timer_wheel.h"
 
 #include <math.h>
 #include <stdlib.h>
@@ -97,7 +98,6 @@ typedef struct {
 
 	/* Death/respawn */
 	int deathTimer;
-	int respawnTimer;
 
 	/* Feedback */
 	EnemyFeedback fb;
@@ -136,7 +136,8 @@ static const ColorFloat colorAggro    = {1.0f, 0.5f, 0.1f, 1.0f};
 /* State arrays */
 static HunterState hunters[HUNTER_COUNT];
 static PlaceableComponent placeables[HUNTER_COUNT];
-static Entity *entityRefs[HUNTER_COUNT];
+static EntityHandle entityRefs[HUNTER_COUNT];
+static TimerHandle respawnEvents[HUNTER_COUNT];
 static int highestUsedIndex = 0;
 
 /* Projectile pool (shared across all hunters) */
@@ -151,7 +152,7 @@ static const SubProjectileConfig hunterProjCfg = {
 	.fire_cooldown_ms = 0,
 	.velocity = 2000.0,
 	.ttl_ms = 800,
-	.pool_size = 256,
+	.pool_size = 16384,
 	.damage = 15.0,
 	.color_r = 1.0f, .color_g = 0.35f, .color_b = 0.05f,
 	.trail_thickness = 3.0f,
@@ -208,6 +209,40 @@ static void pick_wander_target(HunterState *h)
 		&h->wanderTarget, &h->wanderTimer);
 }
 
+static void respawn(int idx)
+{
+	HunterState *h = &hunters[idx];
+	PlaceableComponent *pl = &placeables[idx];
+	bool dormant = !SpatialGrid_is_active(pl->position.x, pl->position.y);
+
+	h->alive = true;
+	h->hp = HUNTER_HP;
+	h->aiState = HUNTER_IDLE;
+	h->killedByPlayer = false;
+	h->cooldownTimer = 0;
+	h->burstShotsFired = 0;
+	EnemyFeedback_reset(&h->fb);
+	Burn_reset(&h->burn);
+	Position oldPos = pl->position;
+	pl->position = h->spawnPoint;
+	pick_wander_target(h);
+	/* NO respawn sound while dormant */
+	if (!dormant)
+		Audio_play_sample_at(&sampleRespawn, pl->position);
+	SpatialGrid_update((EntityRef){ENTITY_HUNTER, idx},
+		oldPos.x, oldPos.y, pl->position.x, pl->position.y);
+	Entity_set_ai_suspended(entityRefs[idx], false);
+}
+
+/* The dead leave the AI walk until their respawn event fires; if the
+   wheel is full they stay in it and retry from the DEAD state */
+static void schedule_respawn(int idx)
+{
+	respawnEvents[idx] = TimerWheel_schedule(RESPAWN_MS, respawn, idx);
+	if (TimerWheel_is_pending(respawnEvents[idx]))
+		Entity_set_ai_suspended(entityRefs[idx], true);
+}
+
 /* ---- Public API ---- */
 
 void Hunter_initialize(Position position, ZoneTheme theme)
@@ -231,7 +266,6 @@ void Hunter_initialize(Position position, ZoneTheme theme)
 	h->burstTimer = 0;
 	h->cooldownTimer = 0;
 	h->deathTimer = 0;
-	h->respawnTimer = 0;
 	h->theme = theme;
 	h->weaponType = HUNTER_WPN_BASE;
 	if (theme == THEME_FIRE) {
@@ -250,7 +284,7 @@ void Hunter_initialize(Position position, ZoneTheme theme)
 	entity.collidable = &collidable;
 	entity.aiUpdatable = &updatable;
 
-	entityRefs[idx] = Entity_add_entity(entity);
+	entityRefs[idx] = Entity_create(entity);
 
 	highestUsedIndex++;
 
@@ -278,8 +312,8 @@ void Hunter_initialize(Position position, ZoneTheme theme)
 
 	/* Init fire pools once when first fire hunter spawns */
 	if (theme == THEME_FIRE && !firePoolsInitialized) {
-		SubProjectile_pool_init(&fireEmberPool, 64);
-		SubProjectile_pool_init(&fireFlakPool, 48);
+		SubProjectile_pool_init(&fireEmberPool, 2048);
+		SubProjectile_pool_init(&fireFlakPool, 4096);
 		SubEmber_initialize_audio();
 		SubFlak_initialize_audio();
 		firePoolsInitialized = true;
@@ -289,10 +323,9 @@ void Hunter_initialize(Position position, ZoneTheme theme)
 void Hunter_cleanup(void)
 {
 	for (int i = 0; i < highestUsedIndex; i++) {
-		if (entityRefs[i]) {
-			entityRefs[i]->empty = true;
-			entityRefs[i] = NULL;
-		}
+		TimerWheel_cancel(respawnEvents[i]);
+		Entity_release(entityRefs[i]);
+		entityRefs[i] = (EntityHandle){0, 0};
 	}
 	highestUsedIndex = 0;
 
@@ -396,28 +429,10 @@ void Hunter_update(void *state, const PlaceableComponent *placeable, unsigned in
 	PlaceableComponent *pl = &placeables[idx];
 	double dt = ticks / 1000.0;
 
-	/* Dormancy check — only tick respawn timer if dormant */
+	/* Dormancy check — nothing to do while dormant */
 	if (!SpatialGrid_is_active(pl->position.x, pl->position.y)) {
-		if (h->aiState == HUNTER_DEAD) {
-			h->respawnTimer += ticks;
-			if (h->respawnTimer >= RESPAWN_MS) {
-				h->alive = true;
-				h->hp = HUNTER_HP;
-				h->aiState = HUNTER_IDLE;
-				h->killedByPlayer = false;
-				h->cooldownTimer = 0;
-				h->burstShotsFired = 0;
-				EnemyFeedback_reset(&h->fb);
-				Burn_reset(&h->burn);
-				Position oldPos = pl->position;
-				pl->position = h->spawnPoint;
-				pick_wander_target(h);
-				/* NO respawn sound while dormant */
-				SpatialGrid_update((EntityRef){ENTITY_HUNTER, idx},
-					oldPos.x, oldPos.y,
-					h->spawnPoint.x, h->spawnPoint.y);
-			}
-		}
+		if (h->aiState == HUNTER_DEAD && !TimerWheel_is_pending(respawnEvents[idx]))
+			schedule_respawn(idx);
 		return;
 	}
 
@@ -588,7 +603,7 @@ void Hunter_update(void *state, const PlaceableComponent *placeable, unsigned in
 		h->deathTimer += ticks;
 		if (h->deathTimer >= DEATH_FLASH_MS) {
 			h->aiState = HUNTER_DEAD;
-			h->respawnTimer = 0;
+			schedule_respawn(idx);
 
 			/* Drop fragment */
 			if (h->killedByPlayer) {
@@ -601,21 +616,9 @@ void Hunter_update(void *state, const PlaceableComponent *placeable, unsigned in
 		break;
 
 	case HUNTER_DEAD:
-		h->respawnTimer += ticks;
-		if (h->respawnTimer >= RESPAWN_MS) {
-			/* Respawn at original position */
-			h->alive = true;
-			h->hp = HUNTER_HP;
-			h->aiState = HUNTER_IDLE;
-			h->killedByPlayer = false;
-			h->cooldownTimer = 0;
-			h->burstShotsFired = 0;
-			EnemyFeedback_reset(&h->fb);
-			Burn_reset(&h->burn);
-			pl->position = h->spawnPoint;
-			pick_wander_target(h);
-			Audio_play_sample_at(&sampleRespawn, pl->position);
-		}
+		/* Respawn is a timer event; only reached if scheduling failed */
+		if (!TimerWheel_is_pending(respawnEvents[idx]))
+			schedule_respawn(idx);
 		break;
 	}
 
@@ -781,7 +784,8 @@ void Hunter_reset_all(void)
 		h->burstShotsFired = 0;
 		h->burstTimer = 0;
 		h->deathTimer = 0;
-		h->respawnTimer = 0;
+		TimerWheel_cancel(respawnEvents[i]);
+		Entity_set_ai_suspended(entityRefs[i], false);
 		EnemyFeedback_reset(&h->fb);
 		placeables[i].position = h->spawnPoint;
 		pick_wander_target(h);
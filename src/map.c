@@ -1,6 +1,8 @@
 #include "map.h"
 
 #include <string.h>
+#include <math.h>
+#include <SDL2/SDL.h>
 #include "view.h"
 #include "render.h"
 #include "color.h"
@@ -13,11 +15,39 @@ static MapCell boundaryCell = {true, false, {0,0,0,0}, {0,0,0,0}};
 
 static bool circuitTracesEnabled = true;
 
+/* Ring log of cell edits so cached views of the map (map window, minimap)
+   can patch what changed instead of rebuilding. Map_clear starts a new epoch. */
+#define EDIT_LOG_SIZE 1024
+static int editLogX[EDIT_LOG_SIZE];
+static int editLogY[EDIT_LOG_SIZE];
+static unsigned int editSeq = 0;
+static unsigned int editResetSeq = 0;
+
+static void log_edit(int x, int y)
+{
+	editLogX[editSeq % EDIT_LOG_SIZE] = x;
+	editLogY[editSeq % EDIT_LOG_SIZE] = y;
+	editSeq++;
+}
+
 /* Pool of dynamically-set cells for zone loader */
 #define CELL_POOL_SIZE (MAP_SIZE * MAP_SIZE)
 static MapCell cellPool[CELL_POOL_SIZE];
 static int cellPoolCount = 0;
 
+/* Per-cell neighbour masks (MAP_ADJ_* bits): solid = neighbour not empty,
+   match = neighbour not empty and visually identical. Only non-empty cells
+   carry masks. Bulk loads (Map_clear, boundary changes) mark them stale and
+   the next reader rebuilds; single-cell edits patch the 3x3 block. */
+static uint8_t solidMask[MAP_SIZE][MAP_SIZE];
+static uint8_t matchMask[MAP_SIZE][MAP_SIZE];
+static bool adjacencyStale = true;
+
+static MapQueryStats queryStats;
+
+static const int adjDX[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+static const int adjDY[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+
 static PlaceableComponent placeable = {{0.0, 0.0}, 0.0};
 static CollidableComponent collidable = {{0.0, 0.0, 0.0, 0.0}, false,
 	COLLISION_LAYER_TERRAIN, 0,
@@ -26,6 +56,7 @@ static CollidableComponent collidable = {{0.0, 0.0, 0.0, 0.0}, false,
 static void initialize_map_entity(void);
 static void render_cell(int x, int y, float outlineThickness);
 static int correctTruncation(double v);
+static bool cells_match_visual(const MapCell *a, const MapCell *b);
 
 static inline const MapCell* get_cell_fast(int x, int y) {
 	if (x < 0 || x >= MAP_SIZE || y < 0 || y >= MAP_SIZE)
@@ -33,6 +64,44 @@ static inline const MapCell* get_cell_fast(int x, int y) {
 	return map[x][y];
 }
 
+static void compute_adjacency(int x, int y)
+{
+	const MapCell *me = map[x][y];
+	uint8_t solid = 0, match = 0;
+	if (!me->empty) {
+		for (int i = 0; i < 8; i++) {
+			const MapCell *nb = get_cell_fast(x + adjDX[i], y + adjDY[i]);
+			if (nb->empty)
+				continue;
+			solid |= (uint8_t)(1u << i);
+			if (nb == me || cells_match_visual(nb, me))
+				match |= (uint8_t)(1u << i);
+		}
+	}
+	solidMask[x][y] = solid;
+	matchMask[x][y] = match;
+}
+
+static void patch_adjacency(int x, int y)
+{
+	if (adjacencyStale)
+		return;
+	for (int i = x - 1; i <= x + 1; i++) {
+		if (i < 0 || i >= MAP_SIZE)
+			continue;
+		for (int j = y - 1; j <= y + 1; j++) {
+			if (j >= 0 && j < MAP_SIZE)
+				compute_adjacency(i, j);
+		}
+	}
+}
+
+static inline void ensure_adjacency(void)
+{
+	if (adjacencyStale)
+		Map_rebuild_adjacency();
+}
+
 void Map_initialize(void)
 {
 	initialize_map_entity();
@@ -47,17 +116,22 @@ void Map_clear(void)
 		for (int j = 0; j < MAP_SIZE; j++)
 			map[i][j] = &emptyCell;
 	cellPoolCount = 0;
+	adjacencyStale = true;
+	editSeq++;
+	editResetSeq = editSeq;
 }
 
 void Map_set_cell(int grid_x, int grid_y, const MapCell *cell)
 {
 	if (grid_x < 0 || grid_x >= MAP_SIZE || grid_y < 0 || grid_y >= MAP_SIZE)
 		return;
+	log_edit(grid_x, grid_y);
 
 	/* Check if this coordinate already has a pool cell — overwrite in place */
 	MapCell *existing = map[grid_x][grid_y];
 	if (existing >= cellPool && existing < cellPool + CELL_POOL_SIZE) {
 		*existing = *cell;
+		patch_adjacency(grid_x, grid_y);
 		return;
 	}
 
@@ -66,6 +140,7 @@ void Map_set_cell(int grid_x, int grid_y, const MapCell *cell)
 	cellPool[cellPoolCount] = *cell;
 	map[grid_x][grid_y] = &cellPool[cellPoolCount];
 	cellPoolCount++;
+	patch_adjacency(grid_x, grid_y);
 }
 
 void Map_clear_cell(int grid_x, int grid_y)
@@ -73,6 +148,122 @@ void Map_clear_cell(int grid_x, int grid_y)
 	if (grid_x < 0 || grid_x >= MAP_SIZE || grid_y < 0 || grid_y >= MAP_SIZE)
 		return;
 	map[grid_x][grid_y] = &emptyCell;
+	log_edit(grid_x, grid_y);
+	patch_adjacency(grid_x, grid_y);
+}
+
+void Map_rebuild_adjacency(void)
+{
+	for (int x = 0; x < MAP_SIZE; x++)
+		for (int y = 0; y < MAP_SIZE; y++)
+			compute_adjacency(x, y);
+	adjacencyStale = false;
+}
+
+uint8_t Map_get_solid_neighbours(int grid_x, int grid_y)
+{
+	if (grid_x < 0 || grid_x >= MAP_SIZE || grid_y < 0 || grid_y >= MAP_SIZE)
+		return 0;
+	ensure_adjacency();
+	return solidMask[grid_x][grid_y];
+}
+
+uint8_t Map_get_matching_neighbours(int grid_x, int grid_y)
+{
+	if (grid_x < 0 || grid_x >= MAP_SIZE || grid_y < 0 || grid_y >= MAP_SIZE)
+		return 0;
+	ensure_adjacency();
+	return matchMask[grid_x][grid_y];
+}
+
+/* Bulk load: the map is split into column bands (contiguous in memory).
+   Each band counts its cells, a prefix sum gives it a private slice of the
+   cell pool, then each band fills its slice. Pool order matches what a
+   serial Map_set_cell sweep in x-major order would produce. */
+#define LOAD_MAX_BANDS 8
+
+typedef struct {
+	const int (*grid)[MAP_SIZE];
+	const MapCell *types;
+	int typeCount;
+	int x0, x1;
+	int count;
+	int poolStart;
+} LoadBand;
+
+static int count_band(void *data)
+{
+	LoadBand *b = data;
+	int n = 0;
+	for (int x = b->x0; x < b->x1; x++)
+		for (int y = 0; y < MAP_SIZE; y++) {
+			int idx = b->grid[x][y];
+			if (idx >= 0 && idx < b->typeCount)
+				n++;
+		}
+	b->count = n;
+	return 0;
+}
+
+static int fill_band(void *data)
+{
+	LoadBand *b = data;
+	MapCell *next = &cellPool[b->poolStart];
+	for (int x = b->x0; x < b->x1; x++)
+		for (int y = 0; y < MAP_SIZE; y++) {
+			int idx = b->grid[x][y];
+			if (idx >= 0 && idx < b->typeCount) {
+				*next = b->types[idx];
+				map[x][y] = next++;
+			} else {
+				map[x][y] = &emptyCell;
+			}
+		}
+	return 0;
+}
+
+/* Run fn over every band: bands 1..n-1 on their own threads, band 0 here */
+static void run_bands(SDL_ThreadFunction fn, LoadBand *bands, int n)
+{
+	SDL_Thread *threads[LOAD_MAX_BANDS] = {NULL};
+	for (int i = 1; i < n; i++)
+		threads[i] = SDL_CreateThread(fn, "map_load", &bands[i]);
+	fn(&bands[0]);
+	for (int i = 1; i < n; i++) {
+		if (threads[i])
+			SDL_WaitThread(threads[i], NULL);
+		else
+			fn(&bands[i]);
+	}
+}
+
+void Map_load_cells(const int (*grid)[MAP_SIZE], const MapCell *types, int type_count)
+{
+	int n = SDL_GetCPUCount();
+	if (n < 1) n = 1;
+	if (n > LOAD_MAX_BANDS) n = LOAD_MAX_BANDS;
+
+	LoadBand bands[LOAD_MAX_BANDS];
+	for (int i = 0; i < n; i++) {
+		bands[i].grid = grid;
+		bands[i].types = types;
+		bands[i].typeCount = type_count;
+		bands[i].x0 = MAP_SIZE * i / n;
+		bands[i].x1 = MAP_SIZE * (i + 1) / n;
+	}
+
+	run_bands(count_band, bands, n);
+	int total = 0;
+	for (int i = 0; i < n; i++) {
+		bands[i].poolStart = total;
+		total += bands[i].count;
+	}
+	run_bands(fill_band, bands, n);
+
+	cellPoolCount = total;
+	adjacencyStale = true;
+	editSeq++;
+	editResetSeq = editSeq;
 }
 
 const MapCell *Map_get_cell(int grid_x, int grid_y)
@@ -82,15 +273,34 @@ const MapCell *Map_get_cell(int grid_x, int grid_y)
 	return map[grid_x][grid_y];
 }
 
+unsigned int Map_get_edit_seq(void)
+{
+	return editSeq;
+}
+
+int Map_get_edits_since(unsigned int since, int *xs, int *ys, int max)
+{
+	unsigned int count = editSeq - since;
+	if (count > editSeq - editResetSeq || count > EDIT_LOG_SIZE || count > (unsigned int)max)
+		return -1;
+	for (unsigned int i = 0; i < count; i++) {
+		xs[i] = editLogX[(since + i) % EDIT_LOG_SIZE];
+		ys[i] = editLogY[(since + i) % EDIT_LOG_SIZE];
+	}
+	return (int)count;
+}
+
 void Map_set_boundary_cell(const MapCell *cell)
 {
 	boundaryCell = *cell;
 	boundaryCell.empty = false;
+	adjacencyStale = true;
 }
 
 void Map_clear_boundary_cell(void)
 {
 	boundaryCell = (MapCell){true, false, {0,0,0,0}, {0,0,0,0}};
+	adjacencyStale = true;
 }
 
 static void initialize_map_entity(void)
@@ -144,6 +354,8 @@ static int correctTruncation(double v)
 bool Map_line_test_hit(double x0, double y0, double x1, double y1,
 					   double *hit_x, double *hit_y)
 {
+	queryStats.lineTests++;
+
 	double minX = x0 < x1 ? x0 : x1;
 	double maxX = x0 > x1 ? x0 : x1;
 	double minY = y0 < y1 ? y0 : y1;
@@ -194,6 +406,99 @@ done:
 	return hit;
 }
 
+bool Map_sweep_aabb(const Rectangle box, double dx, double dy,
+					double *t_out, double *nx_out, double *ny_out)
+{
+	double minX = fmin(box.aX, box.bX), maxX = fmax(box.aX, box.bX);
+	double minY = fmin(box.aY, box.bY), maxY = fmax(box.aY, box.bY);
+
+	/* Broadphase: every cell the box touches along the whole move */
+	int cellMinX = correctTruncation(fmin(minX, minX + dx) / MAP_CELL_SIZE);
+	int cellMaxX = correctTruncation(fmax(maxX, maxX + dx) / MAP_CELL_SIZE);
+	int cellMinY = correctTruncation(fmin(minY, minY + dy) / MAP_CELL_SIZE);
+	int cellMaxY = correctTruncation(fmax(maxY, maxY + dy) / MAP_CELL_SIZE);
+
+	double best_t = 2.0, best_nx = 0.0, best_ny = 0.0;
+
+	for (int cx = cellMinX; cx <= cellMaxX; cx++) {
+		for (int cy = cellMinY; cy <= cellMaxY; cy++) {
+			int mx = cx + HALF_MAP_SIZE;
+			int my = cy + HALF_MAP_SIZE;
+			if (mx < 0 || mx >= MAP_SIZE || my < 0 || my >= MAP_SIZE) {
+				if (boundaryCell.empty)
+					continue;
+			} else if (map[mx][my]->empty) {
+				continue;
+			}
+
+			Rectangle cellRect = {
+				cx * MAP_CELL_SIZE,
+				(cy + 1) * MAP_CELL_SIZE,
+				(cx + 1) * MAP_CELL_SIZE,
+				cy * MAP_CELL_SIZE
+			};
+			double t, nx, ny;
+			if (!Collision_sweep_aabb(box, dx, dy, cellRect, &t, &nx, &ny))
+				continue;
+			/* Already embedded: leave that to Map_collide so the body
+			   can still move out */
+			if (nx == 0.0 && ny == 0.0)
+				continue;
+			if (t < best_t) {
+				best_t = t;
+				best_nx = nx;
+				best_ny = ny;
+			}
+		}
+	}
+
+	if (best_t > 1.0)
+		return false;
+	if (t_out) *t_out = best_t;
+	if (nx_out) *nx_out = best_nx;
+	if (ny_out) *ny_out = best_ny;
+	return true;
+}
+
+int Map_line_test_hit_batch(int n, const double *x0, const double *y0,
+	const double *x1, const double *y1, bool *hit, double *hit_x, double *hit_y)
+{
+	int hits = 0;
+	queryStats.batchSegments += (unsigned long)n;
+	for (int i = 0; i < n; i++) {
+		/* Most bullets stay inside one open cell per tick: one lookup */
+		int cx = correctTruncation(x0[i] / MAP_CELL_SIZE);
+		int cy = correctTruncation(y0[i] / MAP_CELL_SIZE);
+		if (cx == correctTruncation(x1[i] / MAP_CELL_SIZE)
+				&& cy == correctTruncation(y1[i] / MAP_CELL_SIZE)) {
+			int mx = cx + HALF_MAP_SIZE;
+			int my = cy + HALF_MAP_SIZE;
+			bool empty = (mx < 0 || mx >= MAP_SIZE || my < 0 || my >= MAP_SIZE)
+				? boundaryCell.empty : map[mx][my]->empty;
+			if (empty) {
+				hit[i] = false;
+				continue;
+			}
+		}
+
+		hit[i] = Map_line_test_hit(x0[i], y0[i], x1[i], y1[i],
+			&hit_x[i], &hit_y[i]);
+		if (hit[i])
+			hits++;
+	}
+	return hits;
+}
+
+const MapQueryStats *Map_get_query_stats(void)
+{
+	return &queryStats;
+}
+
+void Map_reset_query_stats(void)
+{
+	memset(&queryStats, 0, sizeof(queryStats));
+}
+
 static bool cells_match_visual(const MapCell *a, const MapCell *b)
 {
 	return a->circuitPattern == b->circuitPattern &&
@@ -371,6 +676,7 @@ void Map_render(const void *state, const PlaceableComponent *placeable)
 	if (maxX >= MAP_SIZE) maxX = MAP_SIZE - 1;
 	if (maxY >= MAP_SIZE) maxY = MAP_SIZE - 1;
 
+	ensure_adjacency();
 	for (int x = minX; x <= maxX; x++)
 		for (int y = minY; y <= maxY; y++)
 			render_cell(x, y, outlineThickness);
@@ -383,100 +689,6 @@ void Map_render_bloom_source(void)
 	bloomSourceMode = false;
 }
 
-void Map_render_minimap(float center_x, float center_y,
-	float screen_x, float screen_y, float size, float range)
-{
-	float half_range = range * 0.5f;
-	float scale = size / range;
-
-	/* World bounds visible on minimap */
-	float world_min_x = center_x - half_range;
-	float world_max_x = center_x + half_range;
-	float world_min_y = center_y - half_range;
-	float world_max_y = center_y + half_range;
-
-	/* Convert to map indices */
-	int cell_min_x = correctTruncation(world_min_x / MAP_CELL_SIZE) + HALF_MAP_SIZE;
-	int cell_max_x = correctTruncation(world_max_x / MAP_CELL_SIZE) + HALF_MAP_SIZE;
-	int cell_min_y = correctTruncation(world_min_y / MAP_CELL_SIZE) + HALF_MAP_SIZE;
-	int cell_max_y = correctTruncation(world_max_y / MAP_CELL_SIZE) + HALF_MAP_SIZE;
-
-	/* Render boundary (out-of-bounds) fill on minimap */
-	if (!boundaryCell.empty) {
-		float map_left   = (float)(-HALF_MAP_SIZE) * MAP_CELL_SIZE;
-		float map_right  = (float)(MAP_SIZE - HALF_MAP_SIZE) * MAP_CELL_SIZE;
-		float map_bottom = map_left;
-		float map_top    = map_right;
-
-		/* Map edges in minimap screen coords */
-		float ml_sx = screen_x + (map_left - world_min_x) * scale;
-		float mr_sx = screen_x + (map_right - world_min_x) * scale;
-		float mt_sy = screen_y + size - (map_top - world_min_y) * scale;
-		float mb_sy = screen_y + size - (map_bottom - world_min_y) * scale;
-
-		/* Minimap bounds */
-		float mm_l = screen_x, mm_r = screen_x + size;
-		float mm_t = screen_y, mm_b = screen_y + size;
-
-		/* Clamp map edges to minimap */
-		if (ml_sx < mm_l) ml_sx = mm_l;
-		if (mr_sx > mm_r) mr_sx = mm_r;
-		if (mt_sy < mm_t) mt_sy = mm_t;
-		if (mb_sy > mm_b) mb_sy = mm_b;
-
-		ColorFloat bc = Color_rgb_to_float(&boundaryCell.primaryColor);
-		float maxC = fmaxf(fmaxf(bc.red, bc.green), bc.blue);
-		float s = (maxC > 0.001f) ? fminf(10.0f, 1.0f / maxC) : 1.0f;
-		float br = bc.red * s, bg = bc.green * s, bb = bc.blue * s;
-
-		/* Top strip (above map) */
-		if (mt_sy > mm_t)
-			Render_quad_absolute(mm_l, mm_t, mm_r, mt_sy, br, bg, bb, 1.0f);
-		/* Bottom strip (below map) */
-		if (mb_sy < mm_b)
-			Render_quad_absolute(mm_l, mb_sy, mm_r, mm_b, br, bg, bb, 1.0f);
-		/* Left strip */
-		if (ml_sx > mm_l)
-			Render_quad_absolute(mm_l, mt_sy, ml_sx, mb_sy, br, bg, bb, 1.0f);
-		/* Right strip */
-		if (mr_sx < mm_r)
-			Render_quad_absolute(mr_sx, mt_sy, mm_r, mb_sy, br, bg, bb, 1.0f);
-	}
-
-	if (cell_min_x < 0) cell_min_x = 0;
-	if (cell_min_y < 0) cell_min_y = 0;
-	if (cell_max_x >= MAP_SIZE) cell_max_x = MAP_SIZE - 1;
-	if (cell_max_y >= MAP_SIZE) cell_max_y = MAP_SIZE - 1;
-
-	for (int x = cell_min_x; x <= cell_max_x; x++) {
-		for (int y = cell_min_y; y <= cell_max_y; y++) {
-			if (map[x][y]->empty)
-				continue;
-
-			/* World position of cell center */
-			float wx = (float)(x - HALF_MAP_SIZE) * MAP_CELL_SIZE + MAP_CELL_SIZE * 0.5f;
-			float wy = (float)(y - HALF_MAP_SIZE) * MAP_CELL_SIZE + MAP_CELL_SIZE * 0.5f;
-
-			/* Screen position on minimap (UI coords: y-down) */
-			float sx = screen_x + (wx - world_min_x) * scale;
-			float sy = screen_y + size - (wy - world_min_y) * scale;
-
-			float cell_px = MAP_CELL_SIZE * scale;
-			float half_px = cell_px * 0.5f;
-
-			ColorFloat c = Color_rgb_to_float(&map[x][y]->primaryColor);
-			/* Brighten for minimap visibility — hue-preserving */
-			float maxC = fmaxf(fmaxf(c.red, c.green), c.blue);
-			float s = (maxC > 0.001f) ? fminf(10.0f, 1.0f / maxC) : 1.0f;
-			float br = c.red * s, bg = c.green * s, bb = c.blue * s;
-			Render_quad_absolute(
-				sx - half_px, sy - half_px,
-				sx + half_px, sy + half_px,
-				br, bg, bb, 1.0f);
-		}
-	}
-}
-
 /* --- Circuit board pattern generation --- */
 
 static unsigned int circuit_rand(unsigned int *state)
@@ -788,15 +1000,13 @@ static void render_cell(int x, int y, float outlineThickness)
 	float bx = ax + MAP_CELL_SIZE;
 	float by = ay + MAP_CELL_SIZE;
 
-	const MapCell *nPtr = get_cell_fast(x, y + 1);
-	const MapCell *ePtr = get_cell_fast(x + 1, y);
-	const MapCell *sPtr = get_cell_fast(x, y - 1);
-	const MapCell *wPtr = get_cell_fast(x - 1, y);
+	uint8_t solid = solidMask[x][y];
+	uint8_t match = matchMask[x][y];
 
 	/* Chamfer NE and SW corners of circuit cells when both edges face empty */
 	float chamf = MAP_CELL_SIZE * 0.17f;
-	int chamfer_ne = mapCell.circuitPattern && nPtr->empty && ePtr->empty;
-	int chamfer_sw = mapCell.circuitPattern && sPtr->empty && wPtr->empty;
+	int chamfer_ne = mapCell.circuitPattern && !(solid & (MAP_ADJ_N | MAP_ADJ_E));
+	int chamfer_sw = mapCell.circuitPattern && !(solid & (MAP_ADJ_S | MAP_ADJ_W));
 
 	/* Cell fill */
 	ColorFloat primaryColor = Color_rgb_to_float(&mapCell.primaryColor);
@@ -849,24 +1059,19 @@ static void render_cell(int x, int y, float outlineThickness)
 	   Circuit cells skip borders on edges touching solid cells
 	   (the solid cell draws its own border on that edge instead). */
 
-#define CELLS_MATCH(a, b) \
-	((a)->circuitPattern == (b)->circuitPattern && \
-	 memcmp(&(a)->primaryColor, &(b)->primaryColor, sizeof(ColorRGB)) == 0 && \
-	 memcmp(&(a)->outlineColor, &(b)->outlineColor, sizeof(ColorRGB)) == 0)
-
-#define EDGE_DRAW(ptr, QAX, QAY, QBX, QBY) \
-	if ((ptr)->empty) { \
+#define EDGE_DRAW(BIT, NX, NY, QAX, QAY, QBX, QBY) \
+	if (!(solid & (BIT))) { \
 		Render_quad_absolute(QAX, QAY, QBX, QBY, or_, og, ob, oa); \
-	} else if (!CELLS_MATCH(ptr, me)) { \
-		if (!mapCell.circuitPattern || (ptr)->circuitPattern) { \
+	} else if (!(match & (BIT))) { \
+		if (!mapCell.circuitPattern || get_cell_fast(NX, NY)->circuitPattern) { \
 			Render_quad_absolute(QAX, QAY, QBX, QBY, or_, og, ob, oa); \
 		} \
 	}
 
-	EDGE_DRAW(nPtr, ax, by - t, n_bx, by)
-	EDGE_DRAW(ePtr, bx - t, ay, bx, e_by)
-	EDGE_DRAW(sPtr, s_ax, ay, bx, ay + t)
-	EDGE_DRAW(wPtr, ax, w_ay, ax + t, by)
+	EDGE_DRAW(MAP_ADJ_N, x, y + 1, ax, by - t, n_bx, by)
+	EDGE_DRAW(MAP_ADJ_E, x + 1, y, bx - t, ay, bx, e_by)
+	EDGE_DRAW(MAP_ADJ_S, x, y - 1, s_ax, ay, bx, ay + t)
+	EDGE_DRAW(MAP_ADJ_W, x - 1, y, ax, w_ay, ax + t, by)
 
 	/* Concave corner fills — patch t×t gaps at inner L-corners where
 	   both cardinal neighbors match (suppressing their edge) but the
@@ -874,33 +1079,28 @@ static void render_cell(int x, int y, float outlineThickness)
 	   Circuit cells skip borders against solids, so they only need fills
 	   when the diagonal is truly empty. */
 
-#define CORNER_GAP(diag) \
-	((diag)->empty || (!mapCell.circuitPattern && !CELLS_MATCH((diag), me)))
+#define CORNER_GAP(BIT) \
+	(!(solid & (BIT)) || (!mapCell.circuitPattern && !(match & (BIT))))
 
-	if (!nPtr->empty && CELLS_MATCH(nPtr, me) &&
-		!ePtr->empty && CELLS_MATCH(ePtr, me) &&
-		CORNER_GAP(get_cell_fast(x + 1, y + 1)))
+	if ((match & (MAP_ADJ_N | MAP_ADJ_E)) == (MAP_ADJ_N | MAP_ADJ_E) &&
+		CORNER_GAP(MAP_ADJ_NE))
 		Render_quad_absolute(bx - t, by - t, bx, by, or_, og, ob, oa);
 
-	if (!nPtr->empty && CELLS_MATCH(nPtr, me) &&
-		!wPtr->empty && CELLS_MATCH(wPtr, me) &&
-		CORNER_GAP(get_cell_fast(x - 1, y + 1)))
+	if ((match & (MAP_ADJ_N | MAP_ADJ_W)) == (MAP_ADJ_N | MAP_ADJ_W) &&
+		CORNER_GAP(MAP_ADJ_NW))
 		Render_quad_absolute(ax, by - t, ax + t, by, or_, og, ob, oa);
 
-	if (!sPtr->empty && CELLS_MATCH(sPtr, me) &&
-		!ePtr->empty && CELLS_MATCH(ePtr, me) &&
-		CORNER_GAP(get_cell_fast(x + 1, y - 1)))
+	if ((match & (MAP_ADJ_S | MAP_ADJ_E)) == (MAP_ADJ_S | MAP_ADJ_E) &&
+		CORNER_GAP(MAP_ADJ_SE))
 		Render_quad_absolute(bx - t, ay, bx, ay + t, or_, og, ob, oa);
 
-	if (!sPtr->empty && CELLS_MATCH(sPtr, me) &&
-		!wPtr->empty && CELLS_MATCH(wPtr, me) &&
-		CORNER_GAP(get_cell_fast(x - 1, y - 1)))
+	if ((match & (MAP_ADJ_S | MAP_ADJ_W)) == (MAP_ADJ_S | MAP_ADJ_W) &&
+		CORNER_GAP(MAP_ADJ_SW))
 		Render_quad_absolute(ax, ay, ax + t, ay + t, or_, og, ob, oa);
 
 #undef CORNER_GAP
 
 #undef EDGE_DRAW
-#undef CELLS_MATCH
 
 	/* Chamfer diagonal outlines — quads that join flush with edge outlines */
 	if (chamfer_ne) {
@@ -1009,14 +1209,10 @@ static void render_cell_stencil_circuit(int x, int y)
 	float by = ay + MAP_CELL_SIZE;
 
 	/* Chamfer NE and SW corners when both edges face empty (same as render_cell) */
-	const MapCell *nPtr = get_cell_fast(x, y + 1);
-	const MapCell *ePtr = get_cell_fast(x + 1, y);
-	const MapCell *sPtr = get_cell_fast(x, y - 1);
-	const MapCell *wPtr = get_cell_fast(x - 1, y);
-
+	uint8_t solid = solidMask[x][y];
 	float chamf = MAP_CELL_SIZE * 0.17f;
-	int chamfer_ne = nPtr->empty && ePtr->empty;
-	int chamfer_sw = sPtr->empty && wPtr->empty;
+	int chamfer_ne = !(solid & (MAP_ADJ_N | MAP_ADJ_E));
+	int chamfer_sw = !(solid & (MAP_ADJ_S | MAP_ADJ_W));
 
 	if (chamfer_ne || chamfer_sw) {
 		float vx[6], vy[6];
@@ -1066,6 +1262,7 @@ void Map_render_stencil_mask_all(const Mat4 *proj, const Mat4 *view_mat)
 
 	/* Pass 1: Circuit cells → stencil ref=1 */
 	Render_set_stencil_ref(1);
+	ensure_adjacency();
 	for (int x = minX; x <= maxX; x++)
 		for (int y = minY; y <= maxY; y++)
 			render_cell_stencil_circuit(x, y);
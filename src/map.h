@@ -2,6 +2,7 @@
 #define MAP_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "color.h"
 #include "collision.h"
 #include "entity.h"
@@ -23,20 +24,59 @@ void Map_initialize(void);
 void Map_clear(void);
 void Map_set_cell(int grid_x, int grid_y, const MapCell *cell);
 void Map_clear_cell(int grid_x, int grid_y);
+/* Replace the whole map from a grid of indices into types (out-of-range =
+   empty), populated in parallel column bands */
+void Map_load_cells(const int (*grid)[MAP_SIZE], const MapCell *types, int type_count);
 const MapCell *Map_get_cell(int grid_x, int grid_y);
+/* Neighbour masks for a non-empty cell, one MAP_ADJ_* bit per direction
+   (off-map neighbours are the boundary cell). Solid: neighbour not empty.
+   Matching: neighbour not empty and drawn with the same type and colors. */
+#define MAP_ADJ_N  0x01
+#define MAP_ADJ_NE 0x02
+#define MAP_ADJ_E  0x04
+#define MAP_ADJ_SE 0x08
+#define MAP_ADJ_S  0x10
+#define MAP_ADJ_SW 0x20
+#define MAP_ADJ_W  0x40
+#define MAP_ADJ_NW 0x80
+uint8_t Map_get_solid_neighbours(int grid_x, int grid_y);
+uint8_t Map_get_matching_neighbours(int grid_x, int grid_y);
+/* Recompute every mask; done lazily after Map_clear, callable up front
+   once a zone has finished loading */
+void Map_rebuild_adjacency(void);
+/* Cell edit feed: cells changed after seq `since`, or -1 if the log no longer
+   reaches back that far (or the map was cleared) and the caller must rebuild */
+unsigned int Map_get_edit_seq(void);
+int Map_get_edits_since(unsigned int since, int *xs, int *ys, int max);
 void Map_set_boundary_cell(const MapCell *cell);
 void Map_clear_boundary_cell(void);
 Collision Map_collide(void *state, const PlaceableComponent *placeable, const Rectangle boundingBox);
 void Map_render(const void *state, const PlaceableComponent *placeable);
 void Map_render_bloom_source(void);
-void Map_render_minimap(float center_x, float center_y,
-	float screen_x, float screen_y, float size, float range);
 bool Map_line_test_hit(double x0, double y0, double x1, double y1,
 					   double *hit_x, double *hit_y);
+/* Swept AABB against solid cells: time of impact in [0, 1] along (dx, dy)
+   and the contact normal. Cells the box already overlaps are ignored. */
+bool Map_sweep_aabb(const Rectangle box, double dx, double dy,
+					double *t_out, double *nx_out, double *ny_out);
+/* Map_line_test_hit over n segments; fills hit/hit_x/hit_y per segment and
+   returns the number of hits */
+int Map_line_test_hit_batch(int n, const double *x0, const double *y0,
+	const double *x1, const double *y1, bool *hit, double *hit_x, double *hit_y);
+/* Line test counters since the last reset (see bench/bench_ai.c) */
+typedef struct {
+	unsigned long lineTests;       /* full Map_line_test_hit walks */
+	unsigned long batchSegments;   /* segments given to Map_line_test_hit_batch */
+} MapQueryStats;
+const MapQueryStats *Map_get_query_stats(void);
+void Map_reset_query_stats(void);
 void Map_render_stencil_mask(void);
 void Map_render_stencil_mask_all(const Mat4 *proj, const Mat4 *view_mat);
 void Map_set_circuit_traces(bool enabled);
 bool Map_get_circuit_traces(void);
+/* Bump whenever the circuit generator's output changes; it keys the
+   on-disk circuit atlas cache */
+#define MAP_CIRCUIT_GENERATOR_VERSION 1
 void Map_render_circuit_pattern_for_atlas(int cellX, int cellY,
 	float ax, float ay, int adjN, int adjE, int adjS, int adjW);
 
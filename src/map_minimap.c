@@ -0,0 +1,286 @@
+#include "map_minimap.h"
+
+#include <OpenGL/gl3.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "graphics.h"
+#include "map.h"
+#include "render.h"
+#include "color.h"
+
+/*
+ * Minimap terrain as one texel per map cell, built when the zone's cells
+ * change wholesale and patched per cell from the map edit feed (god mode,
+ * destructibles). Drawing is a single textured quad regardless of range;
+ * the out-of-bounds boundary fill is done in the shader.
+ */
+
+#define EDIT_BATCH 1024
+
+/* --- Embedded GLSL 330 core shaders --- */
+
+static const char *minimap_vert_src =
+	"#version 330 core\n"
+	"layout(location = 0) in vec2 a_position;\n"
+	"layout(location = 1) in vec2 a_texcoord;\n"
+	"uniform mat4 u_projection;\n"
+	"out vec2 v_texcoord;\n"
+	"void main() {\n"
+	"    gl_Position = u_projection * vec4(a_position, 0.0, 1.0);\n"
+	"    v_texcoord = a_texcoord;\n"
+	"}\n";
+
+static const char *minimap_frag_src =
+	"#version 330 core\n"
+	"in vec2 v_texcoord;\n"
+	"uniform sampler2D u_terrain;\n"
+	"uniform vec4 u_boundary;\n"
+	"out vec4 fragColor;\n"
+	"void main() {\n"
+	"    if (any(lessThan(v_texcoord, vec2(0.0))) ||\n"
+	"        any(greaterThanEqual(v_texcoord, vec2(1.0)))) {\n"
+	"        fragColor = u_boundary;\n"
+	"        return;\n"
+	"    }\n"
+	"    fragColor = texture(u_terrain, v_texcoord);\n"
+	"}\n";
+
+/* --- GL resources --- */
+
+static GLuint minimap_program;
+static GLint u_projection;
+static GLint u_terrain;
+static GLint u_boundary;
+
+static GLuint terrain_tex;
+static GLuint quad_vao, quad_vbo;
+
+/* --- Terrain cache state --- */
+
+static bool terrainValid = false;
+static unsigned int terrainEditSeq = 0;
+static unsigned char texels[MAP_SIZE * MAP_SIZE * 4];
+
+/* --- Shader helpers --- */
+
+static GLuint compile_shader(GLenum type, const char *source)
+{
+	GLuint shader = glCreateShader(type);
+	glShaderSource(shader, 1, &source, NULL);
+	glCompileShader(shader);
+
+	GLint ok;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+	if (!ok) {
+		char log[512];
+		glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+		fprintf(stderr, "MapMinimap shader compile error: %s\n", log);
+		exit(1);
+	}
+	return shader;
+}
+
+static GLuint link_program(GLuint vert, GLuint frag)
+{
+	GLuint program = glCreateProgram();
+	glAttachShader(program, vert);
+	glAttachShader(program, frag);
+	glLinkProgram(program);
+
+	GLint ok;
+	glGetProgramiv(program, GL_LINK_STATUS, &ok);
+	if (!ok) {
+		char log[512];
+		glGetProgramInfoLog(program, sizeof(log), NULL, log);
+		fprintf(stderr, "MapMinimap shader link error: %s\n", log);
+		exit(1);
+	}
+
+	glDeleteShader(vert);
+	glDeleteShader(frag);
+	return program;
+}
+
+/* --- Terrain texels --- */
+
+/* Brighten for minimap visibility — hue-preserving */
+static void boosted_color(const ColorRGB *rgb, float *r, float *g, float *b)
+{
+	ColorFloat c = Color_rgb_to_float(rgb);
+	float maxC = fmaxf(fmaxf(c.red, c.green), c.blue);
+	float s = (maxC > 0.001f) ? fminf(10.0f, 1.0f / maxC) : 1.0f;
+	*r = c.red * s;
+	*g = c.green * s;
+	*b = c.blue * s;
+}
+
+static unsigned char to_byte(float v)
+{
+	if (v <= 0.0f) return 0;
+	if (v >= 1.0f) return 255;
+	return (unsigned char)(v * 255.0f + 0.5f);
+}
+
+static void shade_texel(int x, int y)
+{
+	unsigned char *t = &texels[(y * MAP_SIZE + x) * 4];
+	const MapCell *cell = Map_get_cell(x, y);
+	if (cell->empty) {
+		t[0] = t[1] = t[2] = t[3] = 0;
+		return;
+	}
+	float r, g, b;
+	boosted_color(&cell->primaryColor, &r, &g, &b);
+	t[0] = to_byte(r);
+	t[1] = to_byte(g);
+	t[2] = to_byte(b);
+	t[3] = 255;
+}
+
+static void rebuild_terrain(void)
+{
+	for (int y = 0; y < MAP_SIZE; y++)
+		for (int x = 0; x < MAP_SIZE; x++)
+			shade_texel(x, y);
+
+	glBindTexture(GL_TEXTURE_2D, terrain_tex);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, MAP_SIZE, MAP_SIZE, 0,
+		GL_RGBA, GL_UNSIGNED_BYTE, texels);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	terrainValid = true;
+	terrainEditSeq = Map_get_edit_seq();
+}
+
+static void refresh_terrain(void)
+{
+	if (!terrainValid) {
+		rebuild_terrain();
+		return;
+	}
+	if (Map_get_edit_seq() == terrainEditSeq)
+		return;
+
+	static int xs[EDIT_BATCH], ys[EDIT_BATCH];
+	int edits = Map_get_edits_since(terrainEditSeq, xs, ys, EDIT_BATCH);
+	if (edits < 0) {
+		/* Zone load or a bulk edit outran the log */
+		rebuild_terrain();
+		return;
+	}
+
+	glBindTexture(GL_TEXTURE_2D, terrain_tex);
+	for (int i = 0; i < edits; i++) {
+		shade_texel(xs[i], ys[i]);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, xs[i], ys[i], 1, 1,
+			GL_RGBA, GL_UNSIGNED_BYTE, &texels[(ys[i] * MAP_SIZE + xs[i]) * 4]);
+	}
+	glBindTexture(GL_TEXTURE_2D, 0);
+	terrainEditSeq = Map_get_edit_seq();
+}
+
+/* --- Public API --- */
+
+void MapMinimap_initialize(void)
+{
+	GLuint vert = compile_shader(GL_VERTEX_SHADER, minimap_vert_src);
+	GLuint frag = compile_shader(GL_FRAGMENT_SHADER, minimap_frag_src);
+	minimap_program = link_program(vert, frag);
+
+	u_projection = glGetUniformLocation(minimap_program, "u_projection");
+	u_terrain = glGetUniformLocation(minimap_program, "u_terrain");
+	u_boundary = glGetUniformLocation(minimap_program, "u_boundary");
+
+	/* Nearest sampling keeps cells crisp, same as the old per-cell quads */
+	glGenTextures(1, &terrain_tex);
+	glBindTexture(GL_TEXTURE_2D, terrain_tex);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	/* 6 vertices * 4 floats (x, y, u, v) — uploaded each frame */
+	glGenVertexArrays(1, &quad_vao);
+	glGenBuffers(1, &quad_vbo);
+	glBindVertexArray(quad_vao);
+	glBindBuffer(GL_ARRAY_BUFFER, quad_vbo);
+	glBufferData(GL_ARRAY_BUFFER, 6 * 4 * sizeof(float), NULL, GL_DYNAMIC_DRAW);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE,
+		4 * sizeof(float), (void *)0);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE,
+		4 * sizeof(float), (void *)(2 * sizeof(float)));
+	glBindVertexArray(0);
+
+	terrainValid = false;
+}
+
+void MapMinimap_cleanup(void)
+{
+	glDeleteTextures(1, &terrain_tex);
+	glDeleteBuffers(1, &quad_vbo);
+	glDeleteVertexArrays(1, &quad_vao);
+	glDeleteProgram(minimap_program);
+}
+
+void MapMinimap_render(float center_x, float center_y,
+	float screen_x, float screen_y, float size, float range)
+{
+	refresh_terrain();
+
+	/* Texture space: texel (gx, gy) covers world cell gx - HALF_MAP_SIZE */
+	float half_range = range * 0.5f;
+	float cells = (float)(MAP_CELL_SIZE * MAP_SIZE);
+	float u0 = (center_x - half_range) / cells + 0.5f;
+	float u1 = (center_x + half_range) / cells + 0.5f;
+	float v0 = (center_y - half_range) / cells + 0.5f;
+	float v1 = (center_y + half_range) / cells + 0.5f;
+
+	/* UI projection is Y-down: top edge of the quad is north (v1) */
+	float x0 = screen_x, x1 = screen_x + size;
+	float y0 = screen_y, y1 = screen_y + size;
+	float verts[] = {
+		x0, y0, u0, v1,
+		x1, y0, u1, v1,
+		x0, y1, u0, v0,
+
+		x1, y0, u1, v1,
+		x1, y1, u1, v0,
+		x0, y1, u0, v0,
+	};
+
+	/* Boundary fill only when the zone has a solid boundary */
+	const MapCell *boundary = Map_get_cell(-1, -1);
+	float br = 0.0f, bg = 0.0f, bb = 0.0f, ba = 0.0f;
+	if (!boundary->empty) {
+		boosted_color(&boundary->primaryColor, &br, &bg, &bb);
+		ba = 1.0f;
+	}
+
+	/* Flush the panel background so terrain draws over it */
+	Mat4 proj = Graphics_get_ui_projection();
+	Mat4 ident = Mat4_identity();
+	Render_flush(&proj, &ident);
+
+	glUseProgram(minimap_program);
+	glUniformMatrix4fv(u_projection, 1, GL_FALSE, proj.m);
+	glUniform1i(u_terrain, 0);
+	glUniform4f(u_boundary, br, bg, bb, ba);
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, terrain_tex);
+
+	glBindVertexArray(quad_vao);
+	glBindBuffer(GL_ARRAY_BUFFER, quad_vbo);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(verts), verts);
+	glDrawArrays(GL_TRIANGLES, 0, 6);
+	glBindVertexArray(0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	/* Restore color shader so subsequent HUD rendering works */
+	glUseProgram(Graphics_get_shaders()->color_shader.program);
+}
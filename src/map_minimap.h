@@ -0,0 +1,9 @@
+#ifndef MAP_MINIMAP_H
+#define MAP_MINIMAP_H
+
+void MapMinimap_initialize(void);
+void MapMinimap_cleanup(void);
+void MapMinimap_render(float center_x, float center_y,
+	float screen_x, float screen_y, float size, float range);
+
+#endif
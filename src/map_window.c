@@ -53,6 +53,12 @@ static GLuint vao, vbo;
 /* State */
 static bool isOpen = false;
 static int texSize = 0;
+static bool texValid = false;
+static bool texRefreshPending = false;  /* uploads wait for MapWindow_render */
+static unsigned int texEditSeq = 0;
+static unsigned char pixels[MAP_SIZE * MAP_SIZE * 4];
+
+#define MAP_EDIT_BATCH 1024
 
 static GLuint compile_shader(GLenum type, const char *src)
 {
@@ -95,7 +101,7 @@ void MapWindow_initialize(void)
 	u_projection_loc = glGetUniformLocation(shaderProgram, "u_projection");
 	u_texture_loc = glGetUniformLocation(shaderProgram, "u_texture");
 
-	/* Create texture (data uploaded on toggle-open) */
+	/* Create texture (built on first open, then patched from fog/map change feeds) */
 	glGenTextures(1, &texture);
 	glBindTexture(GL_TEXTURE_2D, texture);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -120,6 +126,7 @@ void MapWindow_initialize(void)
 
 	isOpen = false;
 	texSize = 0;
+	texValid = false;
 }
 
 void MapWindow_cleanup(void)
@@ -130,81 +137,218 @@ void MapWindow_cleanup(void)
 	glDeleteVertexArrays(1, &vao);
 }
 
-static void generate_texture(void)
+/* Unrevealed = dark gray (distinguishable from black cyberspace) */
+static void shade_cell(unsigned char *px, int x, int y, bool revealed, bool edge)
 {
-	const Zone *z = Zone_get();
-	int size = z->size;
-	if (size <= 0) size = MAP_SIZE;
-	texSize = size;
+	if (!revealed) {
+		px[0] = 25;
+		px[1] = 25;
+		px[2] = 25;
+		px[3] = 255;
+		return;
+	}
 
-	static unsigned char pixels[MAP_SIZE * MAP_SIZE * 4];
+	const MapCell *cell = Map_get_cell(x, y);
+
+	if (cell && !cell->empty) {
+		/* Brighten for visibility — hue-preserving */
+		int maxC = cell->primaryColor.red;
+		if (cell->primaryColor.green > maxC) maxC = cell->primaryColor.green;
+		if (cell->primaryColor.blue > maxC) maxC = cell->primaryColor.blue;
+		int s = (maxC > 0) ? 255 / maxC : 1;
+		if (s > 10) s = 10;
+		int r = cell->primaryColor.red * s;
+		int g = cell->primaryColor.green * s;
+		int b = cell->primaryColor.blue * s;
+		if (edge) { r /= 2; g /= 2; b /= 2; }
+		px[0] = (unsigned char)(r > 255 ? 255 : r);
+		px[1] = (unsigned char)(g > 255 ? 255 : g);
+		px[2] = (unsigned char)(b > 255 ? 255 : b);
+		px[3] = 255;
+	} else {
+		if (edge) {
+			px[0] = 5;
+			px[1] = 5;
+			px[2] = 7;
+		} else {
+			px[0] = 10;
+			px[1] = 10;
+			px[2] = 15;
+		}
+		px[3] = 255;
+	}
+}
 
-	for (int y = 0; y < size; y++) {
-		for (int x = 0; x < size; x++) {
-			int idx = (y * size + x) * 4;
+static bool block_revealed(const uint64_t *rows, int bx, int by)
+{
+	if (bx < 0 || bx >= FOW_BLOCKS || by < 0 || by >= FOW_BLOCKS)
+		return false;
+	return (rows[by] >> bx) & 1u;
+}
 
-			if (!FogOfWar_is_revealed(x, y)) {
-				/* Unrevealed = dark gray (distinguishable from black cyberspace) */
-				pixels[idx + 0] = 25;
-				pixels[idx + 1] = 25;
-				pixels[idx + 2] = 25;
-				pixels[idx + 3] = 255;
-				continue;
-			}
+/*
+ * Fog dilation at block granularity: bit (oy+1)*3 + (ox+1) set when the
+ * neighbouring block at offset (ox, oy) is fogged. A revealed cell is a soft
+ * edge only if it sits on its block's border facing a fogged block, so the
+ * per-cell 8-neighbour fog test reduces to a mask lookup.
+ */
+static unsigned int fogged_neighbourhood(const uint64_t *rows, int bx, int by)
+{
+	unsigned int mask = 0;
+	for (int oy = -1; oy <= 1; oy++)
+		for (int ox = -1; ox <= 1; ox++)
+			if (!block_revealed(rows, bx + ox, by + oy))
+				mask |= 1u << ((oy + 1) * 3 + (ox + 1));
+	return mask;
+}
 
-			/* Check for soft edge (revealed cell next to unrevealed) */
-			bool edge = false;
-			for (int dy = -1; dy <= 1 && !edge; dy++) {
-				for (int dx = -1; dx <= 1 && !edge; dx++) {
-					if (dx == 0 && dy == 0) continue;
-					if (!FogOfWar_is_revealed(x + dx, y + dy))
-						edge = true;
-				}
-			}
+static bool cell_is_edge(unsigned int fogged, int lx, int ly)
+{
+	int ox0 = (lx == 0) ? -1 : 0;
+	int ox1 = (lx == FOW_BLOCK_SIZE - 1) ? 1 : 0;
+	int oy0 = (ly == 0) ? -1 : 0;
+	int oy1 = (ly == FOW_BLOCK_SIZE - 1) ? 1 : 0;
+	for (int oy = oy0; oy <= oy1; oy++)
+		for (int ox = ox0; ox <= ox1; ox++)
+			if (fogged & (1u << ((oy + 1) * 3 + (ox + 1))))
+				return true;
+	return false;
+}
 
-			const MapCell *cell = Map_get_cell(x, y);
-
-			if (cell && !cell->empty) {
-				/* Brighten for visibility — hue-preserving */
-				int maxC = cell->primaryColor.red;
-				if (cell->primaryColor.green > maxC) maxC = cell->primaryColor.green;
-				if (cell->primaryColor.blue > maxC) maxC = cell->primaryColor.blue;
-				int s = (maxC > 0) ? 255 / maxC : 1;
-				if (s > 10) s = 10;
-				int r = cell->primaryColor.red * s;
-				int g = cell->primaryColor.green * s;
-				int b = cell->primaryColor.blue * s;
-				if (edge) { r /= 2; g /= 2; b /= 2; }
-				pixels[idx + 0] = (unsigned char)(r > 255 ? 255 : r);
-				pixels[idx + 1] = (unsigned char)(g > 255 ? 255 : g);
-				pixels[idx + 2] = (unsigned char)(b > 255 ? 255 : b);
-				pixels[idx + 3] = 255;
-			} else {
-				if (edge) {
-					pixels[idx + 0] = 5;
-					pixels[idx + 1] = 5;
-					pixels[idx + 2] = 7;
-				} else {
-					pixels[idx + 0] = 10;
-					pixels[idx + 1] = 10;
-					pixels[idx + 2] = 15;
+/* Recompute pixels for cells [x0, x1) x [y0, y1), a block at a time */
+static void shade_region(int x0, int y0, int x1, int y1)
+{
+	const uint64_t *rows = FogOfWar_get_block_rows();
+
+	for (int by = y0 / FOW_BLOCK_SIZE; by * FOW_BLOCK_SIZE < y1; by++) {
+		for (int bx = x0 / FOW_BLOCK_SIZE; bx * FOW_BLOCK_SIZE < x1; bx++) {
+			bool revealed = block_revealed(rows, bx, by);
+			unsigned int fogged = revealed ? fogged_neighbourhood(rows, bx, by) : 0;
+
+			int cy0 = by * FOW_BLOCK_SIZE, cy1 = cy0 + FOW_BLOCK_SIZE;
+			int cx0 = bx * FOW_BLOCK_SIZE, cx1 = cx0 + FOW_BLOCK_SIZE;
+			if (cy0 < y0) cy0 = y0;
+			if (cy1 > y1) cy1 = y1;
+			if (cx0 < x0) cx0 = x0;
+			if (cx1 > x1) cx1 = x1;
+
+			for (int y = cy0; y < cy1; y++) {
+				for (int x = cx0; x < cx1; x++) {
+					bool edge = fogged && cell_is_edge(fogged,
+						x - bx * FOW_BLOCK_SIZE, y - by * FOW_BLOCK_SIZE);
+					shade_cell(&pixels[(y * texSize + x) * 4], x, y, revealed, edge);
 				}
-				pixels[idx + 3] = 255;
 			}
 		}
 	}
+}
+
+static void upload_region(int x0, int y0, int x1, int y1)
+{
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, texSize);
+	glPixelStorei(GL_UNPACK_SKIP_PIXELS, x0);
+	glPixelStorei(GL_UNPACK_SKIP_ROWS, y0);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, x0, y0, x1 - x0, y1 - y0,
+		GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+	glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+static void rebuild_texture(void)
+{
+	const Zone *z = Zone_get();
+	int size = z->size;
+	if (size <= 0) size = MAP_SIZE;
+	texSize = size;
+
+	shade_region(0, 0, size, size);
 
 	glBindTexture(GL_TEXTURE_2D, texture);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size, size, 0,
 		GL_RGBA, GL_UNSIGNED_BYTE, pixels);
 	glBindTexture(GL_TEXTURE_2D, 0);
+
+	texValid = true;
+	texEditSeq = Map_get_edit_seq();
+}
+
+/*
+ * Patch the texture for blocks revealed (or edited) since the last refresh.
+ * Runs of dirty blocks in a block row become one rect, grown by a cell on
+ * each side since revealing a block changes its neighbours' soft edges.
+ */
+static void update_dirty_blocks(const uint64_t *dirty)
+{
+	int blocks = (texSize + FOW_BLOCK_SIZE - 1) / FOW_BLOCK_SIZE;
+
+	for (int by = 0; by < blocks; by++) {
+		uint64_t row = dirty[by];
+		int bx = 0;
+		while (row && bx < blocks) {
+			if (!((row >> bx) & 1u)) {
+				bx++;
+				continue;
+			}
+			int run = bx;
+			while (run < blocks && ((row >> run) & 1u))
+				run++;
+
+			int x0 = bx * FOW_BLOCK_SIZE - 1;
+			int x1 = run * FOW_BLOCK_SIZE + 1;
+			int y0 = by * FOW_BLOCK_SIZE - 1;
+			int y1 = (by + 1) * FOW_BLOCK_SIZE + 1;
+			if (x0 < 0) x0 = 0;
+			if (y0 < 0) y0 = 0;
+			if (x1 > texSize) x1 = texSize;
+			if (y1 > texSize) y1 = texSize;
+
+			shade_region(x0, y0, x1, y1);
+			upload_region(x0, y0, x1, y1);
+			bx = run;
+		}
+	}
+}
+
+static void refresh_texture(void)
+{
+	uint64_t dirty[FOW_BLOCKS];
+	bool full = false;
+	bool changed = FogOfWar_consume_dirty_blocks(dirty, &full);
+
+	const Zone *z = Zone_get();
+	int size = z->size;
+	if (size <= 0) size = MAP_SIZE;
+
+	if (!texValid || full || size != texSize) {
+		rebuild_texture();
+		return;
+	}
+
+	/* Fold terrain edits (destructibles, etc.) into the dirty block set */
+	static int editXs[MAP_EDIT_BATCH], editYs[MAP_EDIT_BATCH];
+	int edits = Map_get_edits_since(texEditSeq, editXs, editYs, MAP_EDIT_BATCH);
+	if (edits < 0) {
+		rebuild_texture();
+		return;
+	}
+	for (int i = 0; i < edits; i++) {
+		dirty[editYs[i] / FOW_BLOCK_SIZE] |= (uint64_t)1 << (editXs[i] / FOW_BLOCK_SIZE);
+		changed = true;
+	}
+	texEditSeq = Map_get_edit_seq();
+
+	if (changed)
+		update_dirty_blocks(dirty);
 }
 
 void MapWindow_toggle(void)
 {
 	isOpen = !isOpen;
 	if (isOpen)
-		generate_texture();
+		texRefreshPending = true;
 }
 
 bool MapWindow_is_open(void)
@@ -219,13 +363,16 @@ void MapWindow_update(const Input *input)
 	if (input->keyEsc)
 		isOpen = false;
 
-	if (FogOfWar_consume_dirty())
-		generate_texture();
+	texRefreshPending = true;
 }
 
 void MapWindow_render(const Screen *screen)
 {
 	if (!isOpen) return;
+	if (texRefreshPending) {
+		texRefreshPending = false;
+		refresh_texture();
+	}
 	if (texSize <= 0) return;
 
 	TextRenderer *tr = Graphics_get_text_renderer();
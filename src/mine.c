@@ -88,7 +88,7 @@ typedef struct {
 
 static MineState mines[MINE_COUNT];
 static PlaceableComponent placeables[MINE_COUNT];
-static Entity *entityRefs[MINE_COUNT];
+static EntityHandle entityRefs[MINE_COUNT];
 static int highestUsedIndex = 0;
 
 /* Audio — entity sounds only (respawn) */
@@ -122,7 +122,7 @@ void Mine_initialize(Position position, ZoneTheme theme)
 	entity.collidable = &collidable;
 	entity.aiUpdatable = &updatable;
 
-	entityRefs[highestUsedIndex] = Entity_add_entity(entity);
+	entityRefs[highestUsedIndex] = Entity_create(entity);
 
 	highestUsedIndex++;
 
@@ -145,10 +145,8 @@ void Mine_initialize(Position position, ZoneTheme theme)
 void Mine_cleanup()
 {
 	for (int i = 0; i < highestUsedIndex; i++) {
-		if (entityRefs[i]) {
-			entityRefs[i]->empty = true;
-			entityRefs[i] = NULL;
-		}
+		Entity_release(entityRefs[i]);
+		entityRefs[i] = (EntityHandle){0, 0};
 	}
 	highestUsedIndex = 0;
 
@@ -25,7 +25,7 @@
 #include "grid.h"
 #include "procgen.h"
 #include "chunk.h"
-#include "noise.h"
+#include "noise_heatmap.h"
 #include "savepoint.h"
 #include "portal.h"
 #include "fragment.h"
@@ -44,6 +44,7 @@
 #include "confirm_dialog.h"
 #include "global_render.h"
 #include "global_update.h"
+#include "timer_wheel.h"
 #include "audio.h"
 #include "reactor_grid.h"
 #include "boss_hud.h"
@@ -163,6 +164,9 @@ static int chunkExportCounter = 0;
 static int obstacleExportCounter = 0;
 static int stampRotation = 0;  /* 0=0°, 1=90°CW, 2=180°, 3=270°CW */
 
+/* Marker indices from Zone_query_markers, shared by stamping and rendering */
+static int godMarkerHits[ZONE_MAX_SPAWNS];
+
 /* Zone jump menu */
 static bool godZoneMenuOpen = false;
 static char godZoneFiles[16][256];
@@ -197,7 +201,7 @@ static Position loadSpawnPos = {0.0, 0.0};
 /* FPS counter */
 static bool fpsVisible = false;
 static double fpsValue = 0.0;
-static unsigned int fpsAccum = 0;
+static unsigned int fpsLastTicks = 0;
 static int fpsFrames = 0;
 
 /* Spatial grid watchdog timer */
@@ -212,10 +216,13 @@ static void god_mode_render_hud(const Screen *screen);
 static void god_mode_render_spawn_labels(void);
 static void god_mode_render_zone_labels(void);
 static void god_mode_render_spawn_markers(void);
+static int god_mode_query_visible(ZoneMarkerKind kind, float pad_px);
+static int compare_int(const void *a, const void *b);
 static void god_mode_render_noise_heatmap(void);
 static void god_mode_render_chunk_selection(void);
 static void god_mode_render_procgen_debug(void);
 static void zone_teardown_and_load(const char *zone_path);
+static void zone_teardown_and_restore(const char *zone_path);
 static void god_mode_jump_to_zone(const char *zone_path);
 static void god_mode_scan_zones(void);
 static void god_mode_create_zone(void);
@@ -227,6 +234,7 @@ static void warp_render_effects(const Screen *screen);
 void Mode_Gameplay_initialize(void)
 {
 	Entity_destroy_all();
+	TimerWheel_clear();
 	GlobalRender_clear();
 	GlobalUpdate_clear();
 
@@ -321,6 +329,7 @@ void Mode_Gameplay_initialize_from_save(void)
 	}
 
 	Entity_destroy_all();
+	TimerWheel_clear();
 	GlobalRender_clear();
 	GlobalUpdate_clear();
 
@@ -348,8 +357,8 @@ void Mode_Gameplay_initialize_from_save(void)
 	if (ckpt->procgen_seed != 0)
 		Procgen_set_master_seed(ckpt->procgen_seed);
 	Zone_load(ckpt->zone_path);
+	Savepoint_load_fog_from_disk();
 	FogOfWar_set_zone(ckpt->zone_path);
-	FogOfWar_load_all_from_disk();
 	Destructible_initialize();
 
 	/* Register system-level render/update globals */
@@ -430,13 +439,6 @@ void Mode_Gameplay_update(Input *input, const unsigned int ticks)
 	/* FPS counter */
 	if (input->keyBackslash)
 		fpsVisible = !fpsVisible;
-	fpsAccum += ticks;
-	fpsFrames++;
-	if (fpsAccum >= 500) {
-		fpsValue = (double)fpsFrames / (fpsAccum / 1000.0);
-		fpsFrames = 0;
-		fpsAccum = 0;
-	}
 
 	Background_update(ticks * 3);
 
@@ -459,6 +461,7 @@ void Mode_Gameplay_update(Input *input, const unsigned int ticks)
 
 		/* AI still runs so the world feels alive */
 		SpatialGrid_set_player_bucket(Ship_get_position().x, Ship_get_position().y);
+		TimerWheel_advance(ticks);
 		GlobalUpdate_pre_collision(ticks);
 		Entity_ai_update_system(ticks);
 		Destructible_update(ticks);
@@ -658,6 +661,7 @@ void Mode_Gameplay_update(Input *input, const unsigned int ticks)
 
 	SpatialGrid_set_player_bucket(Ship_get_position().x, Ship_get_position().y);
 	Audio_set_listener_position(Ship_get_position().x, Ship_get_position().y);
+	TimerWheel_advance(ticks);
 	GlobalUpdate_pre_collision(ticks);
 	Entity_ai_update_system(ticks);
 	Entity_collision_system();
@@ -699,7 +703,7 @@ void Mode_Gameplay_update(Input *input, const unsigned int ticks)
 		const SaveCheckpoint *ckpt = Savepoint_get_checkpoint();
 		if (ckpt->valid) {
 			/* Zone swap (no cinematic) — FoW saved/loaded inside */
-			zone_teardown_and_load(ckpt->zone_path);
+			zone_teardown_and_restore(ckpt->zone_path);
 
 			Ship_force_spawn(ckpt->position);
 			Savepoint_suppress_by_id(ckpt->savepoint_id);
@@ -855,7 +859,14 @@ void Mode_Gameplay_render(void)
 	/* Exit confirmation dialog */
 	ConfirmDialog_render(&exitDialog);
 
-	/* FPS counter */
+	/* FPS counter — rendered frames, not simulation steps */
+	unsigned int fpsNow = SDL_GetTicks();
+	fpsFrames++;
+	if (fpsNow - fpsLastTicks >= 500) {
+		fpsValue = (double)fpsFrames / ((fpsNow - fpsLastTicks) / 1000.0);
+		fpsFrames = 0;
+		fpsLastTicks = fpsNow;
+	}
 	if (fpsVisible) {
 		float s = Graphics_get_ui_scale();
 		char fpsBuf[32];
@@ -866,6 +877,18 @@ void Mode_Gameplay_render(void)
 		Text_render(tr, shaders, &ui_proj, &identity,
 			fpsBuf, screen.width - 100.0f * s, 15.0f * s,
 			0.0f, 1.0f, 1.0f, 0.8f);
+
+		const AudioSfxStats *sfx = Audio_get_sfx_stats();
+		snprintf(fpsBuf, sizeof(fpsBuf), "SFX: %d/%d", sfx->played, sfx->requested);
+		Text_render(tr, shaders, &ui_proj, &identity,
+			fpsBuf, screen.width - 100.0f * s, 30.0f * s,
+			0.0f, 1.0f, 1.0f, 0.8f);
+
+		const TimerWheelStats *tw = TimerWheel_get_stats();
+		snprintf(fpsBuf, sizeof(fpsBuf), "TMR: %d/%d", tw->fired, tw->pending);
+		Text_render(tr, shaders, &ui_proj, &identity,
+			fpsBuf, screen.width - 100.0f * s, 45.0f * s,
+			0.0f, 1.0f, 1.0f, 0.8f);
 	}
 
 	/* Warp visual effects overlay */
@@ -876,8 +899,6 @@ void Mode_Gameplay_render(void)
 	Render_flush(&ui_proj, &identity);
 	if (gameplayState == GAMEPLAY_ACTIVE && !godModeActive)
 		cursor_render(&ui_proj, &identity);
-
-	Graphics_flip();
 }
 
 static void complete_rebirth(void)
@@ -1152,24 +1173,27 @@ static void god_mode_update(Input *input, const unsigned int ticks)
 				double src_cy = (swy0 + swy1) * 0.5;
 				double dst_cx = (dst_ox + rot_w * 0.5 - HALF_MAP_SIZE) * MAP_CELL_SIZE;
 				double dst_cy = (dst_oy + rot_h * 0.5 - HALF_MAP_SIZE) * MAP_CELL_SIZE;
-				int orig_count = z->spawn_count;
-				for (int i = 0; i < orig_count; i++) {
+				/* Hits are all below the pre-stamp count, so appends
+				   don't disturb them; sorted to keep the original order */
+				int hit_count = Zone_query_markers(ZONE_MARKER_SPAWN,
+					swx0, swy0, swx1, swy1, godMarkerHits, ZONE_MAX_SPAWNS);
+				qsort(godMarkerHits, hit_count, sizeof(int), compare_int);
+				for (int h = 0; h < hit_count; h++) {
+					int i = godMarkerHits[h];
 					double swx = z->spawns[i].world_x, swy = z->spawns[i].world_y;
-					if (swx >= swx0 && swx <= swx1 && swy >= swy0 && swy <= swy1) {
-						/* Relative to source center */
-						double rx = swx - src_cx, ry = swy - src_cy;
-						/* Rotate around center */
-						double rrx, rry;
-						switch (stampRotation) {
-						case 0: rrx = rx;  rry = ry;  break;
-						case 1: rrx = -ry; rry = rx;  break;
-						case 2: rrx = -rx; rry = -ry; break;
-						case 3: rrx = ry;  rry = -rx; break;
-						default: rrx = rx; rry = ry;  break;
-						}
-						Zone_place_spawn(z->spawns[i].enemy_type,
-							dst_cx + rrx, dst_cy + rry);
+					/* Relative to source center */
+					double rx = swx - src_cx, ry = swy - src_cy;
+					/* Rotate around center */
+					double rrx, rry;
+					switch (stampRotation) {
+					case 0: rrx = rx;  rry = ry;  break;
+					case 1: rrx = -ry; rry = rx;  break;
+					case 2: rrx = -rx; rry = -ry; break;
+					case 3: rrx = ry;  rry = -rx; break;
+					default: rrx = rx; rry = ry;  break;
 					}
+					Zone_place_spawn(z->spawns[i].enemy_type,
+						dst_cx + rrx, dst_cy + rry);
 				}
 
 				printf("Stamped %dx%d selection at (%d,%d) rot:%d\n",
@@ -1360,6 +1384,7 @@ static void god_mode_update(Input *input, const unsigned int ticks)
 
 	/* AI still runs so the world feels alive */
 	SpatialGrid_set_player_bucket(Ship_get_position().x, Ship_get_position().y);
+	TimerWheel_advance(ticks);
 	GlobalUpdate_pre_collision(ticks);
 	Entity_ai_update_system(ticks);
 	Destructible_update(ticks);
@@ -1667,73 +1692,46 @@ static void god_mode_render_noise_heatmap(void)
 	const Zone *z = Zone_get();
 	if (!z->procgen) return;
 
-	uint32_t zone_seed = Procgen_derive_zone_seed(
-		Procgen_get_master_seed(), z->filepath);
+	/* Built once per seed/parameter set on worker threads; the wall
+	   threshold is applied at draw time */
+	NoiseHeatmapParams params = {
+		Procgen_derive_zone_seed(Procgen_get_master_seed(), z->filepath),
+		z->noise_octaves,
+		z->noise_frequency,
+		z->noise_lacunarity,
+		z->noise_persistence
+	};
 
-	/* Determine visible grid range from camera viewport */
 	Screen screen = Graphics_get_screen();
 	View view_state = View_get_view();
+	Mat4 world_proj = Graphics_get_world_projection();
+	Mat4 view = View_get_transform(&screen);
 
-	double half_w = (screen.norm_w / view_state.scale) / 2.0;
-	double half_h = (screen.norm_h / view_state.scale) / 2.0;
-	double min_wx = view_state.position.x - half_w;
-	double max_wx = view_state.position.x + half_w;
-	double min_wy = view_state.position.y - half_h;
-	double max_wy = view_state.position.y + half_h;
-
-	int min_gx = (int)floor(min_wx / MAP_CELL_SIZE) + HALF_MAP_SIZE;
-	int max_gx = (int)ceil(max_wx / MAP_CELL_SIZE) + HALF_MAP_SIZE + 1;
-	int min_gy = (int)floor(min_wy / MAP_CELL_SIZE) + HALF_MAP_SIZE;
-	int max_gy = (int)ceil(max_wy / MAP_CELL_SIZE) + HALF_MAP_SIZE + 1;
-
-	if (min_gx < 0) min_gx = 0;
-	if (max_gx > MAP_SIZE) max_gx = MAP_SIZE;
-	if (min_gy < 0) min_gy = 0;
-	if (max_gy > MAP_SIZE) max_gy = MAP_SIZE;
-
-	float s = (float)MAP_CELL_SIZE;
-
-	for (int gy = min_gy; gy < max_gy; gy++) {
-		for (int gx = min_gx; gx < max_gx; gx++) {
-			double noise_val = Noise_fbm(
-				(double)gx, (double)gy,
-				z->noise_octaves,
-				z->noise_frequency,
-				z->noise_lacunarity,
-				z->noise_persistence,
-				zone_seed
-			);
-
-			/* Map noise [-1,1] to color: red=wall, green=empty */
-			float t = (float)((noise_val + 1.0) * 0.5); /* 0..1 */
-			float threshold_t = (float)((z->noise_wall_threshold + 1.0) * 0.5);
-			float r, g, b, a;
-
-			if (noise_val < z->noise_wall_threshold) {
-				/* Below threshold = wall (red) */
-				r = 0.8f; g = 0.1f; b = 0.1f;
-				a = 0.4f;
-			} else {
-				/* Above threshold = empty (green) */
-				r = 0.1f; g = 0.7f; b = 0.1f;
-				a = 0.25f;
-			}
+	NoiseHeatmap_render(&params, z->noise_wall_threshold, &world_proj, &view,
+		view_state.position.x, view_state.position.y);
+}
 
-			/* Brighten near threshold for visibility */
-			float dist = (float)fabs(t - threshold_t);
-			if (dist < 0.05f) {
-				a = 0.7f;
-				r = 1.0f; g = 1.0f; b = 0.0f;
-			}
+/* --- Spawn labels in godmode --- */
 
-			float wx = (float)(gx - HALF_MAP_SIZE) * s;
-			float wy = (float)(gy - HALF_MAP_SIZE) * s;
-			Render_quad_absolute(wx, wy, wx + s, wy + s, r, g, b, a);
-		}
-	}
+static int compare_int(const void *a, const void *b)
+{
+	int ia = *(const int *)a, ib = *(const int *)b;
+	return (ia > ib) - (ia < ib);
 }
 
-/* --- Spawn labels in godmode --- */
+/* Markers of the kind on screen, padded by pad_px so text anchored just
+   off-screen still shows. Fills godMarkerHits and returns the count. */
+static int god_mode_query_visible(ZoneMarkerKind kind, float pad_px)
+{
+	Screen screen = Graphics_get_screen();
+	Position top_left = {-pad_px, -pad_px};
+	Position bottom_right = {screen.width + pad_px, screen.height + pad_px};
+	Position a = View_get_world_position(&screen, top_left);
+	Position b = View_get_world_position(&screen, bottom_right);
+
+	return Zone_query_markers(kind, fmin(a.x, b.x), fmin(a.y, b.y),
+		fmax(a.x, b.x), fmax(a.y, b.y), godMarkerHits, ZONE_MAX_SPAWNS);
+}
 
 static void god_mode_render_spawn_labels(void)
 {
@@ -1746,7 +1744,9 @@ static void god_mode_render_spawn_labels(void)
 	Mat4 ident = Mat4_identity();
 	Mat4 view = View_get_transform(&screen);
 
-	for (int i = 0; i < z->spawn_count; i++) {
+	int hit_count = god_mode_query_visible(ZONE_MARKER_SPAWN, 100.0f * s);
+	for (int h = 0; h < hit_count; h++) {
+		int i = godMarkerHits[h];
 		/* World to screen coordinates */
 		float sx, sy;
 		Mat4_transform_point(&view, (float)z->spawns[i].world_x,
@@ -1775,7 +1775,9 @@ static void god_mode_render_zone_labels(void)
 	Mat4 ident = Mat4_identity();
 	Mat4 view = View_get_transform(&screen);
 
-	for (int i = 0; i < z->label_count; i++) {
+	int hit_count = god_mode_query_visible(ZONE_MARKER_LABEL, 400.0f * s);
+	for (int h = 0; h < hit_count; h++) {
+		int i = godMarkerHits[h];
 		float wx = (float)(z->labels[i].grid_x - HALF_MAP_SIZE) * MAP_CELL_SIZE;
 		float wy = (float)(z->labels[i].grid_y - HALF_MAP_SIZE) * MAP_CELL_SIZE;
 
@@ -1797,7 +1799,9 @@ static void god_mode_render_spawn_markers(void)
 	float ds = 4.0f;
 
 	/* Enemy spawn dots — red/orange */
-	for (int i = 0; i < z->spawn_count; i++) {
+	int hit_count = god_mode_query_visible(ZONE_MARKER_SPAWN, 16.0f);
+	for (int h = 0; h < hit_count; h++) {
+		int i = godMarkerHits[h];
 		float wx = (float)z->spawns[i].world_x;
 		float wy = (float)z->spawns[i].world_y;
 		Render_quad_absolute(wx - ds, wy - ds, wx + ds, wy + ds,
@@ -1823,7 +1827,7 @@ static void god_mode_render_spawn_markers(void)
 
 /* --- Zone teardown/load helper --- */
 
-static void zone_teardown_and_load(const char *zone_path)
+static void zone_teardown(void)
 {
 	Zone_save_if_dirty();
 	Sub_Pea_cleanup();
@@ -1840,11 +1844,14 @@ static void zone_teardown_and_load(const char *zone_path)
 	Burn_reset_player();
 	Zone_unload();
 	Entity_destroy_all();
+	TimerWheel_clear();
 	Grid_initialize();
 	Map_initialize();
 	Ship_initialize();
-	Zone_load(zone_path);
-	Zone_spawn_enemies();
+}
+
+static void zone_enter(const char *zone_path)
+{
 	Destructible_initialize();
 
 	/* Swap fog of war to destination zone (stashes current, loads cached) */
@@ -1853,6 +1860,26 @@ static void zone_teardown_and_load(const char *zone_path)
 	Zone_notify_enter();
 }
 
+static void zone_teardown_and_load(const char *zone_path)
+{
+	zone_teardown();
+	Zone_load(zone_path);
+	Zone_spawn_enemies();
+	zone_enter(zone_path);
+}
+
+/* Checkpoint respawn: rebuild from the snapshot taken at the savepoint,
+   falling back to a full load if the zone file changed since */
+static void zone_teardown_and_restore(const char *zone_path)
+{
+	zone_teardown();
+	if (!Zone_restore_snapshot(zone_path)) {
+		Zone_load(zone_path);
+		Zone_spawn_enemies();
+	}
+	zone_enter(zone_path);
+}
+
 /* --- Zone navigation --- */
 
 static void god_mode_scan_zones(void)
@@ -2247,6 +2274,7 @@ static void warp_update(unsigned int ticks)
 		View_set_scale(zoom);
 		View_set_position(Ship_get_position());
 
+		TimerWheel_advance(ticks);
 		Entity_ai_update_system(ticks);
 
 		if (warpTimer >= WARP_ARRIVE_MS) {
@@ -148,8 +148,6 @@ void Mode_Mainmenu_render(void)
 
 	Render_flush(&ui_proj, &identity);
 	cursor_render(&ui_proj, &identity);
-
-	Graphics_flip();
 }
 
 static void render_menu_text(void)
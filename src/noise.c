@@ -1,6 +1,17 @@
 #include "noise.h"
 #include "prng.h"
 #include <math.h>
+#include <stdbool.h>
+
+/* x86 builds carry SSE2 and AVX2 kernels selected at runtime; everything
+   else uses the scalar path */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NOISE_X86 1
+#include <immintrin.h>
+#endif
+
+/* Samples per block in the row functions (bounds the stack buffers) */
+#define ROW_BLOCK 256
 
 /* Skew factors for 2D simplex */
 #define F2 0.3660254037844386   /* (sqrt(3) - 1) / 2 */
@@ -13,8 +24,9 @@ static const double grad2[][2] = {
 	{ 1, 1}, {-1, 1}, { 1,-1}, {-1,-1}
 };
 
-/* Standard permutation table */
-static const unsigned char perm[512] = {
+/* Standard permutation table, plus three bytes of padding so the AVX2
+   kernels can gather 32 bits at any index */
+static const unsigned char perm[512 + 3] = {
 	151,160,137,91,90,15,131,13,201,95,96,53,194,233,7,225,
 	140,36,103,30,69,142,8,99,37,240,21,10,23,190,6,148,
 	247,120,234,75,0,26,197,62,94,252,219,203,117,35,11,32,
@@ -47,9 +59,48 @@ static const unsigned char perm[512] = {
 	218,246,97,228,251,34,242,193,238,210,144,12,191,179,162,241,
 	81,51,145,235,249,14,239,107,49,192,214,31,181,199,106,157,
 	184,84,204,176,115,121,50,45,127,4,150,254,138,236,205,93,
-	222,114,67,29,24,72,243,141,128,195,78,66,215,61,156,180
+	222,114,67,29,24,72,243,141,128,195,78,66,215,61,156,180,
+	0,0,0
+};
+
+/* perm[k] % 12, so corner hashing skips the modulo */
+static const unsigned char permMod12[512 + 3] = {
+	7,4,5,7,6,3,11,1,9,11,0,5,2,5,7,9,
+	8,0,7,6,9,10,8,3,1,0,9,10,11,10,6,4,
+	7,0,6,3,0,2,5,2,10,0,3,11,9,11,11,8,
+	9,9,9,4,9,5,8,3,6,8,5,4,3,0,8,7,
+	2,9,11,2,7,0,3,10,5,2,2,3,11,3,1,2,
+	0,7,1,2,4,9,8,5,7,10,5,4,4,6,11,6,
+	5,1,3,5,1,0,8,1,5,4,0,7,4,5,6,1,
+	8,4,3,10,8,8,3,2,8,4,1,6,5,6,3,4,
+	4,1,10,10,4,3,5,10,2,3,10,6,3,10,1,8,
+	3,2,11,11,11,4,10,5,2,9,4,6,7,3,2,9,
+	11,8,8,2,8,10,7,10,5,9,5,11,11,7,4,9,
+	9,10,3,1,7,2,0,2,7,5,8,4,10,5,4,8,
+	2,6,1,0,11,10,2,1,10,6,0,0,11,11,6,1,
+	9,3,1,7,9,2,11,11,1,0,10,7,1,7,10,1,
+	4,0,0,8,7,1,2,9,7,4,6,2,6,8,1,9,
+	6,6,7,5,0,0,3,9,8,3,6,6,11,1,0,0,
+	7,4,5,7,6,3,11,1,9,11,0,5,2,5,7,9,
+	8,0,7,6,9,10,8,3,1,0,9,10,11,10,6,4,
+	7,0,6,3,0,2,5,2,10,0,3,11,9,11,11,8,
+	9,9,9,4,9,5,8,3,6,8,5,4,3,0,8,7,
+	2,9,11,2,7,0,3,10,5,2,2,3,11,3,1,2,
+	0,7,1,2,4,9,8,5,7,10,5,4,4,6,11,6,
+	5,1,3,5,1,0,8,1,5,4,0,7,4,5,6,1,
+	8,4,3,10,8,8,3,2,8,4,1,6,5,6,3,4,
+	4,1,10,10,4,3,5,10,2,3,10,6,3,10,1,8,
+	3,2,11,11,11,4,10,5,2,9,4,6,7,3,2,9,
+	11,8,8,2,8,10,7,10,5,9,5,11,11,7,4,9,
+	9,10,3,1,7,2,0,2,7,5,8,4,10,5,4,8,
+	2,6,1,0,11,10,2,1,10,6,0,0,11,11,6,1,
+	9,3,1,7,9,2,11,11,1,0,10,7,1,7,10,1,
+	4,0,0,8,7,1,2,9,7,4,6,2,6,8,1,9,
+	6,6,7,5,0,0,3,9,8,3,6,6,11,1,0,0,
+	0,0,0
 };
 
+
 static double dot2(const double *g, double x, double y)
 {
 	return g[0] * x + g[1] * y;
@@ -134,3 +185,544 @@ double Noise_fbm(double x, double y, int octaves, double frequency,
 
 	return sum / max_amp;
 }
+
+/* --- Batch kernels ---
+ * Each kernel evaluates simplex noise at (px[k], py) for k in [0, n).
+ * The double kernels repeat Noise_simplex2d's arithmetic operation for
+ * operation (same order, no fused multiply-add) so every lane rounds the
+ * way the scalar path does. Permutation lookups stay scalar per lane;
+ * only the floating-point work is vectorized. */
+
+typedef void (*SpanFunc)(const double *px, double py, double *out, int n);
+typedef void (*SpanFuncF)(const float *px, float py, float *out, int n);
+
+static int forcedKernel = -1;
+
+/* Gradient indices of the three corners of one lane's simplex */
+static void corner_gradients(int i, int j, int upper, int gi[3][8], int lane)
+{
+	int ii = i & 255;
+	int jj = j & 255;
+	int i1 = upper ? 1 : 0;
+	int j1 = upper ? 0 : 1;
+	gi[0][lane] = permMod12[ii      + perm[jj     ]];
+	gi[1][lane] = permMod12[ii + i1 + perm[jj + j1]];
+	gi[2][lane] = permMod12[ii + 1  + perm[jj + 1 ]];
+}
+
+static void span_scalar(const double *px, double py, double *out, int n)
+{
+	for (int k = 0; k < n; k++)
+		out[k] = Noise_simplex2d(px[k], py);
+}
+
+static int fastfloorf(float x)
+{
+	int xi = (int)x;
+	return x < xi ? xi - 1 : xi;
+}
+
+static float simplex2f(float x, float y)
+{
+	const float f2 = (float)F2;
+	const float g2 = (float)G2;
+
+	float s = (x + y) * f2;
+	int i = fastfloorf(x + s);
+	int j = fastfloorf(y + s);
+
+	float t = (float)(i + j) * g2;
+	float x0 = x - ((float)i - t);
+	float y0 = y - ((float)j - t);
+
+	int upper = x0 > y0;
+	float x1 = x0 - (upper ? 1.0f : 0.0f) + g2;
+	float y1 = y0 - (upper ? 0.0f : 1.0f) + g2;
+	float x2 = x0 - 1.0f + 2.0f * g2;
+	float y2 = y0 - 1.0f + 2.0f * g2;
+
+	int gi[3][8];
+	corner_gradients(i, j, upper, gi, 0);
+
+	float xs[3] = {x0, x1, x2};
+	float ys[3] = {y0, y1, y2};
+	float sum = 0.0f;
+	for (int c = 0; c < 3; c++) {
+		float tc = 0.5f - xs[c] * xs[c] - ys[c] * ys[c];
+		if (tc < 0.0f) continue;
+		tc *= tc;
+		sum += tc * tc * ((float)grad2[gi[c][0]][0] * xs[c]
+			+ (float)grad2[gi[c][0]][1] * ys[c]);
+	}
+	return 70.0f * sum;
+}
+
+static void span_scalar_f(const float *px, float py, float *out, int n)
+{
+	for (int k = 0; k < n; k++)
+		out[k] = simplex2f(px[k], py);
+}
+
+#ifdef NOISE_X86
+
+/* -- SSE2, 2 x double / 4 x float -- */
+
+__attribute__((target("sse2")))
+static inline __m128d floor_pd_sse2(__m128d v)
+{
+	__m128d fi = _mm_cvtepi32_pd(_mm_cvttpd_epi32(v));
+	return _mm_sub_pd(fi, _mm_and_pd(_mm_cmplt_pd(v, fi), _mm_set1_pd(1.0)));
+}
+
+__attribute__((target("sse2")))
+static inline __m128d corner_pd_sse2(__m128d x, __m128d y, __m128d gx, __m128d gy)
+{
+	__m128d t = _mm_sub_pd(_mm_sub_pd(_mm_set1_pd(0.5), _mm_mul_pd(x, x)),
+		_mm_mul_pd(y, y));
+	__m128d dead = _mm_cmplt_pd(t, _mm_setzero_pd());
+	__m128d t2 = _mm_mul_pd(t, t);
+	__m128d n = _mm_mul_pd(_mm_mul_pd(t2, t2),
+		_mm_add_pd(_mm_mul_pd(gx, x), _mm_mul_pd(gy, y)));
+	return _mm_andnot_pd(dead, n);
+}
+
+__attribute__((target("sse2")))
+static void span_sse2(const double *px, double py, double *out, int n)
+{
+	const __m128d f2 = _mm_set1_pd(F2);
+	const __m128d g2 = _mm_set1_pd(G2);
+	const __m128d g2x2 = _mm_set1_pd(2.0 * G2);
+	const __m128d one = _mm_set1_pd(1.0);
+	const __m128d y = _mm_set1_pd(py);
+
+	int k = 0;
+	for (; k + 2 <= n; k += 2) {
+		__m128d x = _mm_loadu_pd(px + k);
+		__m128d s = _mm_mul_pd(_mm_add_pd(x, y), f2);
+		__m128d fi = floor_pd_sse2(_mm_add_pd(x, s));
+		__m128d fj = floor_pd_sse2(_mm_add_pd(y, s));
+		__m128d t = _mm_mul_pd(_mm_add_pd(fi, fj), g2);
+		__m128d x0 = _mm_sub_pd(x, _mm_sub_pd(fi, t));
+		__m128d y0 = _mm_sub_pd(y, _mm_sub_pd(fj, t));
+
+		__m128d upper = _mm_cmpgt_pd(x0, y0);
+		__m128d x1 = _mm_add_pd(_mm_sub_pd(x0, _mm_and_pd(upper, one)), g2);
+		__m128d y1 = _mm_add_pd(_mm_sub_pd(y0, _mm_andnot_pd(upper, one)), g2);
+		__m128d x2 = _mm_add_pd(_mm_sub_pd(x0, one), g2x2);
+		__m128d y2 = _mm_add_pd(_mm_sub_pd(y0, one), g2x2);
+
+		double fiv[2], fjv[2];
+		_mm_storeu_pd(fiv, fi);
+		_mm_storeu_pd(fjv, fj);
+		int mask = _mm_movemask_pd(upper);
+		int gi[3][8];
+		double gx[3][2], gy[3][2];
+		for (int l = 0; l < 2; l++)
+			corner_gradients((int)fiv[l], (int)fjv[l], (mask >> l) & 1, gi, l);
+		for (int c = 0; c < 3; c++)
+			for (int l = 0; l < 2; l++) {
+				gx[c][l] = grad2[gi[c][l]][0];
+				gy[c][l] = grad2[gi[c][l]][1];
+			}
+
+		__m128d n0 = corner_pd_sse2(x0, y0, _mm_loadu_pd(gx[0]), _mm_loadu_pd(gy[0]));
+		__m128d n1 = corner_pd_sse2(x1, y1, _mm_loadu_pd(gx[1]), _mm_loadu_pd(gy[1]));
+		__m128d n2 = corner_pd_sse2(x2, y2, _mm_loadu_pd(gx[2]), _mm_loadu_pd(gy[2]));
+		_mm_storeu_pd(out + k, _mm_mul_pd(_mm_set1_pd(70.0),
+			_mm_add_pd(_mm_add_pd(n0, n1), n2)));
+	}
+	for (; k < n; k++)
+		out[k] = Noise_simplex2d(px[k], py);
+}
+
+__attribute__((target("sse2")))
+static inline __m128 floor_ps_sse2(__m128 v)
+{
+	__m128 fi = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+	return _mm_sub_ps(fi, _mm_and_ps(_mm_cmplt_ps(v, fi), _mm_set1_ps(1.0f)));
+}
+
+__attribute__((target("sse2")))
+static inline __m128 corner_ps_sse2(__m128 x, __m128 y, __m128 gx, __m128 gy)
+{
+	__m128 t = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(0.5f), _mm_mul_ps(x, x)),
+		_mm_mul_ps(y, y));
+	__m128 dead = _mm_cmplt_ps(t, _mm_setzero_ps());
+	__m128 t2 = _mm_mul_ps(t, t);
+	__m128 n = _mm_mul_ps(_mm_mul_ps(t2, t2),
+		_mm_add_ps(_mm_mul_ps(gx, x), _mm_mul_ps(gy, y)));
+	return _mm_andnot_ps(dead, n);
+}
+
+__attribute__((target("sse2")))
+static void span_sse2_f(const float *px, float py, float *out, int n)
+{
+	const __m128 f2 = _mm_set1_ps((float)F2);
+	const __m128 g2 = _mm_set1_ps((float)G2);
+	const __m128 g2x2 = _mm_set1_ps(2.0f * (float)G2);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 y = _mm_set1_ps(py);
+
+	int k = 0;
+	for (; k + 4 <= n; k += 4) {
+		__m128 x = _mm_loadu_ps(px + k);
+		__m128 s = _mm_mul_ps(_mm_add_ps(x, y), f2);
+		__m128 fi = floor_ps_sse2(_mm_add_ps(x, s));
+		__m128 fj = floor_ps_sse2(_mm_add_ps(y, s));
+		__m128 t = _mm_mul_ps(_mm_add_ps(fi, fj), g2);
+		__m128 x0 = _mm_sub_ps(x, _mm_sub_ps(fi, t));
+		__m128 y0 = _mm_sub_ps(y, _mm_sub_ps(fj, t));
+
+		__m128 upper = _mm_cmpgt_ps(x0, y0);
+		__m128 x1 = _mm_add_ps(_mm_sub_ps(x0, _mm_and_ps(upper, one)), g2);
+		__m128 y1 = _mm_add_ps(_mm_sub_ps(y0, _mm_andnot_ps(upper, one)), g2);
+		__m128 x2 = _mm_add_ps(_mm_sub_ps(x0, one), g2x2);
+		__m128 y2 = _mm_add_ps(_mm_sub_ps(y0, one), g2x2);
+
+		float fiv[4], fjv[4];
+		_mm_storeu_ps(fiv, fi);
+		_mm_storeu_ps(fjv, fj);
+		int mask = _mm_movemask_ps(upper);
+		int gi[3][8];
+		float gx[3][4], gy[3][4];
+		for (int l = 0; l < 4; l++)
+			corner_gradients((int)fiv[l], (int)fjv[l], (mask >> l) & 1, gi, l);
+		for (int c = 0; c < 3; c++)
+			for (int l = 0; l < 4; l++) {
+				gx[c][l] = (float)grad2[gi[c][l]][0];
+				gy[c][l] = (float)grad2[gi[c][l]][1];
+			}
+
+		__m128 n0 = corner_ps_sse2(x0, y0, _mm_loadu_ps(gx[0]), _mm_loadu_ps(gy[0]));
+		__m128 n1 = corner_ps_sse2(x1, y1, _mm_loadu_ps(gx[1]), _mm_loadu_ps(gy[1]));
+		__m128 n2 = corner_ps_sse2(x2, y2, _mm_loadu_ps(gx[2]), _mm_loadu_ps(gy[2]));
+		_mm_storeu_ps(out + k, _mm_mul_ps(_mm_set1_ps(70.0f),
+			_mm_add_ps(_mm_add_ps(n0, n1), n2)));
+	}
+	for (; k < n; k++)
+		out[k] = simplex2f(px[k], py);
+}
+
+/* -- AVX2, 4 x double / 8 x float --
+ * Hashing is vectorized too: 32-bit gathers over the byte tables (hence
+ * their padding), masked down to the addressed byte. */
+
+static const float grad2f[12][2] = {
+	{ 1, 1}, {-1, 1}, { 1,-1}, {-1,-1},
+	{ 1, 0}, {-1, 0}, { 0, 1}, { 0,-1},
+	{ 1, 1}, {-1, 1}, { 1,-1}, {-1,-1}
+};
+
+__attribute__((target("avx2")))
+static inline __m128i gather_u8_avx2(const unsigned char *table, __m128i idx)
+{
+	return _mm_and_si128(_mm_i32gather_epi32((const int *)table, idx, 1),
+		_mm_set1_epi32(255));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i gather8_u8_avx2(const unsigned char *table, __m256i idx)
+{
+	return _mm256_and_si256(_mm256_i32gather_epi32((const int *)table, idx, 1),
+		_mm256_set1_epi32(255));
+}
+
+__attribute__((target("avx2")))
+static inline __m256d floor_pd_avx2(__m256d v)
+{
+	__m256d fi = _mm256_cvtepi32_pd(_mm256_cvttpd_epi32(v));
+	return _mm256_sub_pd(fi, _mm256_and_pd(_mm256_cmp_pd(v, fi, _CMP_LT_OQ),
+		_mm256_set1_pd(1.0)));
+}
+
+__attribute__((target("avx2")))
+static inline __m256d corner_pd_avx2(__m256d x, __m256d y, __m256d gx, __m256d gy)
+{
+	__m256d t = _mm256_sub_pd(_mm256_sub_pd(_mm256_set1_pd(0.5), _mm256_mul_pd(x, x)),
+		_mm256_mul_pd(y, y));
+	__m256d dead = _mm256_cmp_pd(t, _mm256_setzero_pd(), _CMP_LT_OQ);
+	__m256d t2 = _mm256_mul_pd(t, t);
+	__m256d n = _mm256_mul_pd(_mm256_mul_pd(t2, t2),
+		_mm256_add_pd(_mm256_mul_pd(gx, x), _mm256_mul_pd(gy, y)));
+	return _mm256_andnot_pd(dead, n);
+}
+
+__attribute__((target("avx2")))
+static void span_avx2(const double *px, double py, double *out, int n)
+{
+	const __m256d f2 = _mm256_set1_pd(F2);
+	const __m256d g2 = _mm256_set1_pd(G2);
+	const __m256d g2x2 = _mm256_set1_pd(2.0 * G2);
+	const __m256d one = _mm256_set1_pd(1.0);
+	const __m256d y = _mm256_set1_pd(py);
+	const __m128i byte = _mm_set1_epi32(255);
+	const __m128i one_i = _mm_set1_epi32(1);
+
+	int k = 0;
+	for (; k + 4 <= n; k += 4) {
+		__m256d x = _mm256_loadu_pd(px + k);
+		__m256d s = _mm256_mul_pd(_mm256_add_pd(x, y), f2);
+		__m256d fi = floor_pd_avx2(_mm256_add_pd(x, s));
+		__m256d fj = floor_pd_avx2(_mm256_add_pd(y, s));
+		__m256d t = _mm256_mul_pd(_mm256_add_pd(fi, fj), g2);
+		__m256d x0 = _mm256_sub_pd(x, _mm256_sub_pd(fi, t));
+		__m256d y0 = _mm256_sub_pd(y, _mm256_sub_pd(fj, t));
+
+		__m256d upper = _mm256_cmp_pd(x0, y0, _CMP_GT_OQ);
+		__m256d x1 = _mm256_add_pd(_mm256_sub_pd(x0, _mm256_and_pd(upper, one)), g2);
+		__m256d y1 = _mm256_add_pd(_mm256_sub_pd(y0, _mm256_andnot_pd(upper, one)), g2);
+		__m256d x2 = _mm256_add_pd(_mm256_sub_pd(x0, one), g2x2);
+		__m256d y2 = _mm256_add_pd(_mm256_sub_pd(y0, one), g2x2);
+
+		/* Corner hashing, as in corner_gradients, four lanes at a time */
+		__m128i ii = _mm_and_si128(_mm256_cvttpd_epi32(fi), byte);
+		__m128i jj = _mm_and_si128(_mm256_cvttpd_epi32(fj), byte);
+		__m128i i1 = _mm256_cvttpd_epi32(_mm256_and_pd(upper, one));
+		__m128i j1 = _mm_sub_epi32(one_i, i1);
+		__m128i gi0 = gather_u8_avx2(permMod12, _mm_add_epi32(ii,
+			gather_u8_avx2(perm, jj)));
+		__m128i gi1 = gather_u8_avx2(permMod12, _mm_add_epi32(_mm_add_epi32(ii, i1),
+			gather_u8_avx2(perm, _mm_add_epi32(jj, j1))));
+		__m128i gi2 = gather_u8_avx2(permMod12, _mm_add_epi32(_mm_add_epi32(ii, one_i),
+			gather_u8_avx2(perm, _mm_add_epi32(jj, one_i))));
+		gi0 = _mm_slli_epi32(gi0, 1);
+		gi1 = _mm_slli_epi32(gi1, 1);
+		gi2 = _mm_slli_epi32(gi2, 1);
+
+		__m256d n0 = corner_pd_avx2(x0, y0, _mm256_i32gather_pd(&grad2[0][0], gi0, 8),
+			_mm256_i32gather_pd(&grad2[0][1], gi0, 8));
+		__m256d n1 = corner_pd_avx2(x1, y1, _mm256_i32gather_pd(&grad2[0][0], gi1, 8),
+			_mm256_i32gather_pd(&grad2[0][1], gi1, 8));
+		__m256d n2 = corner_pd_avx2(x2, y2, _mm256_i32gather_pd(&grad2[0][0], gi2, 8),
+			_mm256_i32gather_pd(&grad2[0][1], gi2, 8));
+		_mm256_storeu_pd(out + k, _mm256_mul_pd(_mm256_set1_pd(70.0),
+			_mm256_add_pd(_mm256_add_pd(n0, n1), n2)));
+	}
+	for (; k < n; k++)
+		out[k] = Noise_simplex2d(px[k], py);
+}
+
+__attribute__((target("avx2")))
+static inline __m256 floor_ps_avx2(__m256 v)
+{
+	__m256 fi = _mm256_cvtepi32_ps(_mm256_cvttps_epi32(v));
+	return _mm256_sub_ps(fi, _mm256_and_ps(_mm256_cmp_ps(v, fi, _CMP_LT_OQ),
+		_mm256_set1_ps(1.0f)));
+}
+
+__attribute__((target("avx2")))
+static inline __m256 corner_ps_avx2(__m256 x, __m256 y, __m256 gx, __m256 gy)
+{
+	__m256 t = _mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(0.5f), _mm256_mul_ps(x, x)),
+		_mm256_mul_ps(y, y));
+	__m256 dead = _mm256_cmp_ps(t, _mm256_setzero_ps(), _CMP_LT_OQ);
+	__m256 t2 = _mm256_mul_ps(t, t);
+	__m256 n = _mm256_mul_ps(_mm256_mul_ps(t2, t2),
+		_mm256_add_ps(_mm256_mul_ps(gx, x), _mm256_mul_ps(gy, y)));
+	return _mm256_andnot_ps(dead, n);
+}
+
+__attribute__((target("avx2")))
+static void span_avx2_f(const float *px, float py, float *out, int n)
+{
+	const __m256 f2 = _mm256_set1_ps((float)F2);
+	const __m256 g2 = _mm256_set1_ps((float)G2);
+	const __m256 g2x2 = _mm256_set1_ps(2.0f * (float)G2);
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 y = _mm256_set1_ps(py);
+	const __m256i byte = _mm256_set1_epi32(255);
+	const __m256i one_i = _mm256_set1_epi32(1);
+
+	int k = 0;
+	for (; k + 8 <= n; k += 8) {
+		__m256 x = _mm256_loadu_ps(px + k);
+		__m256 s = _mm256_mul_ps(_mm256_add_ps(x, y), f2);
+		__m256 fi = floor_ps_avx2(_mm256_add_ps(x, s));
+		__m256 fj = floor_ps_avx2(_mm256_add_ps(y, s));
+		__m256 t = _mm256_mul_ps(_mm256_add_ps(fi, fj), g2);
+		__m256 x0 = _mm256_sub_ps(x, _mm256_sub_ps(fi, t));
+		__m256 y0 = _mm256_sub_ps(y, _mm256_sub_ps(fj, t));
+
+		__m256 upper = _mm256_cmp_ps(x0, y0, _CMP_GT_OQ);
+		__m256 x1 = _mm256_add_ps(_mm256_sub_ps(x0, _mm256_and_ps(upper, one)), g2);
+		__m256 y1 = _mm256_add_ps(_mm256_sub_ps(y0, _mm256_andnot_ps(upper, one)), g2);
+		__m256 x2 = _mm256_add_ps(_mm256_sub_ps(x0, one), g2x2);
+		__m256 y2 = _mm256_add_ps(_mm256_sub_ps(y0, one), g2x2);
+
+		__m256i ii = _mm256_and_si256(_mm256_cvttps_epi32(fi), byte);
+		__m256i jj = _mm256_and_si256(_mm256_cvttps_epi32(fj), byte);
+		__m256i i1 = _mm256_cvttps_epi32(_mm256_and_ps(upper, one));
+		__m256i j1 = _mm256_sub_epi32(one_i, i1);
+		__m256i gi0 = gather8_u8_avx2(permMod12, _mm256_add_epi32(ii,
+			gather8_u8_avx2(perm, jj)));
+		__m256i gi1 = gather8_u8_avx2(permMod12, _mm256_add_epi32(_mm256_add_epi32(ii, i1),
+			gather8_u8_avx2(perm, _mm256_add_epi32(jj, j1))));
+		__m256i gi2 = gather8_u8_avx2(permMod12, _mm256_add_epi32(_mm256_add_epi32(ii, one_i),
+			gather8_u8_avx2(perm, _mm256_add_epi32(jj, one_i))));
+		gi0 = _mm256_slli_epi32(gi0, 1);
+		gi1 = _mm256_slli_epi32(gi1, 1);
+		gi2 = _mm256_slli_epi32(gi2, 1);
+
+		__m256 n0 = corner_ps_avx2(x0, y0, _mm256_i32gather_ps(&grad2f[0][0], gi0, 4),
+			_mm256_i32gather_ps(&grad2f[0][1], gi0, 4));
+		__m256 n1 = corner_ps_avx2(x1, y1, _mm256_i32gather_ps(&grad2f[0][0], gi1, 4),
+			_mm256_i32gather_ps(&grad2f[0][1], gi1, 4));
+		__m256 n2 = corner_ps_avx2(x2, y2, _mm256_i32gather_ps(&grad2f[0][0], gi2, 4),
+			_mm256_i32gather_ps(&grad2f[0][1], gi2, 4));
+		_mm256_storeu_ps(out + k, _mm256_mul_ps(_mm256_set1_ps(70.0f),
+			_mm256_add_ps(_mm256_add_ps(n0, n1), n2)));
+	}
+	for (; k < n; k++)
+		out[k] = simplex2f(px[k], py);
+}
+
+#endif /* NOISE_X86 */
+
+/* --- Kernel selection --- */
+
+static bool kernel_supported(NoiseKernel kernel)
+{
+	switch (kernel) {
+	case NOISE_KERNEL_SCALAR:
+		return true;
+#ifdef NOISE_X86
+	case NOISE_KERNEL_SSE2:
+		return __builtin_cpu_supports("sse2");
+	case NOISE_KERNEL_AVX2:
+		return __builtin_cpu_supports("avx2");
+#endif
+	default:
+		return false;
+	}
+}
+
+NoiseKernel Noise_get_kernel(void)
+{
+	if (forcedKernel >= 0)
+		return (NoiseKernel)forcedKernel;
+	if (kernel_supported(NOISE_KERNEL_AVX2))
+		return NOISE_KERNEL_AVX2;
+	if (kernel_supported(NOISE_KERNEL_SSE2))
+		return NOISE_KERNEL_SSE2;
+	return NOISE_KERNEL_SCALAR;
+}
+
+void Noise_set_kernel(NoiseKernel kernel)
+{
+	forcedKernel = kernel_supported(kernel) ? (int)kernel : -1;
+}
+
+const char *Noise_kernel_name(NoiseKernel kernel)
+{
+	switch (kernel) {
+	case NOISE_KERNEL_SSE2: return "sse2";
+	case NOISE_KERNEL_AVX2: return "avx2";
+	default:                return "scalar";
+	}
+}
+
+static SpanFunc span_for(NoiseKernel kernel)
+{
+#ifdef NOISE_X86
+	if (kernel == NOISE_KERNEL_AVX2) return span_avx2;
+	if (kernel == NOISE_KERNEL_SSE2) return span_sse2;
+#endif
+	(void)kernel;
+	return span_scalar;
+}
+
+static SpanFuncF span_for_f(NoiseKernel kernel)
+{
+#ifdef NOISE_X86
+	if (kernel == NOISE_KERNEL_AVX2) return span_avx2_f;
+	if (kernel == NOISE_KERNEL_SSE2) return span_sse2_f;
+#endif
+	(void)kernel;
+	return span_scalar_f;
+}
+
+/* --- Row fBm --- */
+
+void Noise_fbm_row(double *out, int count, double x0, double dx, double y,
+                   int octaves, double frequency, double lacunarity,
+                   double persistence, uint32_t seed)
+{
+	SpanFunc span = span_for(Noise_get_kernel());
+	double px[ROW_BLOCK], noise[ROW_BLOCK], sum[ROW_BLOCK];
+
+	for (int base = 0; base < count; base += ROW_BLOCK) {
+		int n = count - base < ROW_BLOCK ? count - base : ROW_BLOCK;
+
+		/* Octave offsets are re-derived per block, exactly as Noise_fbm
+		   derives them per sample */
+		Prng rng;
+		Prng_seed(&rng, seed);
+
+		double amplitude = 1.0;
+		double max_amp = 0.0;
+		double freq = frequency;
+
+		for (int k = 0; k < n; k++)
+			sum[k] = 0.0;
+
+		for (int o = 0; o < octaves; o++) {
+			double ox = Prng_double(&rng) * 1000.0 - 500.0;
+			double oy = Prng_double(&rng) * 1000.0 - 500.0;
+
+			for (int k = 0; k < n; k++)
+				px[k] = (x0 + (double)(base + k) * dx) * freq + ox;
+			span(px, y * freq + oy, noise, n);
+			for (int k = 0; k < n; k++)
+				sum[k] += amplitude * noise[k];
+			max_amp += amplitude;
+
+			freq *= lacunarity;
+			amplitude *= persistence;
+		}
+
+		for (int k = 0; k < n; k++)
+			out[base + k] = sum[k] / max_amp;
+	}
+}
+
+void Noise_fbm_row_f(float *out, int count, double x0, double dx, double y,
+                     int octaves, double frequency, double lacunarity,
+                     double persistence, uint32_t seed)
+{
+	SpanFuncF span = span_for_f(Noise_get_kernel());
+	float px[ROW_BLOCK], noise[ROW_BLOCK], sum[ROW_BLOCK];
+
+	for (int base = 0; base < count; base += ROW_BLOCK) {
+		int n = count - base < ROW_BLOCK ? count - base : ROW_BLOCK;
+
+		Prng rng;
+		Prng_seed(&rng, seed);
+
+		float amplitude = 1.0f;
+		float max_amp = 0.0f;
+		double freq = frequency;
+
+		for (int k = 0; k < n; k++)
+			sum[k] = 0.0f;
+
+		for (int o = 0; o < octaves; o++) {
+			double ox = Prng_double(&rng) * 1000.0 - 500.0;
+			double oy = Prng_double(&rng) * 1000.0 - 500.0;
+
+			/* Offset in double, then narrow: at +-500 float spacing
+			   is already ~3e-5, so adding there would cost more */
+			for (int k = 0; k < n; k++)
+				px[k] = (float)((x0 + (double)(base + k) * dx) * freq + ox);
+			span(px, (float)(y * freq + oy), noise, n);
+			for (int k = 0; k < n; k++)
+				sum[k] += amplitude * noise[k];
+			max_amp += amplitude;
+
+			freq *= lacunarity;
+			amplitude *= (float)persistence;
+		}
+
+		for (int k = 0; k < n; k++)
+			out[base + k] = sum[k] / max_amp;
+	}
+}
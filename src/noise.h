@@ -11,4 +11,31 @@ double Noise_simplex2d(double x, double y);
 double Noise_fbm(double x, double y, int octaves, double frequency,
                  double lacunarity, double persistence, uint32_t seed);
 
+/* Batch fBm along a row: out[i] = Noise_fbm(x0 + i * dx, y, ...) for
+ * i in [0, count). Bit-identical to the per-sample call on every kernel,
+ * so procgen output does not depend on the CPU it ran on. */
+void Noise_fbm_row(double *out, int count, double x0, double dx, double y,
+                   int octaves, double frequency, double lacunarity,
+                   double persistence, uint32_t seed);
+
+/* Single-precision batch fBm for visual-only uses (heatmaps). Close to
+ * Noise_fbm but not bit-identical; never feed it into generation. */
+void Noise_fbm_row_f(float *out, int count, double x0, double dx, double y,
+                     int octaves, double frequency, double lacunarity,
+                     double persistence, uint32_t seed);
+
+/* SIMD kernel used by the row functions. Defaults to the best one the CPU
+ * supports; setting an unsupported kernel falls back to the best one.
+ * Only change it while no other thread is generating noise. */
+typedef enum {
+	NOISE_KERNEL_SCALAR,
+	NOISE_KERNEL_SSE2,
+	NOISE_KERNEL_AVX2,
+	NOISE_KERNEL_COUNT
+} NoiseKernel;
+
+NoiseKernel Noise_get_kernel(void);
+void        Noise_set_kernel(NoiseKernel kernel);
+const char *Noise_kernel_name(NoiseKernel kernel);
+
 #endif
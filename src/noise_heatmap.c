@@ -0,0 +1,444 @@
+#include "noise_heatmap.h"
+
+#include <OpenGL/gl3.h>
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graphics.h"
+#include "map.h"
+#include "noise.h"
+#include "render.h"
+
+/*
+ * God-mode procgen noise heatmap. The raw fBm value of every map cell
+ * lives in a single-channel float texture, one texel per cell, computed
+ * once per parameter set by a few worker threads in square tiles and
+ * uploaded tile by tile as they finish. Drawing is one quad; the wall
+ * threshold colouring happens in the fragment shader, so moving the
+ * threshold never touches the noise.
+ *
+ * Workers stamp each tile with the build generation it was taken under
+ * and only store it if that is still current, so a parameter change can
+ * restart the build without waiting for tiles in flight.
+ */
+
+#define TILE_SIZE 64
+#define TILES_PER_SIDE (MAP_SIZE / TILE_SIZE)
+#define TILE_COUNT (TILES_PER_SIDE * TILES_PER_SIDE)
+#define MAX_WORKERS 4
+/* Tiles built per frame on the main thread when no worker could start */
+#define INLINE_TILES_PER_FRAME 8
+/* Outside the fBm range; the shader skips texels still holding it */
+#define NOT_READY 2.0f
+
+/* --- Embedded GLSL 330 core shaders --- */
+
+static const char *heatmap_vert_src =
+	"#version 330 core\n"
+	"layout(location = 0) in vec2 a_position;\n"
+	"layout(location = 1) in vec2 a_texcoord;\n"
+	"uniform mat4 u_projection;\n"
+	"uniform mat4 u_view;\n"
+	"out vec2 v_texcoord;\n"
+	"void main() {\n"
+	"    gl_Position = u_projection * u_view * vec4(a_position, 0.0, 1.0);\n"
+	"    v_texcoord = a_texcoord;\n"
+	"}\n";
+
+/* Red below the threshold (wall), green above (open), yellow within
+   0.1 of it in raw noise units */
+static const char *heatmap_frag_src =
+	"#version 330 core\n"
+	"in vec2 v_texcoord;\n"
+	"uniform sampler2D u_noise;\n"
+	"uniform float u_threshold;\n"
+	"out vec4 fragColor;\n"
+	"void main() {\n"
+	"    float n = texture(u_noise, v_texcoord).r;\n"
+	"    if (n > 1.5)\n"
+	"        discard;\n"
+	"    if (abs(n - u_threshold) < 0.1)\n"
+	"        fragColor = vec4(1.0, 1.0, 0.0, 0.7);\n"
+	"    else if (n < u_threshold)\n"
+	"        fragColor = vec4(0.8, 0.1, 0.1, 0.4);\n"
+	"    else\n"
+	"        fragColor = vec4(0.1, 0.7, 0.1, 0.25);\n"
+	"}\n";
+
+/* --- GL resources --- */
+
+static GLuint heatmap_program;
+static GLint u_projection;
+static GLint u_view;
+static GLint u_noise;
+static GLint u_threshold;
+
+static GLuint noise_tex;
+static GLuint quad_vao, quad_vbo;
+
+/* --- Build state ---
+ * Everything from here to tileDone is shared with the workers and
+ * guarded by lock. */
+
+static SDL_mutex *lock = NULL;
+static SDL_cond *wake = NULL;
+static SDL_Thread *workers[MAX_WORKERS];
+static int workerCount = 0;
+static bool workersStarted = false;
+static bool quitting = false;
+
+static NoiseHeatmapParams jobParams;
+static unsigned int generation = 0;
+static int tileOrder[TILE_COUNT];
+static int nextTile = TILE_COUNT;
+static bool tileDone[TILE_COUNT];
+static float values[MAP_SIZE * MAP_SIZE];
+
+/* Main thread only */
+static bool haveParams = false;
+static NoiseHeatmapParams builtParams;
+static bool tileUploaded[TILE_COUNT];
+static int focusTileX, focusTileY;
+
+/* --- Shader helpers --- */
+
+static GLuint compile_shader(GLenum type, const char *source)
+{
+	GLuint shader = glCreateShader(type);
+	glShaderSource(shader, 1, &source, NULL);
+	glCompileShader(shader);
+
+	GLint ok;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+	if (!ok) {
+		char log[512];
+		glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+		fprintf(stderr, "NoiseHeatmap shader compile error: %s\n", log);
+		exit(1);
+	}
+	return shader;
+}
+
+static GLuint link_program(GLuint vert, GLuint frag)
+{
+	GLuint program = glCreateProgram();
+	glAttachShader(program, vert);
+	glAttachShader(program, frag);
+	glLinkProgram(program);
+
+	GLint ok;
+	glGetProgramiv(program, GL_LINK_STATUS, &ok);
+	if (!ok) {
+		char log[512];
+		glGetProgramInfoLog(program, sizeof(log), NULL, log);
+		fprintf(stderr, "NoiseHeatmap shader link error: %s\n", log);
+		exit(1);
+	}
+
+	glDeleteShader(vert);
+	glDeleteShader(frag);
+	return program;
+}
+
+/* --- Tile building --- */
+
+/* No-ops when the workers never started and the main thread builds */
+static void lock_build(void)
+{
+	if (lock)
+		SDL_LockMutex(lock);
+}
+
+static void unlock_build(void)
+{
+	if (lock)
+		SDL_UnlockMutex(lock);
+}
+
+static bool params_equal(const NoiseHeatmapParams *a, const NoiseHeatmapParams *b)
+{
+	return a->seed == b->seed && a->octaves == b->octaves &&
+		a->frequency == b->frequency && a->lacunarity == b->lacunarity &&
+		a->persistence == b->persistence;
+}
+
+static void build_tile(const NoiseHeatmapParams *p, int tile, float *out)
+{
+	int tx = (tile % TILES_PER_SIDE) * TILE_SIZE;
+	int ty = (tile / TILES_PER_SIDE) * TILE_SIZE;
+	for (int row = 0; row < TILE_SIZE; row++)
+		Noise_fbm_row_f(out + row * TILE_SIZE, TILE_SIZE,
+			(double)tx, 1.0, (double)(ty + row),
+			p->octaves, p->frequency, p->lacunarity, p->persistence, p->seed);
+}
+
+/* Caller holds lock */
+static void store_tile(int tile, unsigned int gen, const float *data)
+{
+	if (gen != generation)
+		return;
+	int tx = (tile % TILES_PER_SIDE) * TILE_SIZE;
+	int ty = (tile / TILES_PER_SIDE) * TILE_SIZE;
+	for (int row = 0; row < TILE_SIZE; row++)
+		memcpy(&values[(ty + row) * MAP_SIZE + tx], data + row * TILE_SIZE,
+			TILE_SIZE * sizeof(float));
+	tileDone[tile] = true;
+}
+
+static int worker_main(void *unused)
+{
+	(void)unused;
+	float tile_values[TILE_SIZE * TILE_SIZE];
+
+	SDL_LockMutex(lock);
+	for (;;) {
+		while (!quitting && nextTile >= TILE_COUNT)
+			SDL_CondWait(wake, lock);
+		if (quitting)
+			break;
+
+		int tile = tileOrder[nextTile++];
+		NoiseHeatmapParams p = jobParams;
+		unsigned int gen = generation;
+		SDL_UnlockMutex(lock);
+
+		build_tile(&p, tile, tile_values);
+
+		SDL_LockMutex(lock);
+		store_tile(tile, gen, tile_values);
+	}
+	SDL_UnlockMutex(lock);
+	return 0;
+}
+
+/* Started on first use so the threads only exist once god mode asks */
+static void start_workers(void)
+{
+	workersStarted = true;
+
+	int count = SDL_GetCPUCount() - 1;
+	if (count > MAX_WORKERS)
+		count = MAX_WORKERS;
+	if (count < 1)
+		return;
+
+	lock = SDL_CreateMutex();
+	wake = SDL_CreateCond();
+	if (!lock || !wake) {
+		printf("WARNING: NoiseHeatmap: no mutex, building on the main thread\n");
+		return;
+	}
+
+	quitting = false;
+	for (int i = 0; i < count; i++) {
+		workers[workerCount] = SDL_CreateThread(worker_main, "heatmap", NULL);
+		if (!workers[workerCount]) {
+			printf("WARNING: NoiseHeatmap: failed to start worker: %s\n", SDL_GetError());
+			break;
+		}
+		workerCount++;
+	}
+}
+
+static void stop_workers(void)
+{
+	if (lock) {
+		SDL_LockMutex(lock);
+		quitting = true;
+		SDL_CondBroadcast(wake);
+		SDL_UnlockMutex(lock);
+	}
+	for (int i = 0; i < workerCount; i++)
+		SDL_WaitThread(workers[i], NULL);
+	workerCount = 0;
+
+	if (wake) {
+		SDL_DestroyCond(wake);
+		wake = NULL;
+	}
+	if (lock) {
+		SDL_DestroyMutex(lock);
+		lock = NULL;
+	}
+	workersStarted = false;
+}
+
+static int compare_tile_distance(const void *a, const void *b)
+{
+	int ta = *(const int *)a, tb = *(const int *)b;
+	int ax = ta % TILES_PER_SIDE - focusTileX, ay = ta / TILES_PER_SIDE - focusTileY;
+	int bx = tb % TILES_PER_SIDE - focusTileX, by = tb / TILES_PER_SIDE - focusTileY;
+	int da = ax * ax + ay * ay, db = bx * bx + by * by;
+	if (da != db)
+		return da < db ? -1 : 1;
+	return ta - tb;
+}
+
+static void start_build(const NoiseHeatmapParams *params, double focus_x, double focus_y)
+{
+	focusTileX = ((int)(focus_x / MAP_CELL_SIZE) + HALF_MAP_SIZE) / TILE_SIZE;
+	focusTileY = ((int)(focus_y / MAP_CELL_SIZE) + HALF_MAP_SIZE) / TILE_SIZE;
+
+	int order[TILE_COUNT];
+	for (int t = 0; t < TILE_COUNT; t++)
+		order[t] = t;
+	qsort(order, TILE_COUNT, sizeof(int), compare_tile_distance);
+
+	lock_build();
+	jobParams = *params;
+	generation++;
+	memcpy(tileOrder, order, sizeof(order));
+	nextTile = 0;
+	memset(tileDone, 0, sizeof(tileDone));
+	for (int i = 0; i < MAP_SIZE * MAP_SIZE; i++)
+		values[i] = NOT_READY;
+
+	/* Clear the texture while no worker can be storing into values */
+	glBindTexture(GL_TEXTURE_2D, noise_tex);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, MAP_SIZE, MAP_SIZE, 0,
+		GL_RED, GL_FLOAT, values);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	if (wake)
+		SDL_CondBroadcast(wake);
+	unlock_build();
+
+	memset(tileUploaded, 0, sizeof(tileUploaded));
+	builtParams = *params;
+	haveParams = true;
+}
+
+static void build_inline(int budget)
+{
+	float tile_values[TILE_SIZE * TILE_SIZE];
+	while (budget-- > 0 && nextTile < TILE_COUNT) {
+		int tile = tileOrder[nextTile++];
+		build_tile(&jobParams, tile, tile_values);
+		store_tile(tile, generation, tile_values);
+	}
+}
+
+static void upload_finished_tiles(void)
+{
+	bool bound = false;
+
+	lock_build();
+	for (int t = 0; t < TILE_COUNT; t++) {
+		if (!tileDone[t] || tileUploaded[t])
+			continue;
+		if (!bound) {
+			glBindTexture(GL_TEXTURE_2D, noise_tex);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, MAP_SIZE);
+			bound = true;
+		}
+		int tx = (t % TILES_PER_SIDE) * TILE_SIZE;
+		int ty = (t / TILES_PER_SIDE) * TILE_SIZE;
+		glTexSubImage2D(GL_TEXTURE_2D, 0, tx, ty, TILE_SIZE, TILE_SIZE,
+			GL_RED, GL_FLOAT, &values[ty * MAP_SIZE + tx]);
+		tileUploaded[t] = true;
+	}
+	unlock_build();
+
+	if (bound) {
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+}
+
+/* --- Public API --- */
+
+void NoiseHeatmap_initialize(void)
+{
+	GLuint vert = compile_shader(GL_VERTEX_SHADER, heatmap_vert_src);
+	GLuint frag = compile_shader(GL_FRAGMENT_SHADER, heatmap_frag_src);
+	heatmap_program = link_program(vert, frag);
+
+	u_projection = glGetUniformLocation(heatmap_program, "u_projection");
+	u_view = glGetUniformLocation(heatmap_program, "u_view");
+	u_noise = glGetUniformLocation(heatmap_program, "u_noise");
+	u_threshold = glGetUniformLocation(heatmap_program, "u_threshold");
+
+	/* Nearest sampling: one flat colour per cell, like the old quads */
+	glGenTextures(1, &noise_tex);
+	glBindTexture(GL_TEXTURE_2D, noise_tex);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	/* Covers the whole map; texel (gx, gy) lands on world cell
+	   gx - HALF_MAP_SIZE, gy - HALF_MAP_SIZE */
+	float lo = (float)(-HALF_MAP_SIZE * MAP_CELL_SIZE);
+	float hi = (float)((MAP_SIZE - HALF_MAP_SIZE) * MAP_CELL_SIZE);
+	float verts[] = {
+		lo, lo, 0.0f, 0.0f,
+		hi, lo, 1.0f, 0.0f,
+		hi, hi, 1.0f, 1.0f,
+
+		lo, lo, 0.0f, 0.0f,
+		hi, hi, 1.0f, 1.0f,
+		lo, hi, 0.0f, 1.0f,
+	};
+	glGenVertexArrays(1, &quad_vao);
+	glGenBuffers(1, &quad_vbo);
+	glBindVertexArray(quad_vao);
+	glBindBuffer(GL_ARRAY_BUFFER, quad_vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE,
+		4 * sizeof(float), (void *)0);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE,
+		4 * sizeof(float), (void *)(2 * sizeof(float)));
+	glBindVertexArray(0);
+
+	/* The new texture is empty; rebuild on next use */
+	haveParams = false;
+}
+
+void NoiseHeatmap_cleanup(void)
+{
+	stop_workers();
+	haveParams = false;
+	nextTile = TILE_COUNT;
+
+	glDeleteTextures(1, &noise_tex);
+	glDeleteBuffers(1, &quad_vbo);
+	glDeleteVertexArrays(1, &quad_vao);
+	glDeleteProgram(heatmap_program);
+}
+
+void NoiseHeatmap_render(const NoiseHeatmapParams *params, double threshold,
+	const Mat4 *world_proj, const Mat4 *view, double focus_x, double focus_y)
+{
+	if (!workersStarted)
+		start_workers();
+	if (!haveParams || !params_equal(params, &builtParams))
+		start_build(params, focus_x, focus_y);
+	if (workerCount == 0)
+		build_inline(INLINE_TILES_PER_FRAME);
+	upload_finished_tiles();
+
+	/* Overlays batched so far go underneath */
+	Render_flush(world_proj, view);
+
+	glUseProgram(heatmap_program);
+	glUniformMatrix4fv(u_projection, 1, GL_FALSE, world_proj->m);
+	glUniformMatrix4fv(u_view, 1, GL_FALSE, view->m);
+	glUniform1i(u_noise, 0);
+	glUniform1f(u_threshold, (float)threshold);
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, noise_tex);
+
+	glBindVertexArray(quad_vao);
+	glDrawArrays(GL_TRIANGLES, 0, 6);
+	glBindVertexArray(0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	/* Restore color shader so subsequent overlay rendering works */
+	glUseProgram(Graphics_get_shaders()->color_shader.program);
+}
@@ -0,0 +1,30 @@
+#ifndef NOISE_HEATMAP_H
+#define NOISE_HEATMAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mat4.h"
+
+/* Everything the heatmap values depend on. The wall threshold is not
+   part of it: that is applied when drawing. */
+typedef struct {
+	uint32_t seed;
+	int octaves;
+	double frequency;
+	double lacunarity;
+	double persistence;
+} NoiseHeatmapParams;
+
+void NoiseHeatmap_initialize(void);
+/* Stops the build workers and releases GL resources */
+void NoiseHeatmap_cleanup(void);
+
+/* Draw the fBm heatmap over the whole map as one textured quad, flushing
+   the batch first so it layers correctly. A params change restarts the
+   build in the background, tiles nearest (focus_x, focus_y) first;
+   unfinished tiles are simply not drawn yet. */
+void NoiseHeatmap_render(const NoiseHeatmapParams *params, double threshold,
+	const Mat4 *world_proj, const Mat4 *view, double focus_x, double focus_y);
+
+#endif
@@ -30,7 +30,7 @@ typedef struct {
 
 static PortalState portals[PORTAL_COUNT];
 static PlaceableComponent placeables[PORTAL_COUNT];
-static Entity *entityRefs[PORTAL_COUNT];
+static EntityHandle entityRefs[PORTAL_COUNT];
 static int portalCount = 0;
 
 static RenderableComponent renderable = {.passes = {[RENDER_PASS_MAIN] = Portal_render}};
@@ -70,7 +70,7 @@ void Portal_initialize(Position position, const char *id,
 	entity.placeable = &placeables[portalCount];
 	entity.renderable = &renderable;
 
-	entityRefs[portalCount] = Entity_add_entity(entity);
+	entityRefs[portalCount] = Entity_create(entity);
 
 	portalCount++;
 }
@@ -78,10 +78,8 @@ void Portal_initialize(Position position, const char *id,
 void Portal_cleanup(void)
 {
 	for (int i = 0; i < portalCount; i++) {
-		if (entityRefs[i]) {
-			entityRefs[i]->empty = true;
-			entityRefs[i] = NULL;
-		}
+		Entity_release(entityRefs[i]);
+		entityRefs[i] = (EntityHandle){0, 0};
 	}
 	portalCount = 0;
 	pendingTransition = false;
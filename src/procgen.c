@@ -3,13 +3,16 @@
 #include "obstacle.h"
 #include "noise.h"
 #include "prng.h"
+#include "timer.h"
 
+#include <SDL2/SDL.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
 
 static uint32_t master_seed = 0;
+static ProcgenTimings timings;
 
 /* --- Debug data (accessible for godmode rendering) --- */
 
@@ -755,22 +758,31 @@ static void erode_landmark_edges(Zone *zone, uint32_t zone_seed)
 	printf("Procgen: eroded %d wall cells near landmark edges\n", eroded);
 }
 
+const ProcgenTimings *Procgen_get_timings(void)
+{
+	return &timings;
+}
+
 void Procgen_generate(Zone *zone)
 {
+	memset(&timings, 0, sizeof(timings));
 	if (!zone->procgen) return;
 
 	uint32_t zone_seed = Procgen_derive_zone_seed(master_seed, zone->filepath);
 	debug_zone_seed = zone_seed;
 	Prng rng;
 	Prng_seed(&rng, zone_seed);
+	Uint64 lap = SDL_GetPerformanceCounter();
 
 	/* ─── Hotspot Generation ─── */
 	Hotspot hotspots[MAX_HOTSPOTS];
 	int hotspot_count = generate_hotspots(zone, &rng, hotspots);
+	timings.hotspots = timer_lap_ms(&lap);
 
 	/* ─── Landmark Resolution ─── */
 	PlacedLandmark placed[ZONE_MAX_LANDMARKS];
 	int placed_count = resolve_landmarks(zone, &rng, hotspots, hotspot_count, placed);
+	timings.landmarks = timer_lap_ms(&lap);
 
 	/* Store debug data */
 	debug_hotspot_count = hotspot_count;
@@ -800,7 +812,26 @@ void Procgen_generate(Zone *zone)
 	int walls_placed = 0;
 	uint32_t vein_seed = zone_seed + 12345u;
 
+	/* Noise is evaluated a row at a time through the batch kernel, which
+	   matches Noise_fbm bit for bit. Vein noise is only needed under
+	   walls, but a whole batched row still costs less than per-cell calls. */
+	double noise_row[MAP_SIZE];
+	double vein_row[MAP_SIZE];
+
 	for (int y = 0; y < zone->size; y++) {
+		Noise_fbm_row(noise_row, zone->size, 0.0, 1.0, (double)y,
+			zone->noise_octaves,
+			zone->noise_frequency,
+			zone->noise_lacunarity,
+			zone->noise_persistence,
+			zone_seed);
+		if (has_both)
+			Noise_fbm_row(vein_row, zone->size, 0.0, 1.0, (double)y,
+				CIRCUIT_VEIN_OCTAVES,
+				CIRCUIT_VEIN_FREQ,
+				2.0, 0.5,
+				vein_seed);
+
 		for (int x = 0; x < zone->size; x++) {
 			/* Always consume PRNG for determinism */
 			Prng_float(&rng);
@@ -810,14 +841,7 @@ void Procgen_generate(Zone *zone)
 			if (zone->cell_chunk_stamped[x][y])
 				continue;
 
-			double noise_val = Noise_fbm(
-				(double)x, (double)y,
-				zone->noise_octaves,
-				zone->noise_frequency,
-				zone->noise_lacunarity,
-				zone->noise_persistence,
-				zone_seed
-			);
+			double noise_val = noise_row[x];
 
 			/* Influence-modulated wall threshold */
 			double wall_thresh = compute_wall_threshold(
@@ -826,29 +850,24 @@ void Procgen_generate(Zone *zone)
 
 			if (noise_val < wall_thresh) {
 				int wall_type = default_wall;
-				if (has_both) {
-					double vein = Noise_fbm(
-						(double)x, (double)y,
-						CIRCUIT_VEIN_OCTAVES,
-						CIRCUIT_VEIN_FREQ,
-						2.0, 0.5,
-						vein_seed
-					);
-					wall_type = (vein > CIRCUIT_VEIN_THRESHOLD)
+				if (has_both)
+					wall_type = (vein_row[x] > CIRCUIT_VEIN_THRESHOLD)
 						? circuit_idx : solid_idx;
-				}
 				zone->cell_grid[x][y] = wall_type;
 				walls_placed++;
 			}
 			/* else: leave as -1 (empty space over cloudscape) */
 		}
 	}
+	timings.terrain = timer_lap_ms(&lap);
 
 	/* ─── Landmark Edge Erosion ─── */
 	erode_landmark_edges(zone, zone_seed);
+	timings.erosion = timer_lap_ms(&lap);
 
 	/* ─── Obstacle Scatter ─── */
 	scatter_obstacles(zone, &rng, placed, placed_count);
+	timings.obstacles = timer_lap_ms(&lap);
 
 	printf("Procgen_generate: seed=%u zone_seed=%u walls=%d hotspots=%d landmarks=%d\n",
 	       master_seed, zone_seed, walls_placed, hotspot_count, placed_count);
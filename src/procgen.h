@@ -27,6 +27,17 @@ void     Procgen_get_landmark(int i, int *x, int *y, const char **type,
 
 uint32_t Procgen_get_zone_seed(void);
 
+/* Phase timings of the last Procgen_generate, in milliseconds
+ * (see bench/bench_zone.c) */
+typedef struct {
+	double hotspots;
+	double landmarks;   /* resolution and chunk stamping */
+	double terrain;     /* noise + influence pass */
+	double erosion;
+	double obstacles;
+} ProcgenTimings;
+const ProcgenTimings *Procgen_get_timings(void);
+
 /* Query influence strength at a grid position (0.0–1.0).
  * Returns 0 if no landmarks are placed yet. */
 float    Procgen_get_influence_strength(int gx, int gy);
@@ -0,0 +1,504 @@
+#include "save_file.h"
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#define SAVE_HEADER_SIZE 8
+#define SAVE_SECTION_HEADER_SIZE 12
+
+/* --- I/O thread --- */
+
+typedef struct {
+	uint8_t *data;
+	size_t size;
+	char path[512];
+} PendingWrite;
+
+static SDL_Thread *thread = NULL;
+static SDL_mutex *lock = NULL;
+static SDL_cond *wake = NULL;     /* a write was queued, or quitting */
+static SDL_cond *idle = NULL;     /* a write finished */
+static PendingWrite pending;
+static bool pendingValid = false;
+static bool writing = false;
+static bool quitting = false;
+
+static void make_parent_dir(const char *path)
+{
+	char dir[512];
+	const char *slash = strrchr(path, '/');
+	if (!slash || slash == path)
+		return;
+	snprintf(dir, sizeof(dir), "%.*s", (int)(slash - path), path);
+#ifdef _WIN32
+	_mkdir(dir);
+#else
+	mkdir(dir, 0755);
+#endif
+}
+
+/* Push the file's data to the disk, not just the OS cache */
+static bool sync_file(FILE *f)
+{
+#ifdef _WIN32
+	return _commit(_fileno(f)) == 0;
+#else
+	return fsync(fileno(f)) == 0;
+#endif
+}
+
+/* Write to path.tmp, then rename over path so readers only ever see a
+   complete file */
+static void write_file(const char *path, const uint8_t *data, size_t size)
+{
+	char tmp[520];
+	snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+	make_parent_dir(path);
+
+	FILE *f = fopen(tmp, "wb");
+	if (!f) {
+		printf("WARNING: save: failed to open %s for writing\n", tmp);
+		return;
+	}
+	bool ok = fwrite(data, 1, size, f) == size;
+	ok = fflush(f) == 0 && ok;
+	/* Without this a power cut after the rename can leave the new name
+	   pointing at a truncated file */
+	ok = ok && sync_file(f);
+	ok = fclose(f) == 0 && ok;
+	if (!ok) {
+		printf("WARNING: save: failed to write %s\n", tmp);
+		remove(tmp);
+		return;
+	}
+
+#ifdef _WIN32
+	/* rename() does not replace an existing file on Windows */
+	remove(path);
+#endif
+	if (rename(tmp, path) != 0) {
+		printf("WARNING: save: failed to move %s into place\n", tmp);
+		remove(tmp);
+	}
+}
+
+static int worker_main(void *unused)
+{
+	(void)unused;
+	SDL_LockMutex(lock);
+	for (;;) {
+		while (!pendingValid && !quitting)
+			SDL_CondWait(wake, lock);
+		if (!pendingValid)
+			break;
+
+		PendingWrite job = pending;
+		pendingValid = false;
+		writing = true;
+		SDL_UnlockMutex(lock);
+
+		write_file(job.path, job.data, job.size);
+		free(job.data);
+
+		SDL_LockMutex(lock);
+		writing = false;
+		SDL_CondBroadcast(idle);
+	}
+	SDL_UnlockMutex(lock);
+	return 0;
+}
+
+void SaveFile_initialize(void)
+{
+	if (thread)
+		return;
+
+	lock = SDL_CreateMutex();
+	wake = SDL_CreateCond();
+	idle = SDL_CreateCond();
+	if (!lock || !wake || !idle) {
+		SaveFile_cleanup();
+		return;
+	}
+
+	quitting = false;
+	thread = SDL_CreateThread(worker_main, "save_io", NULL);
+	if (!thread) {
+		printf("WARNING: save: failed to start I/O thread, saving inline: %s\n",
+			SDL_GetError());
+		SaveFile_cleanup();
+	}
+}
+
+void SaveFile_cleanup(void)
+{
+	if (thread) {
+		SDL_LockMutex(lock);
+		quitting = true;
+		SDL_CondSignal(wake);
+		SDL_UnlockMutex(lock);
+		/* The worker drains the queued write before it exits */
+		SDL_WaitThread(thread, NULL);
+		thread = NULL;
+	}
+	if (idle) {
+		SDL_DestroyCond(idle);
+		idle = NULL;
+	}
+	if (wake) {
+		SDL_DestroyCond(wake);
+		wake = NULL;
+	}
+	if (lock) {
+		SDL_DestroyMutex(lock);
+		lock = NULL;
+	}
+}
+
+/* --- Checksum --- */
+
+static uint32_t crc_table[256];
+static bool crcReady = false;
+
+static uint32_t crc32(const uint8_t *data, size_t n)
+{
+	if (!crcReady) {
+		for (uint32_t i = 0; i < 256; i++) {
+			uint32_t c = i;
+			for (int k = 0; k < 8; k++)
+				c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+			crc_table[i] = c;
+		}
+		crcReady = true;
+	}
+
+	uint32_t c = 0xFFFFFFFFu;
+	for (size_t i = 0; i < n; i++)
+		c = crc_table[(c ^ data[i]) & 0xFF] ^ (c >> 8);
+	return c ^ 0xFFFFFFFFu;
+}
+
+static void store_u16(uint8_t *p, uint16_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+}
+
+static void store_u32(uint8_t *p, uint32_t v)
+{
+	for (int i = 0; i < 4; i++)
+		p[i] = (uint8_t)(v >> (i * 8));
+}
+
+static uint32_t load_u32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | (uint32_t)p[1] << 8 |
+		(uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+/* --- Writing --- */
+
+static bool reserve(SaveWriter *w, size_t n)
+{
+	if (w->failed)
+		return false;
+	if (w->size + n <= w->capacity)
+		return true;
+
+	size_t cap = w->capacity ? w->capacity : 4096;
+	while (cap < w->size + n)
+		cap *= 2;
+	uint8_t *grown = realloc(w->data, cap);
+	if (!grown) {
+		printf("WARNING: save: out of memory building save data\n");
+		w->failed = true;
+		return false;
+	}
+	w->data = grown;
+	w->capacity = cap;
+	return true;
+}
+
+void SaveFile_begin(SaveWriter *w)
+{
+	memset(w, 0, sizeof(*w));
+	if (!reserve(w, SAVE_HEADER_SIZE))
+		return;
+	memcpy(w->data, SAVE_FILE_MAGIC, 4);
+	store_u16(w->data + 4, SAVE_FILE_VERSION);
+	store_u16(w->data + 6, 0);
+	w->size = SAVE_HEADER_SIZE;
+}
+
+void SaveFile_begin_section(SaveWriter *w, uint32_t tag)
+{
+	if (!reserve(w, SAVE_SECTION_HEADER_SIZE))
+		return;
+	w->sectionStart = w->size;
+	store_u32(w->data + w->size, tag);
+	w->size += SAVE_SECTION_HEADER_SIZE;
+}
+
+void SaveFile_end_section(SaveWriter *w)
+{
+	if (w->failed)
+		return;
+	uint8_t *header = w->data + w->sectionStart;
+	const uint8_t *payload = header + SAVE_SECTION_HEADER_SIZE;
+	size_t len = w->size - w->sectionStart - SAVE_SECTION_HEADER_SIZE;
+	store_u32(header + 4, (uint32_t)len);
+	store_u32(header + 8, crc32(payload, len));
+	w->sectionCount++;
+	store_u16(w->data + 6, (uint16_t)w->sectionCount);
+}
+
+void SaveFile_put_bytes(SaveWriter *w, const void *src, size_t n)
+{
+	if (!reserve(w, n))
+		return;
+	memcpy(w->data + w->size, src, n);
+	w->size += n;
+}
+
+void SaveFile_put_u8(SaveWriter *w, uint8_t v)
+{
+	SaveFile_put_bytes(w, &v, 1);
+}
+
+void SaveFile_put_u16(SaveWriter *w, uint16_t v)
+{
+	uint8_t b[2];
+	store_u16(b, v);
+	SaveFile_put_bytes(w, b, 2);
+}
+
+void SaveFile_put_u32(SaveWriter *w, uint32_t v)
+{
+	uint8_t b[4];
+	store_u32(b, v);
+	SaveFile_put_bytes(w, b, 4);
+}
+
+void SaveFile_put_i32(SaveWriter *w, int32_t v)
+{
+	SaveFile_put_u32(w, (uint32_t)v);
+}
+
+void SaveFile_put_f64(SaveWriter *w, double v)
+{
+	uint64_t bits;
+	memcpy(&bits, &v, sizeof(bits));
+	SaveFile_put_u32(w, (uint32_t)bits);
+	SaveFile_put_u32(w, (uint32_t)(bits >> 32));
+}
+
+void SaveFile_put_str(SaveWriter *w, const char *s)
+{
+	size_t len = strlen(s);
+	if (len > 0xFFFF)
+		len = 0xFFFF;
+	SaveFile_put_u16(w, (uint16_t)len);
+	SaveFile_put_bytes(w, s, len);
+}
+
+void SaveFile_write_async(SaveWriter *w, const char *path)
+{
+	if (w->failed || !w->data) {
+		printf("WARNING: save: incomplete save data for %s, not written\n", path);
+		SaveFile_discard(w);
+		return;
+	}
+
+	if (!thread) {
+		write_file(path, w->data, w->size);
+		SaveFile_discard(w);
+		return;
+	}
+
+	SDL_LockMutex(lock);
+	if (pendingValid)
+		free(pending.data);
+	pending.data = w->data;
+	pending.size = w->size;
+	snprintf(pending.path, sizeof(pending.path), "%s", path);
+	pendingValid = true;
+	SDL_CondSignal(wake);
+	SDL_UnlockMutex(lock);
+
+	memset(w, 0, sizeof(*w));
+}
+
+void SaveFile_flush(void)
+{
+	if (!thread)
+		return;
+	SDL_LockMutex(lock);
+	while (pendingValid || writing)
+		SDL_CondWait(idle, lock);
+	SDL_UnlockMutex(lock);
+}
+
+void SaveFile_discard(SaveWriter *w)
+{
+	free(w->data);
+	memset(w, 0, sizeof(*w));
+}
+
+/* --- Reading --- */
+
+bool SaveFile_load(const char *path, SaveFile *file, bool *is_container)
+{
+	memset(file, 0, sizeof(*file));
+	*is_container = false;
+
+	FILE *f = fopen(path, "rb");
+	if (!f)
+		return false;
+
+	uint8_t *data = NULL;
+	long size = -1;
+	if (fseek(f, 0, SEEK_END) == 0)
+		size = ftell(f);
+	if (size >= SAVE_HEADER_SIZE && fseek(f, 0, SEEK_SET) == 0) {
+		data = malloc((size_t)size);
+		if (data && fread(data, 1, (size_t)size, f) != (size_t)size) {
+			free(data);
+			data = NULL;
+		}
+	}
+	fclose(f);
+	if (!data)
+		return false;
+
+	if (memcmp(data, SAVE_FILE_MAGIC, 4) != 0) {
+		free(data);
+		return false;
+	}
+	*is_container = true;
+
+	int version = data[4] | data[5] << 8;
+	if (version > SAVE_FILE_VERSION) {
+		printf("WARNING: save: %s is version %d, newer than this build (%d)\n",
+			path, version, SAVE_FILE_VERSION);
+		free(data);
+		return false;
+	}
+
+	/* Verify the whole section table up front */
+	int count = data[6] | data[7] << 8;
+	size_t pos = SAVE_HEADER_SIZE;
+	for (int i = 0; i < count; i++) {
+		if ((size_t)size - pos < SAVE_SECTION_HEADER_SIZE) {
+			printf("WARNING: save: %s is truncated\n", path);
+			free(data);
+			return false;
+		}
+		uint32_t len = load_u32(data + pos + 4);
+		uint32_t crc = load_u32(data + pos + 8);
+		pos += SAVE_SECTION_HEADER_SIZE;
+		if ((size_t)size - pos < len || crc32(data + pos, len) != crc) {
+			printf("WARNING: save: %s section %d is damaged\n", path, i);
+			free(data);
+			return false;
+		}
+		pos += len;
+	}
+
+	file->data = data;
+	file->size = pos;
+	file->version = version;
+	return true;
+}
+
+void SaveFile_free(SaveFile *file)
+{
+	free(file->data);
+	memset(file, 0, sizeof(*file));
+}
+
+bool SaveFile_find_section(const SaveFile *file, uint32_t tag, SaveReader *r)
+{
+	memset(r, 0, sizeof(*r));
+	if (!file->data)
+		return false;
+
+	size_t pos = SAVE_HEADER_SIZE;
+	while (pos + SAVE_SECTION_HEADER_SIZE <= file->size) {
+		uint32_t len = load_u32(file->data + pos + 4);
+		if (load_u32(file->data + pos) == tag) {
+			r->data = file->data + pos + SAVE_SECTION_HEADER_SIZE;
+			r->size = len;
+			return true;
+		}
+		pos += SAVE_SECTION_HEADER_SIZE + len;
+	}
+	return false;
+}
+
+void SaveFile_get_bytes(SaveReader *r, void *dst, size_t n)
+{
+	if (r->failed || r->size - r->pos < n) {
+		r->failed = true;
+		memset(dst, 0, n);
+		return;
+	}
+	memcpy(dst, r->data + r->pos, n);
+	r->pos += n;
+}
+
+uint8_t SaveFile_get_u8(SaveReader *r)
+{
+	uint8_t v;
+	SaveFile_get_bytes(r, &v, 1);
+	return v;
+}
+
+uint16_t SaveFile_get_u16(SaveReader *r)
+{
+	uint8_t b[2];
+	SaveFile_get_bytes(r, b, 2);
+	return (uint16_t)(b[0] | b[1] << 8);
+}
+
+uint32_t SaveFile_get_u32(SaveReader *r)
+{
+	uint8_t b[4];
+	SaveFile_get_bytes(r, b, 4);
+	return load_u32(b);
+}
+
+int32_t SaveFile_get_i32(SaveReader *r)
+{
+	return (int32_t)SaveFile_get_u32(r);
+}
+
+double SaveFile_get_f64(SaveReader *r)
+{
+	uint64_t bits = SaveFile_get_u32(r);
+	bits |= (uint64_t)SaveFile_get_u32(r) << 32;
+	double v;
+	memcpy(&v, &bits, sizeof(v));
+	return v;
+}
+
+void SaveFile_get_str(SaveReader *r, char *out, size_t out_size)
+{
+	size_t len = SaveFile_get_u16(r);
+	if (r->failed || r->size - r->pos < len) {
+		r->failed = true;
+		out[0] = '\0';
+		return;
+	}
+	size_t keep = len < out_size - 1 ? len : out_size - 1;
+	memcpy(out, r->data + r->pos, keep);
+	out[keep] = '\0';
+	r->pos += len;
+}
@@ -0,0 +1,97 @@
+#ifndef SAVE_FILE_H
+#define SAVE_FILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Binary save container. Layout (all integers little-endian):
+ *
+ *   "HSAV"  u16 version  u16 section count
+ *   per section:  u32 tag  u32 length  u32 crc32  payload[length]
+ *
+ * The main thread builds the whole file in memory with a SaveWriter and
+ * hands the buffer to a background I/O thread, which writes it to a
+ * temporary file and renames it over the old save. A crash mid-write
+ * leaves the previous save intact. Readers skip sections with unknown
+ * tags and reject any section whose checksum does not match.
+ */
+#define SAVE_FILE_MAGIC "HSAV"
+#define SAVE_FILE_VERSION 2
+
+#define SAVE_TAG(a, b, c, d) ((uint32_t)(a) | (uint32_t)(b) << 8 | \
+	(uint32_t)(c) << 16 | (uint32_t)(d) << 24)
+
+typedef struct {
+	uint8_t *data;
+	size_t size;
+	size_t capacity;
+	size_t sectionStart;   /* offset of the open section's header */
+	int sectionCount;
+	bool failed;           /* allocation failed; the buffer is incomplete */
+} SaveWriter;
+
+/* Cursor over one section's payload. Reads past the end return zeros and
+   set failed, so callers can read a whole section and check once. */
+typedef struct {
+	const uint8_t *data;
+	size_t size;
+	size_t pos;
+	bool failed;
+} SaveReader;
+
+/* A loaded file with its section table verified */
+typedef struct {
+	uint8_t *data;
+	size_t size;
+	int version;
+} SaveFile;
+
+void SaveFile_initialize(void);
+/* Finishes any queued write before stopping the I/O thread */
+void SaveFile_cleanup(void);
+
+/* --- Writing --- */
+
+void SaveFile_begin(SaveWriter *w);
+void SaveFile_begin_section(SaveWriter *w, uint32_t tag);
+void SaveFile_end_section(SaveWriter *w);
+void SaveFile_put_u8(SaveWriter *w, uint8_t v);
+void SaveFile_put_u16(SaveWriter *w, uint16_t v);
+void SaveFile_put_u32(SaveWriter *w, uint32_t v);
+void SaveFile_put_i32(SaveWriter *w, int32_t v);
+void SaveFile_put_f64(SaveWriter *w, double v);
+void SaveFile_put_bytes(SaveWriter *w, const void *src, size_t n);
+/* u16 length, then the bytes (no terminator) */
+void SaveFile_put_str(SaveWriter *w, const char *s);
+
+/* Queue the buffer for writing to path and take ownership of it; the
+   writer is left empty. A queued write that has not started yet is
+   replaced, since only the newest save matters. Runs inline if the I/O
+   thread could not be started. */
+void SaveFile_write_async(SaveWriter *w, const char *path);
+/* Block until every queued write has reached disk */
+void SaveFile_flush(void);
+/* Free a writer that will not be written */
+void SaveFile_discard(SaveWriter *w);
+
+/* --- Reading --- */
+
+/* False if the file is missing, not a container, a newer version, or any
+   section fails its checksum. is_container tells a foreign file (e.g. an
+   older text save) from a damaged one. */
+bool SaveFile_load(const char *path, SaveFile *file, bool *is_container);
+void SaveFile_free(SaveFile *file);
+bool SaveFile_find_section(const SaveFile *file, uint32_t tag, SaveReader *r);
+
+uint8_t SaveFile_get_u8(SaveReader *r);
+uint16_t SaveFile_get_u16(SaveReader *r);
+uint32_t SaveFile_get_u32(SaveReader *r);
+int32_t SaveFile_get_i32(SaveReader *r);
+double SaveFile_get_f64(SaveReader *r);
+void SaveFile_get_bytes(SaveReader *r, void *dst, size_t n);
+/* Copies at most out_size - 1 bytes and always terminates */
+void SaveFile_get_str(SaveReader *r, char *out, size_t out_size);
+
+#endif
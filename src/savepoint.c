@@ -10,11 +10,11 @@
 #include "procgen.h"
 #include "fog_of_war.h"
 #include "data_node.h"
+#include "save_file.h"
 
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
-#include <sys/stat.h>
 
 #define DWELL_THRESHOLD_MS 1000
 #define FLASH_DURATION_MS 450
@@ -30,6 +30,14 @@
 
 #define SAVEPOINT_CHARGE_CHANNEL 4
 
+/* Save container sections */
+#define SAVE_SECTION_CHECKPOINT SAVE_TAG('C', 'K', 'P', 'T')
+#define SAVE_SECTION_PROGRESSION SAVE_TAG('P', 'R', 'O', 'G')
+#define SAVE_SECTION_FRAGMENTS SAVE_TAG('F', 'R', 'A', 'G')
+#define SAVE_SECTION_SKILLBAR SAVE_TAG('S', 'K', 'B', 'R')
+#define SAVE_SECTION_DATANODES SAVE_TAG('D', 'N', 'O', 'D')
+#define SAVE_SECTION_FOG SAVE_TAG('F', 'O', 'G', 'W')
+
 /* Must stay in sync with FragmentType enum order */
 static const char *frag_names[] = {
 	"mine", "boost", "mgun", "egress", "mend", "aegis", "gravwell", "stealth",
@@ -79,7 +87,7 @@ typedef struct {
 
 static SavepointState savepoints[SAVEPOINT_COUNT];
 static PlaceableComponent placeables[SAVEPOINT_COUNT];
-static Entity *entityRefs[SAVEPOINT_COUNT];
+static EntityHandle entityRefs[SAVEPOINT_COUNT];
 static int savepointCount = 0;
 
 static RenderableComponent renderable = {.passes = {[RENDER_PASS_MAIN] = Savepoint_render}};
@@ -117,6 +125,58 @@ static void load_audio(void)
 	audioLoaded = true;
 }
 
+static void write_checkpoint(SaveWriter *w)
+{
+	SaveFile_begin_section(w, SAVE_SECTION_CHECKPOINT);
+	SaveFile_put_str(w, checkpoint.zone_path);
+	SaveFile_put_str(w, checkpoint.savepoint_id);
+	SaveFile_put_f64(w, checkpoint.position.x);
+	SaveFile_put_f64(w, checkpoint.position.y);
+	SaveFile_put_u32(w, checkpoint.procgen_seed);
+	SaveFile_end_section(w);
+
+	/* Subs and fragments are keyed by name, as in the text format, so
+	   adding or reordering enum entries doesn't remap old saves.
+	   Progression flags: bit 0 unlocked, bit 1 discovered. */
+	SaveFile_begin_section(w, SAVE_SECTION_PROGRESSION);
+	SaveFile_put_u16(w, SUB_ID_COUNT);
+	for (int i = 0; i < SUB_ID_COUNT; i++) {
+		SaveFile_put_str(w, Skillbar_get_sub_name(i));
+		SaveFile_put_u8(w, (uint8_t)(checkpoint.unlocked[i] | checkpoint.discovered[i] << 1));
+	}
+	SaveFile_end_section(w);
+
+	SaveFile_begin_section(w, SAVE_SECTION_FRAGMENTS);
+	SaveFile_put_u16(w, FRAG_TYPE_COUNT);
+	for (int i = 0; i < FRAG_TYPE_COUNT; i++) {
+		SaveFile_put_str(w, frag_names[i]);
+		SaveFile_put_i32(w, checkpoint.fragment_counts[i]);
+	}
+	SaveFile_end_section(w);
+
+	/* Empty slots are written as ""; active subs as a plain list, since
+	   the sub's own type says which entry it fills */
+	SaveFile_begin_section(w, SAVE_SECTION_SKILLBAR);
+	SaveFile_put_u16(w, SKILLBAR_SLOTS);
+	for (int i = 0; i < SKILLBAR_SLOTS; i++)
+		SaveFile_put_str(w, Skillbar_get_sub_name(checkpoint.skillbar.slots[i]));
+	int activeCount = 0;
+	for (int i = 0; i < SUB_TYPE_COUNT; i++)
+		if (checkpoint.skillbar.active_sub[i] != SUB_NONE)
+			activeCount++;
+	SaveFile_put_u16(w, (uint16_t)activeCount);
+	for (int i = 0; i < SUB_TYPE_COUNT; i++)
+		if (checkpoint.skillbar.active_sub[i] != SUB_NONE)
+			SaveFile_put_str(w, Skillbar_get_sub_name(checkpoint.skillbar.active_sub[i]));
+	SaveFile_end_section(w);
+
+	SaveFile_begin_section(w, SAVE_SECTION_DATANODES);
+	SaveFile_put_u16(w, (uint16_t)checkpoint.datanode_count);
+	for (int i = 0; i < checkpoint.datanode_count; i++)
+		SaveFile_put_str(w, checkpoint.datanode_ids[i]);
+	SaveFile_end_section(w);
+}
+
 static void do_save(SavepointState *sp)
 {
 	const Zone *z = Zone_get();
@@ -136,68 +196,26 @@ static void do_save(SavepointState *sp)
 	for (int i = 0; i < FRAG_TYPE_COUNT; i++)
 		checkpoint.fragment_counts[i] = Fragment_get_count(i);
 	checkpoint.skillbar = Skillbar_snapshot();
+	Zone_capture_snapshot();
 
-	/* Write to disk */
-	/* Create save directory if needed */
-#ifdef _WIN32
-	_mkdir("./save");
-#else
-	mkdir("./save", 0755);
-#endif
-
-	FILE *f = fopen(SAVE_FILE_PATH, "w");
-	if (!f) {
-		printf("Savepoint: failed to write save file\n");
-		return;
-	}
-
-	fprintf(f, "zone %s\n", checkpoint.zone_path);
-	fprintf(f, "savepoint %s\n", checkpoint.savepoint_id);
-	fprintf(f, "position %.1f %.1f\n", checkpoint.position.x, checkpoint.position.y);
-	fprintf(f, "seed %u\n", checkpoint.procgen_seed);
-
-	fprintf(f, "unlocked");
-	for (int i = 0; i < SUB_ID_COUNT; i++) {
-		if (checkpoint.unlocked[i])
-			fprintf(f, " %s", Skillbar_get_sub_name(i));
-	}
-	fprintf(f, "\n");
-
-	fprintf(f, "discovered");
-	for (int i = 0; i < SUB_ID_COUNT; i++) {
-		if (checkpoint.discovered[i])
-			fprintf(f, " %s", Skillbar_get_sub_name(i));
-	}
-	fprintf(f, "\n");
-
-	fprintf(f, "fragments");
-	for (int i = 0; i < FRAG_TYPE_COUNT; i++) {
-		if (checkpoint.fragment_counts[i] > 0)
-			fprintf(f, " %s:%d", frag_names[i], checkpoint.fragment_counts[i]);
-	}
-	fprintf(f, "\n");
-
-	fprintf(f, "skillbar");
-	for (int s = 0; s < SKILLBAR_SLOTS; s++) {
-		int sub = Skillbar_get_slot_sub(s);
-		if (sub != SUB_NONE)
-			fprintf(f, " %d:%s", s, Skillbar_get_sub_name(sub));
-	}
-	fprintf(f, "\n");
-
-	/* Data node collected IDs */
-	checkpoint.datanode_count = DataNode_collected_count();
-	for (int i = 0; i < checkpoint.datanode_count && i < SAVE_MAX_DATANODES; i++) {
+	checkpoint.datanode_count = 0;
+	for (int i = 0; i < DataNode_collected_count() && i < SAVE_MAX_DATANODES; i++) {
 		const char *nid = DataNode_collected_id(i);
 		if (nid) {
-			strncpy(checkpoint.datanode_ids[i], nid, 31);
-			checkpoint.datanode_ids[i][31] = '\0';
-			fprintf(f, "datanode_collected %s\n", nid);
+			strncpy(checkpoint.datanode_ids[checkpoint.datanode_count], nid, 31);
+			checkpoint.datanode_ids[checkpoint.datanode_count][31] = '\0';
+			checkpoint.datanode_count++;
 		}
 	}
 
-	fclose(f);
-	FogOfWar_save_all_to_disk();
+	/* Build the file in memory; the I/O thread writes it out */
+	SaveWriter w;
+	SaveFile_begin(&w);
+	write_checkpoint(&w);
+	SaveFile_begin_section(&w, SAVE_SECTION_FOG);
+	FogOfWar_write_save(&w);
+	SaveFile_end_section(&w);
+	SaveFile_write_async(&w, SAVE_FILE_PATH);
 	printf("Savepoint: saved at '%s' in %s\n", sp->id, checkpoint.zone_path);
 
 	notifyActive = true;
@@ -243,7 +261,7 @@ void Savepoint_initialize(Position position, const char *id)
 	entity.placeable = &placeables[savepointCount];
 	entity.renderable = &renderable;
 
-	entityRefs[savepointCount] = Entity_add_entity(entity);
+	entityRefs[savepointCount] = Entity_create(entity);
 
 	savepointCount++;
 }
@@ -256,10 +274,8 @@ void Savepoint_cleanup(void)
 			Mix_HaltChannel(SAVEPOINT_CHARGE_CHANNEL);
 			savepoints[i].charge_sound_playing = false;
 		}
-		if (entityRefs[i]) {
-			entityRefs[i]->empty = true;
-			entityRefs[i] = NULL;
-		}
+		Entity_release(entityRefs[i]);
+		entityRefs[i] = (EntityHandle){0, 0};
 	}
 	savepointCount = 0;
 	notifyActive = false;
@@ -545,10 +561,12 @@ void Savepoint_seed_checkpoint(const char *zone_path, const char *savepoint_id,
 	for (int i = 0; i < FRAG_TYPE_COUNT; i++)
 		checkpoint.fragment_counts[i] = Fragment_get_count(i);
 	checkpoint.skillbar = Skillbar_snapshot();
+	Zone_capture_snapshot();
 }
 
 bool Savepoint_has_save_file(void)
 {
+	SaveFile_flush();
 	FILE *f = fopen(SAVE_FILE_PATH, "r");
 	if (f) {
 		fclose(f);
@@ -559,6 +577,8 @@ bool Savepoint_has_save_file(void)
 
 void Savepoint_delete_save_file(void)
 {
+	/* A save still in flight would recreate the file */
+	SaveFile_flush();
 	remove(SAVE_FILE_PATH);
 	FogOfWar_delete_all_saves();
 
@@ -566,11 +586,8 @@ void Savepoint_delete_save_file(void)
 	checkpoint.valid = false;
 }
 
-bool Savepoint_load_from_disk(void)
+static void reset_checkpoint(void)
 {
-	FILE *f = fopen(SAVE_FILE_PATH, "r");
-	if (!f) return false;
-
 	memset(&checkpoint, 0, sizeof(checkpoint));
 
 	/* Initialize skillbar slots to SUB_NONE */
@@ -578,6 +595,129 @@ bool Savepoint_load_from_disk(void)
 		checkpoint.skillbar.slots[i] = SUB_NONE;
 	for (int i = 0; i < SUB_TYPE_COUNT; i++)
 		checkpoint.skillbar.active_sub[i] = SUB_NONE;
+}
+
+/* Version 1 stored subs, fragments and skillbar entries by enum value.
+   Only builds with today's enum order ever wrote it. */
+static void read_positional_v1(const SaveFile *file)
+{
+	SaveReader r;
+	if (SaveFile_find_section(file, SAVE_SECTION_PROGRESSION, &r)) {
+		int count = SaveFile_get_u16(&r);
+		for (int i = 0; i < count && !r.failed; i++) {
+			uint8_t flags = SaveFile_get_u8(&r);
+			if (i < SUB_ID_COUNT) {
+				checkpoint.unlocked[i] = flags & 1;
+				checkpoint.discovered[i] = (flags >> 1) & 1;
+			}
+		}
+	}
+
+	if (SaveFile_find_section(file, SAVE_SECTION_FRAGMENTS, &r)) {
+		int count = SaveFile_get_u16(&r);
+		for (int i = 0; i < count && !r.failed; i++) {
+			int32_t n = SaveFile_get_i32(&r);
+			if (i < FRAG_TYPE_COUNT)
+				checkpoint.fragment_counts[i] = n;
+		}
+	}
+
+	if (SaveFile_find_section(file, SAVE_SECTION_SKILLBAR, &r)) {
+		int count = SaveFile_get_u16(&r);
+		for (int i = 0; i < count && !r.failed; i++) {
+			int32_t id = SaveFile_get_i32(&r);
+			if (i < SKILLBAR_SLOTS && id >= SUB_NONE && id < SUB_ID_COUNT)
+				checkpoint.skillbar.slots[i] = id;
+		}
+		count = SaveFile_get_u16(&r);
+		for (int i = 0; i < count && !r.failed; i++) {
+			int32_t id = SaveFile_get_i32(&r);
+			if (i < SUB_TYPE_COUNT && id >= SUB_NONE && id < SUB_ID_COUNT)
+				checkpoint.skillbar.active_sub[i] = id;
+		}
+	}
+}
+
+static void read_named(const SaveFile *file)
+{
+	/* Unknown names (removed subs/fragments) are skipped; anything not in
+	   the file keeps its default */
+	SaveReader r;
+	char name[32];
+
+	if (SaveFile_find_section(file, SAVE_SECTION_PROGRESSION, &r)) {
+		int count = SaveFile_get_u16(&r);
+		for (int i = 0; i < count && !r.failed; i++) {
+			SaveFile_get_str(&r, name, sizeof(name));
+			uint8_t flags = SaveFile_get_u8(&r);
+			int id = find_sub_by_name(name);
+			if (id >= 0) {
+				checkpoint.unlocked[id] = flags & 1;
+				checkpoint.discovered[id] = (flags >> 1) & 1;
+			}
+		}
+	}
+
+	if (SaveFile_find_section(file, SAVE_SECTION_FRAGMENTS, &r)) {
+		int count = SaveFile_get_u16(&r);
+		for (int i = 0; i < count && !r.failed; i++) {
+			SaveFile_get_str(&r, name, sizeof(name));
+			int32_t n = SaveFile_get_i32(&r);
+			int idx = find_frag_by_name_compat(name);
+			if (idx >= 0)
+				checkpoint.fragment_counts[idx] = n;
+		}
+	}
+
+	if (SaveFile_find_section(file, SAVE_SECTION_SKILLBAR, &r)) {
+		int count = SaveFile_get_u16(&r);
+		for (int i = 0; i < count && !r.failed; i++) {
+			SaveFile_get_str(&r, name, sizeof(name));
+			int id = find_sub_by_name(name);
+			if (i < SKILLBAR_SLOTS && id >= 0)
+				checkpoint.skillbar.slots[i] = id;
+		}
+		count = SaveFile_get_u16(&r);
+		for (int i = 0; i < count && !r.failed; i++) {
+			SaveFile_get_str(&r, name, sizeof(name));
+			int id = find_sub_by_name(name);
+			if (id >= 0)
+				checkpoint.skillbar.active_sub[Skillbar_get_sub_type(id)] = id;
+		}
+	}
+}
+
+static bool read_checkpoint(const SaveFile *file)
+{
+	SaveReader r;
+	if (!SaveFile_find_section(file, SAVE_SECTION_CHECKPOINT, &r))
+		return false;
+	SaveFile_get_str(&r, checkpoint.zone_path, sizeof(checkpoint.zone_path));
+	SaveFile_get_str(&r, checkpoint.savepoint_id, sizeof(checkpoint.savepoint_id));
+	checkpoint.position.x = SaveFile_get_f64(&r);
+	checkpoint.position.y = SaveFile_get_f64(&r);
+	checkpoint.procgen_seed = SaveFile_get_u32(&r);
+	if (r.failed)
+		return false;
+
+	if (file->version < 2)
+		read_positional_v1(file);
+	else
+		read_named(file);
+
+	if (SaveFile_find_section(file, SAVE_SECTION_DATANODES, &r)) {
+		int count = SaveFile_get_u16(&r);
+		for (int i = 0; i < count && !r.failed && checkpoint.datanode_count < SAVE_MAX_DATANODES; i++)
+			SaveFile_get_str(&r, checkpoint.datanode_ids[checkpoint.datanode_count++], 32);
+	}
+	return true;
+}
+
+/* Text checkpoint written before the save container */
+static bool load_legacy_text(void)
+{
+	FILE *f = fopen(SAVE_FILE_PATH, "r");
+	if (!f) return false;
 
 	char line[512];
 	while (fgets(line, sizeof(line), f)) {
@@ -656,12 +796,48 @@ bool Savepoint_load_from_disk(void)
 	}
 
 	fclose(f);
+	return true;
+}
+
+bool Savepoint_load_from_disk(void)
+{
+	SaveFile_flush();
+	reset_checkpoint();
+
+	SaveFile file;
+	bool isContainer;
+	if (SaveFile_load(SAVE_FILE_PATH, &file, &isContainer)) {
+		bool ok = read_checkpoint(&file);
+		SaveFile_free(&file);
+		if (!ok) {
+			printf("WARNING: Savepoint: save file has no readable checkpoint\n");
+			reset_checkpoint();
+			return false;
+		}
+	} else if (isContainer || !load_legacy_text()) {
+		return false;
+	}
+
 	checkpoint.valid = true;
 	printf("Savepoint: loaded checkpoint from disk (%s @ %s)\n",
 		checkpoint.savepoint_id, checkpoint.zone_path);
 	return true;
 }
 
+void Savepoint_load_fog_from_disk(void)
+{
+	SaveFile_flush();
+
+	SaveFile file;
+	bool isContainer;
+	if (!SaveFile_load(SAVE_FILE_PATH, &file, &isContainer))
+		return;
+	SaveReader r;
+	if (SaveFile_find_section(&file, SAVE_SECTION_FOG, &r) && !FogOfWar_read_save(&r))
+		printf("WARNING: Savepoint: saved fog of war is damaged\n");
+	SaveFile_free(&file);
+}
+
 void Savepoint_suppress_by_id(const char *savepoint_id)
 {
 	for (int i = 0; i < savepointCount; i++) {
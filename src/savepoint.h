@@ -51,9 +51,13 @@ void Savepoint_seed_checkpoint(const char *zone_path, const char *savepoint_id,
 /* Suppress arrival (start deactivated) */
 void Savepoint_suppress_by_id(const char *savepoint_id);
 
-/* Disk persistence */
+/* Disk persistence — one binary container (see save_file.h); saving at a
+ * savepoint only snapshots state and queues the write. Older text saves
+ * are still read. */
 bool Savepoint_has_save_file(void);
 bool Savepoint_load_from_disk(void);
+/* Fill the fog of war zone cache from the save (load-from-save only) */
+void Savepoint_load_fog_from_disk(void);
 void Savepoint_delete_save_file(void);
 
 /* Minimap rendering */
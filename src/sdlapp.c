@@ -10,8 +10,10 @@
 #include "mode_gameplay.h"
 #include "savepoint.h"
 #include "settings.h"
+#include "entity.h"
+#include "view.h"
+#include "save_file.h"
 
-static const unsigned int DELAY = 1;
 
 static SdlApp sdlApp;
 
@@ -21,6 +23,8 @@ static void loop(void);
 static void update(Input *input, const unsigned int ticks);
 static void render(void);
 static void reset_input(Input *input);
+static void snapshot_interpolation_state(void);
+static void pace_frame(void);
 
 static void change_mode(const Mode mode);
 static void initialize_mode(void);
@@ -63,6 +67,7 @@ static void initialize(void)
 	srand((unsigned int)time(NULL) ^ (unsigned int)SDL_GetPerformanceCounter());
 
 	/* Load checkpoint from disk at startup */
+	SaveFile_initialize();
 	Savepoint_load_from_disk();
 
 	Mode_Mainmenu_initialize(&quit_callback, &gameplay_mode_callback, &load_game_callback);
@@ -73,6 +78,7 @@ static void initialize(void)
 static void cleanup(void)
 {
 	cleanup_mode();
+	SaveFile_cleanup();
 	Audio_cleanup();
 	Graphics_cleanup();
 	SDL_Quit();
@@ -82,18 +88,43 @@ static void loop(void)
 {
 	Input input;
 	input_initialize(&input);
-	unsigned int ticks = 0;
 	
 	while(!sdlApp.quit) {
-		ticks = timer_tick();
-		reset_input(&input);
 		handle_sdl_events(&input);
-		update(&input, ticks);
+
+		/* Fixed-rate simulation; render interpolates between the last two
+		   steps. Edge-triggered input is consumed by the first step, and
+		   survives frames that run no step at all. */
+		int steps = timer_steps_due();
+		for (int i = 0; i < steps && !sdlApp.quit; i++) {
+			snapshot_interpolation_state();
+			update(&input, timer_step_ms());
+			reset_input(&input);
+		}
+
+		Audio_flush_sfx();
 		render();
-		SDL_Delay(DELAY);
+		pace_frame();
 	}
 }
 
+static void snapshot_interpolation_state(void)
+{
+	Entity_snapshot_positions();
+	View_snapshot();
+}
+
+static void pace_frame(void)
+{
+	/* With vsync the buffer swap already holds us to the display rate.
+	   Otherwise (or while nothing is drawn) sleep until the next step. */
+	if (!sdlApp.iconified && SDL_GL_GetSwapInterval() != 0)
+		return;
+
+	unsigned int wait = timer_ms_until_step();
+	SDL_Delay(wait > 0 ? wait : 1);
+}
+
 static void reset_input(Input *input) 
 {
 	input->mouseWheelUp = false;
@@ -204,6 +235,7 @@ static void render(void)
 	if (sdlApp.iconified)
 			return;
 
+	timer_begin_render();
 	switch (sdlApp.mode) {
 	case INTRO:
 		break;
@@ -214,6 +246,8 @@ static void render(void)
 		Mode_Gameplay_render();
 		break;
 	};
+	timer_end_render();
+	Graphics_flip();
 }
 
 static void handle_sdl_events(Input *input)
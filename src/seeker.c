@@ -18,6 +18,7 @@
 #include "map.h"
 #include "enemy_registry.h"
 #include "spatial_grid.h"
+#include "timer_wheel.h"
 #include "global_render.h"
 #include "global_update.h"
 
@@ -114,7 +115,6 @@ typedef struct {
 
 	/* Death/respawn */
 	int deathTimer;
-	int respawnTimer;
 
 	/* Windup flash */
 	int windupTimer;
@@ -156,7 +156,8 @@ static const ColorFloat colorRecover = {0.0f, 0.4f, 0.1f, 0.6f};
 /* State arrays */
 static SeekerState seekers[SEEKER_COUNT];
 static PlaceableComponent placeables[SEEKER_COUNT];
-static Entity *entityRefs[SEEKER_COUNT];
+static EntityHandle entityRefs[SEEKER_COUNT];
+static TimerHandle respawnEvents[SEEKER_COUNT];
 static int highestUsedIndex = 0;
 
 /* Sparks */
@@ -201,6 +202,51 @@ static void pick_wander_target(SeekerState *s)
 		&s->wanderTarget, &s->wanderTimer);
 }
 
+/* Spark decay runs once per frame, not from an entity that may be dormant
+   or waiting to respawn outside the AI walk */
+static void decay_sparks(const unsigned int ticks)
+{
+	for (int si = 0; si < SPARK_POOL_SIZE; si++) {
+		if (sparks[si].active) {
+			sparks[si].ticksLeft -= ticks;
+			if (sparks[si].ticksLeft <= 0)
+				sparks[si].active = false;
+		}
+	}
+}
+
+static void respawn(int idx)
+{
+	SeekerState *s = &seekers[idx];
+	PlaceableComponent *pl = &placeables[idx];
+	bool dormant = !SpatialGrid_is_active(pl->position.x, pl->position.y);
+
+	s->alive = true;
+	s->hp = SEEKER_HP;
+	s->aiState = SEEKER_IDLE;
+	s->killedByPlayer = false;
+	EnemyFeedback_reset(&s->fb);
+	Burn_reset(&s->burn);
+	Position oldPos = pl->position;
+	pl->position = s->spawnPoint;
+	pick_wander_target(s);
+	/* NO respawn sound while dormant */
+	if (!dormant)
+		Audio_play_sample_at(&sampleRespawn, pl->position);
+	SpatialGrid_update((EntityRef){ENTITY_SEEKER, idx},
+		oldPos.x, oldPos.y, pl->position.x, pl->position.y);
+	Entity_set_ai_suspended(entityRefs[idx], false);
+}
+
+/* The dead leave the AI walk until their respawn event fires; if the
+   wheel is full they stay in it and retry from the DEAD state */
+static void schedule_respawn(int idx)
+{
+	respawnEvents[idx] = TimerWheel_schedule(RESPAWN_MS, respawn, idx);
+	if (TimerWheel_is_pending(respawnEvents[idx]))
+		Entity_set_ai_suspended(entityRefs[idx], true);
+}
+
 /* ---- Public API ---- */
 
 void Seeker_initialize(Position position, ZoneTheme theme)
@@ -230,7 +276,6 @@ void Seeker_initialize(Position position, ZoneTheme theme)
 	s->recoverVelX = 0.0;
 	s->recoverVelY = 0.0;
 	s->deathTimer = 0;
-	s->respawnTimer = 0;
 	s->windupTimer = 0;
 	EnemyFeedback_init(&s->fb);
 	Burn_reset(&s->burn);
@@ -246,7 +291,7 @@ void Seeker_initialize(Position position, ZoneTheme theme)
 	entity.collidable = &collidable;
 	entity.aiUpdatable = &updatable;
 
-	entityRefs[idx] = Entity_add_entity(entity);
+	entityRefs[idx] = Entity_create(entity);
 
 	highestUsedIndex++;
 
@@ -269,6 +314,7 @@ void Seeker_initialize(Position position, ZoneTheme theme)
 		GlobalRender_register(RENDER_PASS_WORLD_OVERLAY, Seeker_render_corridors);
 		GlobalRender_register(RENDER_PASS_BLOOM_SOURCE, Seeker_render_corridor_bloom_source);
 		GlobalRender_register(RENDER_PASS_LIGHT_SOURCE, Seeker_render_corridor_light_source);
+		GlobalUpdate_register_pre_collision(decay_sparks);
 		GlobalUpdate_register_post_collision(Seeker_update_corridors);
 		GlobalUpdate_register_post_collision(seeker_corridor_burn_wrapper);
 		pipelineRegistered = true;
@@ -284,10 +330,9 @@ void Seeker_initialize(Position position, ZoneTheme theme)
 void Seeker_cleanup(void)
 {
 	for (int i = 0; i < highestUsedIndex; i++) {
-		if (entityRefs[i]) {
-			entityRefs[i]->empty = true;
-			entityRefs[i] = NULL;
-		}
+		TimerWheel_cancel(respawnEvents[i]);
+		Entity_release(entityRefs[i]);
+		entityRefs[i] = (EntityHandle){0, 0};
 	}
 	highestUsedIndex = 0;
 	for (int i = 0; i < SPARK_POOL_SIZE; i++)
@@ -338,37 +383,10 @@ void Seeker_update(void *state, const PlaceableComponent *placeable, unsigned in
 	PlaceableComponent *pl = &placeables[idx];
 	double dt = ticks / 1000.0;
 
-	/* Spark decay must run unconditionally (shared pool, not per-entity) */
-	if (idx == 0) {
-		for (int si = 0; si < SPARK_POOL_SIZE; si++) {
-			if (sparks[si].active) {
-				sparks[si].ticksLeft -= ticks;
-				if (sparks[si].ticksLeft <= 0)
-					sparks[si].active = false;
-			}
-		}
-	}
-
-	/* Dormancy check — only tick respawn timer if dormant */
+	/* Dormancy check — nothing to do while dormant */
 	if (!SpatialGrid_is_active(pl->position.x, pl->position.y)) {
-		if (s->aiState == SEEKER_DEAD) {
-			s->respawnTimer += ticks;
-			if (s->respawnTimer >= RESPAWN_MS) {
-				s->alive = true;
-				s->hp = SEEKER_HP;
-				s->aiState = SEEKER_IDLE;
-				s->killedByPlayer = false;
-				EnemyFeedback_reset(&s->fb);
-				Burn_reset(&s->burn);
-				Position oldPos = pl->position;
-				pl->position = s->spawnPoint;
-				pick_wander_target(s);
-				/* NO respawn sound while dormant */
-				SpatialGrid_update((EntityRef){ENTITY_SEEKER, idx},
-					oldPos.x, oldPos.y,
-					s->spawnPoint.x, s->spawnPoint.y);
-			}
-		}
+		if (s->aiState == SEEKER_DEAD && !TimerWheel_is_pending(respawnEvents[idx]))
+			schedule_respawn(idx);
 		return;
 	}
 
@@ -566,13 +584,13 @@ void Seeker_update(void *state, const PlaceableComponent *placeable, unsigned in
 		double moveX = s->dashCore.dirX * seekerDashCfg.speed * dt;
 		double moveY = s->dashCore.dirY * seekerDashCfg.speed * dt;
 
-		/* Check wall collision along dash path */
-		double hx, hy;
-		double newX = pl->position.x + moveX;
-		double newY = pl->position.y + moveY;
-		if (Map_line_test_hit(pl->position.x, pl->position.y, newX, newY, &hx, &hy)) {
-			pl->position.x = hx - s->dashCore.dirX * 5.0;
-			pl->position.y = hy - s->dashCore.dirY * 5.0;
+		/* Swept body against walls; stop just short of the contact */
+		Rectangle seekerBB = {-BODY_WIDTH, BODY_LENGTH, BODY_WIDTH, -BODY_LENGTH};
+		Rectangle bodyStart = Collision_transform_bounding_box(pl->position, seekerBB);
+		double wallT;
+		if (Map_sweep_aabb(bodyStart, moveX, moveY, &wallT, NULL, NULL)) {
+			pl->position.x += moveX * wallT - s->dashCore.dirX;
+			pl->position.y += moveY * wallT - s->dashCore.dirY;
 			s->recoverVelX = s->dashCore.dirX * seekerDashCfg.speed * 0.1;
 			s->recoverVelY = s->dashCore.dirY * seekerDashCfg.speed * 0.1;
 			SubDash_end_early(&s->dashCore, &seekerDashCfg);
@@ -581,8 +599,8 @@ void Seeker_update(void *state, const PlaceableComponent *placeable, unsigned in
 			break;
 		}
 
-		pl->position.x = newX;
-		pl->position.y = newY;
+		pl->position.x += moveX;
+		pl->position.y += moveY;
 		s->facing = atan2(s->dashCore.dirX, s->dashCore.dirY) * 180.0 / PI;
 
 		/* Fire seeker: deposit corridor segments during dash */
@@ -600,10 +618,8 @@ void Seeker_update(void *state, const PlaceableComponent *placeable, unsigned in
 			Position shipPos = Ship_get_position();
 			Rectangle shipBB = {-SHIP_BB_HALF_SIZE, SHIP_BB_HALF_SIZE, SHIP_BB_HALF_SIZE, -SHIP_BB_HALF_SIZE};
 			Rectangle shipWorld = Collision_transform_bounding_box(shipPos, shipBB);
-			Rectangle seekerBB = {-BODY_WIDTH, BODY_LENGTH, BODY_WIDTH, -BODY_LENGTH};
-			Rectangle seekerWorld = Collision_transform_bounding_box(pl->position, seekerBB);
-
-			if (Collision_aabb_test(seekerWorld, shipWorld)) {
+			/* Swept so a long frame can't carry the dash through the ship */
+			if (Collision_sweep_aabb(bodyStart, moveX, moveY, shipWorld, NULL, NULL, NULL)) {
 				PlayerStats_damage(seekerDashCfg.damage);
 				s->dashCore.hitThisDash = true;
 			}
@@ -653,7 +669,7 @@ void Seeker_update(void *state, const PlaceableComponent *placeable, unsigned in
 		s->deathTimer += ticks;
 		if (s->deathTimer >= DEATH_FLASH_MS) {
 			s->aiState = SEEKER_DEAD;
-			s->respawnTimer = 0;
+			schedule_respawn(idx);
 
 			/* Drop fragment */
 			if (s->killedByPlayer) {
@@ -666,18 +682,9 @@ void Seeker_update(void *state, const PlaceableComponent *placeable, unsigned in
 		break;
 
 	case SEEKER_DEAD:
-		s->respawnTimer += ticks;
-		if (s->respawnTimer >= RESPAWN_MS) {
-			s->alive = true;
-			s->hp = SEEKER_HP;
-			s->aiState = SEEKER_IDLE;
-			s->killedByPlayer = false;
-			EnemyFeedback_reset(&s->fb);
-			Burn_reset(&s->burn);
-			pl->position = s->spawnPoint;
-			pick_wander_target(s);
-			Audio_play_sample_at(&sampleRespawn, pl->position);
-		}
+		/* Respawn is a timer event; only reached if scheduling failed */
+		if (!TimerWheel_is_pending(respawnEvents[idx]))
+			schedule_respawn(idx);
 		break;
 	}
 
@@ -923,7 +930,8 @@ void Seeker_reset_all(void)
 		s->recoverVelX = 0.0;
 		s->recoverVelY = 0.0;
 		s->deathTimer = 0;
-		s->respawnTimer = 0;
+		TimerWheel_cancel(respawnEvents[i]);
+		Entity_set_ai_suspended(entityRefs[i], false);
 		EnemyFeedback_reset(&s->fb);
 		Burn_reset(&s->burn);
 		placeables[i].position = s->spawnPoint;
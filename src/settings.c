@@ -10,6 +10,7 @@
 #include "map.h"
 #include "audio.h"
 #include "keybinds.h"
+#include "timer.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -164,6 +165,8 @@ void Settings_load(void)
 			Audio_set_master_voice(value / 100.0f);
 		else if (strcmp(key, "ui_scale") == 0)
 			Graphics_set_ui_scale(value / 100.0f);
+		else if (strcmp(key, "sim_rate") == 0)
+			timer_set_rate((unsigned int)value);
 	}
 	fclose(f);
 	printf("Settings_load: done. ms=%d aa=%d fs=%d\n",
@@ -191,6 +194,7 @@ void Settings_save(void)
 	fprintf(f, "sfx_volume %d\n", (int)(Audio_get_master_sfx() * 100.0f + 0.5f));
 	fprintf(f, "voice_volume %d\n", (int)(Audio_get_master_voice() * 100.0f + 0.5f));
 	fprintf(f, "ui_scale %d\n", (int)(Graphics_get_ui_scale() * 100.0f + 0.5f));
+	fprintf(f, "sim_rate %u\n", timer_get_rate());
 	Keybinds_save(f);
 	fclose(f);
 	printf("Settings saved to %s\n", SETTINGS_FILE_PATH);
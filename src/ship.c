@@ -38,6 +38,8 @@
 #include "stalker.h"
 #include "savepoint.h"
 #include "zone.h"
+#include "map.h"
+#include "timer.h"
 #include "enemy_registry.h"
 #include "fragment.h"
 #include "progression.h"
@@ -67,6 +69,9 @@ static bool isBoosting = false;
 
 #define TRAIL_GHOSTS 20
 #define TRAIL_LENGTH 4.0
+/* TRAIL_LENGTH was tuned against the per-frame move at 60 fps; the trail
+   now follows the fixed simulation step, scaled back to that length */
+#define TRAIL_FRAME_MS (1000.0 / 60.0)
 
 static Mix_Chunk *sample01 = 0;
 static Mix_Chunk *sample02 = 0;
@@ -275,6 +280,26 @@ void Ship_resolve(void *state, const Collision collision)
 	}
 }
 
+/* Swept move against terrain, so a long frame can't carry the ship through
+   a thin wall or kill it somewhere past the point of contact */
+static void move_ship(PlaceableComponent *placeable, double dx, double dy)
+{
+	if (!godMode) {
+		Rectangle box = Collision_transform_bounding_box(placeable->position,
+			collidable.boundingBox);
+		double t;
+		if (Map_sweep_aabb(box, dx, dy, &t, NULL, NULL)) {
+			placeable->position.x += dx * t;
+			placeable->position.y += dy * t;
+			Ship_resolve(NULL, (Collision){true, true});
+			return;
+		}
+	}
+
+	placeable->position.x += dx;
+	placeable->position.y += dy;
+}
+
 void Ship_update(const Input *userInput, const unsigned int ticks, PlaceableComponent *placeable)
 {
 	double ticksNormalized = ticks / 1000.0;
@@ -346,7 +371,6 @@ void Ship_update(const Input *userInput, const unsigned int ticks, PlaceableComp
 			 * Re-spawning here would re-init bosses (triggering dialog). */
 			if (!Ship_has_pending_cross_zone_respawn())
 				Zone_spawn_enemies();
-			Entity_recalculate_highest_index();
 
 			/* Skip sound for cross-zone — Ship_force_spawn will play it */
 			if (!Ship_has_pending_cross_zone_respawn())
@@ -389,14 +413,12 @@ void Ship_update(const Input *userInput, const unsigned int ticks, PlaceableComp
 			vel_x = Sub_Egress_get_dash_vx();
 			vel_y = Sub_Egress_get_dash_vy();
 
-			placeable->position.x += vel_x * ticksNormalized;
-			placeable->position.y += vel_y * ticksNormalized;
+			move_ship(placeable, vel_x * ticksNormalized, vel_y * ticksNormalized);
 		} else if (Sub_Blaze_is_dashing()) {
 			vel_x = Sub_Blaze_get_dash_vx();
 			vel_y = Sub_Blaze_get_dash_vy();
 
-			placeable->position.x += vel_x * ticksNormalized;
-			placeable->position.y += vel_y * ticksNormalized;
+			move_ship(placeable, vel_x * ticksNormalized, vel_y * ticksNormalized);
 		} else {
 			double maxSpeed;
 			if (Sub_Boost_is_boosting())
@@ -437,8 +459,7 @@ void Ship_update(const Input *userInput, const unsigned int ticks, PlaceableComp
 			vel_y += (target_vy - vel_y) * blend;
 
 			/* Apply velocity */
-			placeable->position.x += vel_x * ticksNormalized;
-			placeable->position.y += vel_y * ticksNormalized;
+			move_ship(placeable, vel_x * ticksNormalized, vel_y * ticksNormalized);
 
 			if (hasInput) {
 				placeable->heading = get_heading(
@@ -487,14 +508,30 @@ void Ship_update(const Input *userInput, const unsigned int ticks, PlaceableComp
 	}
 }
 
+/* Last step's movement at the old per-frame scale. Taken from the live
+   position, since the placeable passed to render is interpolated. */
+static void boost_trail_delta(double *dx, double *dy)
+{
+	*dx = placeable.position.x - prevPosition.x;
+	*dy = placeable.position.y - prevPosition.y;
+	if (*dx * *dx + *dy * *dy > INTERP_SNAP_DISTANCE * INTERP_SNAP_DISTANCE) {
+		*dx = 0.0;
+		*dy = 0.0;
+		return;
+	}
+	double scale = TRAIL_FRAME_MS / timer_step_ms();
+	*dx *= scale;
+	*dy *= scale;
+}
+
 void Ship_render(const void *state, const PlaceableComponent *placeable)
 {
 	if (!shipState.destroyed) {
 		/* Motion trail when boosting */
 		if (isBoosting) {
 			float stealthAlpha = Sub_Stealth_get_ship_alpha() * Sub_Smolder_get_ship_alpha();
-			double dx = placeable->position.x - prevPosition.x;
-			double dy = placeable->position.y - prevPosition.y;
+			double dx, dy;
+			boost_trail_delta(&dx, &dy);
 			for (int i = TRAIL_GHOSTS; i >= 1; i--) {
 				float t = (float)i / (float)(TRAIL_GHOSTS + 1);
 				Position ghost;
@@ -550,8 +587,8 @@ static void ship_render_bloom(const void *state, const PlaceableComponent *pl)
 	(void)state;
 	if (!shipState.destroyed && !Sub_Stealth_is_stealthed() && !Sub_Smolder_is_active()) {
 		if (isBoosting) {
-			double dx = pl->position.x - prevPosition.x;
-			double dy = pl->position.y - prevPosition.y;
+			double dx, dy;
+			boost_trail_delta(&dx, &dy);
 			for (int i = TRAIL_GHOSTS; i >= 1; i--) {
 				float t = (float)i / (float)(TRAIL_GHOSTS + 1);
 				Position ghost;
@@ -576,7 +613,19 @@ static void ship_render_bloom(const void *state, const PlaceableComponent *pl)
 
 Position Ship_get_position()
 {
-	return placeable.position;
+	/* While rendering, match where the entity pass draws the ship so
+	   attached effects (beams, auras) don't lag it by a step */
+	double alpha = timer_render_alpha();
+	if (alpha >= 1.0)
+		return placeable.position;
+
+	double dx = placeable.position.x - prevPosition.x;
+	double dy = placeable.position.y - prevPosition.y;
+	if (dx * dx + dy * dy > INTERP_SNAP_DISTANCE * INTERP_SNAP_DISTANCE)
+		return placeable.position;
+
+	Position p = {prevPosition.x + dx * alpha, prevPosition.y + dy * alpha};
+	return p;
 }
 
 double Ship_get_heading()
@@ -23,6 +23,7 @@
 #include "global_render.h"
 #include "global_update.h"
 #include "spatial_grid.h"
+#include "timer_wheel.h"
 
 #include <math.h>
 #include <stdlib.h>
@@ -110,7 +111,6 @@ typedef struct {
 
 	/* Death/respawn */
 	int deathTimer;
-	int respawnTimer;
 
 	/* Stealth alpha (computed each frame) */
 	float stealthAlpha;
@@ -155,11 +155,15 @@ static const ColorFloat colorFireVisible = {1.0f, 0.45f, 0.05f, 1.0f};
 /* State arrays */
 static StalkerState stalkers[STALKER_COUNT];
 static PlaceableComponent placeables[STALKER_COUNT];
-static Entity *entityRefs[STALKER_COUNT];
+static EntityHandle entityRefs[STALKER_COUNT];
+static TimerHandle respawnEvents[STALKER_COUNT];
 static int highestUsedIndex = 0;
 
+/* Stealth pulse clock, advanced once per frame from the projectile hook */
+static unsigned int globalTicks = 0;
+
 /* Projectile pool (shared across all stalkers, uses sub_pea config) */
-#define STALKER_PROJ_POOL_SIZE 256
+#define STALKER_PROJ_POOL_SIZE 4096
 static SubProjectilePool stalkerProjPool;
 
 /* Fire stalker corridor (shared across all fire stalkers) */
@@ -204,6 +208,41 @@ static void pick_wander_target(StalkerState *s)
 		&s->wanderTarget, &s->wanderTimer);
 }
 
+static void respawn(int idx)
+{
+	StalkerState *s = &stalkers[idx];
+	PlaceableComponent *pl = &placeables[idx];
+	bool dormant = !SpatialGrid_is_active(pl->position.x, pl->position.y);
+
+	s->alive = true;
+	s->hp = STALKER_HP;
+	s->aiState = STALKER_IDLE;
+	s->killedByPlayer = false;
+	EnemyFeedback_reset(&s->fb);
+	Burn_reset(&s->burn);
+	SubSmolder_reset(&s->smolderCore);
+	if (s->theme == THEME_FIRE)
+		SubSmolder_activate_silent(&s->smolderCore, SubSmolder_get_config());
+	Position oldPos = pl->position;
+	pl->position = s->spawnPoint;
+	pick_wander_target(s);
+	/* NO respawn sound while dormant */
+	if (!dormant)
+		Audio_play_sample_at(&sampleRespawn, pl->position);
+	SpatialGrid_update((EntityRef){ENTITY_STALKER, idx},
+		oldPos.x, oldPos.y, pl->position.x, pl->position.y);
+	Entity_set_ai_suspended(entityRefs[idx], false);
+}
+
+/* The dead leave the AI walk until their respawn event fires; if the
+   wheel is full they stay in it and retry from the DEAD state */
+static void schedule_respawn(int idx)
+{
+	respawnEvents[idx] = TimerWheel_schedule(RESPAWN_MS, respawn, idx);
+	if (TimerWheel_is_pending(respawnEvents[idx]))
+		Entity_set_ai_suspended(entityRefs[idx], true);
+}
+
 static float compute_stealth_alpha(StalkerState *s, unsigned int globalTicks)
 {
 	/* Fire stalker uses smolder core for alpha */
@@ -315,7 +354,6 @@ void Stalker_initialize(Position position, ZoneTheme theme)
 	s->retreatTimer = 0;
 	s->retreatShotFired = false;
 	s->deathTimer = 0;
-	s->respawnTimer = 0;
 	s->stealthAlpha = STEALTH_ALPHA_MIN;
 	EnemyFeedback_init(&s->fb);
 	Burn_reset(&s->burn);
@@ -336,7 +374,7 @@ void Stalker_initialize(Position position, ZoneTheme theme)
 	entity.collidable = &collidable;
 	entity.aiUpdatable = &updatable;
 
-	entityRefs[idx] = Entity_add_entity(entity);
+	entityRefs[idx] = Entity_create(entity);
 
 	highestUsedIndex++;
 
@@ -378,10 +416,9 @@ void Stalker_initialize(Position position, ZoneTheme theme)
 void Stalker_cleanup(void)
 {
 	for (int i = 0; i < highestUsedIndex; i++) {
-		if (entityRefs[i]) {
-			entityRefs[i]->empty = true;
-			entityRefs[i] = NULL;
-		}
+		TimerWheel_cancel(respawnEvents[i]);
+		Entity_release(entityRefs[i]);
+		entityRefs[i] = (EntityHandle){0, 0};
 	}
 	highestUsedIndex = 0;
 
@@ -430,6 +467,7 @@ void Stalker_resolve(void *state, const Collision collision)
 
 void Stalker_update_projectiles(unsigned int ticks)
 {
+	globalTicks += ticks;
 	SubProjectile_update(&stalkerProjPool, Sub_Pea_get_config(), ticks);
 
 	/* Check player hit */
@@ -459,33 +497,10 @@ void Stalker_update(void *state, const PlaceableComponent *placeable, unsigned i
 	PlaceableComponent *pl = &placeables[idx];
 	double dt = ticks / 1000.0;
 
-	/* Keep globalTicks accurate even when stalker[0] is dormant */
-	static unsigned int globalTicks = 0;
-	if (idx == 0) globalTicks += ticks;
-
-	/* Dormancy check — only tick respawn timer if dormant */
+	/* Dormancy check — nothing to do while dormant */
 	if (!SpatialGrid_is_active(pl->position.x, pl->position.y)) {
-		if (s->aiState == STALKER_DEAD) {
-			s->respawnTimer += ticks;
-			if (s->respawnTimer >= RESPAWN_MS) {
-				s->alive = true;
-				s->hp = STALKER_HP;
-				s->aiState = STALKER_IDLE;
-				s->killedByPlayer = false;
-				EnemyFeedback_reset(&s->fb);
-				Burn_reset(&s->burn);
-				SubSmolder_reset(&s->smolderCore);
-				if (s->theme == THEME_FIRE)
-					SubSmolder_activate_silent(&s->smolderCore, SubSmolder_get_config());
-				Position oldPos = pl->position;
-				pl->position = s->spawnPoint;
-				pick_wander_target(s);
-				/* NO respawn sound while dormant */
-				SpatialGrid_update((EntityRef){ENTITY_STALKER, idx},
-					oldPos.x, oldPos.y,
-					s->spawnPoint.x, s->spawnPoint.y);
-			}
-		}
+		if (s->aiState == STALKER_DEAD && !TimerWheel_is_pending(respawnEvents[idx]))
+			schedule_respawn(idx);
 		return;
 	}
 
@@ -663,13 +678,13 @@ void Stalker_update(void *state, const PlaceableComponent *placeable, unsigned i
 		double moveX = s->dashCore.dirX * dcfg->speed * dt;
 		double moveY = s->dashCore.dirY * dcfg->speed * dt;
 
-		/* Wall collision */
-		double hx, hy;
-		double newX = pl->position.x + moveX;
-		double newY = pl->position.y + moveY;
-		if (Map_line_test_hit(pl->position.x, pl->position.y, newX, newY, &hx, &hy)) {
-			pl->position.x = hx - s->dashCore.dirX * 5.0;
-			pl->position.y = hy - s->dashCore.dirY * 5.0;
+		/* Swept body against walls; stop just short of the contact */
+		Rectangle stalkerBB = {-BODY_WIDTH, BODY_RADIUS, BODY_WIDTH, -BODY_RADIUS};
+		Rectangle bodyStart = Collision_transform_bounding_box(pl->position, stalkerBB);
+		double wallT;
+		if (Map_sweep_aabb(bodyStart, moveX, moveY, &wallT, NULL, NULL)) {
+			pl->position.x += moveX * wallT - s->dashCore.dirX;
+			pl->position.y += moveY * wallT - s->dashCore.dirY;
 			SubDash_end_early(&s->dashCore, dcfg);
 			s->aiState = STALKER_RETREATING;
 			s->retreatTimer = 0;
@@ -677,8 +692,8 @@ void Stalker_update(void *state, const PlaceableComponent *placeable, unsigned i
 			break;
 		}
 
-		pl->position.x = newX;
-		pl->position.y = newY;
+		pl->position.x += moveX;
+		pl->position.y += moveY;
 		s->facing = atan2(s->dashCore.dirX, s->dashCore.dirY) * 180.0 / PI;
 
 		/* Fire stalker: deposit corridor segments during dash */
@@ -696,10 +711,8 @@ void Stalker_update(void *state, const PlaceableComponent *placeable, unsigned i
 			Position shipPos = Ship_get_position();
 			Rectangle shipBB = {-SHIP_BB_HALF_SIZE, SHIP_BB_HALF_SIZE, SHIP_BB_HALF_SIZE, -SHIP_BB_HALF_SIZE};
 			Rectangle shipWorld = Collision_transform_bounding_box(shipPos, shipBB);
-			Rectangle stalkerBB = {-BODY_WIDTH, BODY_RADIUS, BODY_WIDTH, -BODY_RADIUS};
-			Rectangle stalkerWorld = Collision_transform_bounding_box(pl->position, stalkerBB);
-
-			if (Collision_aabb_test(stalkerWorld, shipWorld)) {
+			/* Swept so a long frame can't carry the dash through the ship */
+			if (Collision_sweep_aabb(bodyStart, moveX, moveY, shipWorld, NULL, NULL, NULL)) {
 				PlayerStats_damage(dcfg->damage);
 				s->dashCore.hitThisDash = true;
 				/* Fire stalker: burn on contact */
@@ -767,7 +780,7 @@ void Stalker_update(void *state, const PlaceableComponent *placeable, unsigned i
 		s->deathTimer += ticks;
 		if (s->deathTimer >= DEATH_FLASH_MS) {
 			s->aiState = STALKER_DEAD;
-			s->respawnTimer = 0;
+			schedule_respawn(idx);
 
 			if (s->killedByPlayer) {
 				int count;
@@ -779,21 +792,9 @@ void Stalker_update(void *state, const PlaceableComponent *placeable, unsigned i
 		break;
 
 	case STALKER_DEAD:
-		s->respawnTimer += ticks;
-		if (s->respawnTimer >= RESPAWN_MS) {
-			s->alive = true;
-			s->hp = STALKER_HP;
-			s->aiState = STALKER_IDLE;
-			s->killedByPlayer = false;
-			EnemyFeedback_reset(&s->fb);
-			Burn_reset(&s->burn);
-			SubSmolder_reset(&s->smolderCore);
-			if (s->theme == THEME_FIRE)
-				SubSmolder_activate_silent(&s->smolderCore, SubSmolder_get_config());
-			pl->position = s->spawnPoint;
-			pick_wander_target(s);
-			Audio_play_sample_at(&sampleRespawn, pl->position);
-		}
+		/* Respawn is a timer event; only reached if scheduling failed */
+		if (!TimerWheel_is_pending(respawnEvents[idx]))
+			schedule_respawn(idx);
 		break;
 	}
 
@@ -1033,7 +1034,8 @@ void Stalker_reset_all(void)
 		s->retreatTimer = 0;
 		s->retreatShotFired = false;
 		s->deathTimer = 0;
-		s->respawnTimer = 0;
+		TimerWheel_cancel(respawnEvents[i]);
+		Entity_set_ai_suspended(entityRefs[i], false);
 		EnemyFeedback_reset(&s->fb);
 		Burn_reset(&s->burn);
 		SubSmolder_reset(&s->smolderCore);
@@ -1,6 +1,8 @@
 #include "sub_blaze_core.h"
 #include "render.h"
 
+#include <stdio.h>
+
 /* --- Config singleton --- */
 
 static const SubBlazeConfig blazeConfig = {
@@ -19,9 +21,15 @@ const SubBlazeConfig *SubBlaze_get_config(void)
 
 void SubBlaze_init(SubBlazeCore *core, BlazeCorridorSegment *buffer, int max_segments)
 {
+	if (max_segments > HAZARD_GRID_CAPACITY) {
+		printf("WARNING: blaze corridor pool of %d exceeds hazard grid capacity, using %d\n",
+			max_segments, HAZARD_GRID_CAPACITY);
+		max_segments = HAZARD_GRID_CAPACITY;
+	}
 	core->segments = buffer;
 	core->max_segments = max_segments;
 	core->spawn_timer = 0;
+	HazardGrid_init(&core->grid, SubBlaze_get_config()->corridor_radius * 4.0);
 }
 
 /* --- Segment spawning --- */
@@ -37,6 +45,7 @@ void SubBlaze_spawn_segment(SubBlazeCore *core, Position pos)
 			core->segments[i].burn_tick_ms = 0;
 			Burn_reset(&core->segments[i].burn);
 			Burn_apply(&core->segments[i].burn, cfg->corridor_life_ms);
+			HazardGrid_insert(&core->grid, i, pos);
 			return;
 		}
 	}
@@ -55,6 +64,7 @@ void SubBlaze_update_corridor(SubBlazeCore *core, const SubBlazeConfig *cfg, uns
 		if (seg->life_ms <= 0) {
 			seg->active = false;
 			Burn_reset(&seg->burn);
+			HazardGrid_remove(&core->grid, i);
 			continue;
 		}
 
@@ -95,9 +105,13 @@ static bool circle_aabb_overlap(Position center, double radius, Rectangle r)
 
 int SubBlaze_check_corridor_burn(SubBlazeCore *core, const SubBlazeConfig *cfg, Rectangle target)
 {
+	int near[HAZARD_GRID_CAPACITY];
+	int n = HazardGrid_query(&core->grid, target, cfg->corridor_radius,
+		near, HAZARD_GRID_CAPACITY);
+
 	int hits = 0;
-	for (int i = 0; i < core->max_segments; i++) {
-		BlazeCorridorSegment *seg = &core->segments[i];
+	for (int k = 0; k < n; k++) {
+		BlazeCorridorSegment *seg = &core->segments[near[k]];
 		if (!seg->active)
 			continue;
 		if (seg->burn_tick_ms > 0)
@@ -119,6 +133,7 @@ void SubBlaze_deactivate_all(SubBlazeCore *core)
 		core->segments[i].active = false;
 		Burn_reset(&core->segments[i].burn);
 	}
+	HazardGrid_clear(&core->grid);
 }
 
 /* --- Rendering --- */
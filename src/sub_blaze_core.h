@@ -5,6 +5,7 @@
 #include "position.h"
 #include "collision.h"
 #include "burn.h"
+#include "hazard_grid.h"
 
 /* A single corridor segment left behind during a blaze dash */
 typedef struct {
@@ -23,11 +24,13 @@ typedef struct {
 	int segment_spawn_ms;       /* ms between segment deposits during dash */
 } SubBlazeConfig;
 
-/* Runtime state — points to an external segment buffer */
+/* Runtime state — points to an external segment buffer (at most
+   HAZARD_GRID_CAPACITY segments); live segments are indexed in grid */
 typedef struct {
 	BlazeCorridorSegment *segments;
 	int max_segments;
 	int spawn_timer;
+	HazardGrid grid;
 } SubBlazeCore;
 
 const SubBlazeConfig *SubBlaze_get_config(void);
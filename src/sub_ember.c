@@ -16,9 +16,6 @@
 static Entity *parent;
 static SubProjectilePool pool;
 
-/* Snapshot active states to detect wall impacts */
-static bool prevActive[SUB_PROJ_MAX_POOL];
-
 void Sub_Ember_initialize(Entity *parent_entity)
 {
 	parent = parent_entity;
@@ -52,32 +49,21 @@ void Sub_Ember_update(const Input *userInput, const unsigned int ticks, Placeabl
 		}
 	}
 
-	/* Snapshot before update to detect wall hits */
-	for (int i = 0; i < pool.poolSize; i++)
-		prevActive[i] = pool.projectiles[i].active;
-
 	SubProjectile_update(&pool, &cfg->proj, ticks);
 
-	/* Wall impacts — spark means a projectile hit a wall this frame */
-	for (int i = 0; i < pool.poolSize; i++) {
-		if (prevActive[i] && !pool.projectiles[i].active && pool.sparkActive)
-			SubEmber_add_burst(pool.sparkPosition);
-	}
+	/* Wall impacts */
+	for (int i = 0; i < pool.wallHits; i++)
+		SubEmber_add_burst(pool.sparkPosition);
 }
 
 void Sub_Ember_tick(unsigned int ticks)
 {
 	const SubEmberConfig *cfg = SubEmber_get_config();
 
-	for (int i = 0; i < pool.poolSize; i++)
-		prevActive[i] = pool.projectiles[i].active;
-
 	SubProjectile_update(&pool, &cfg->proj, ticks);
 
-	for (int i = 0; i < pool.poolSize; i++) {
-		if (prevActive[i] && !pool.projectiles[i].active && pool.sparkActive)
-			SubEmber_add_burst(pool.sparkPosition);
-	}
+	for (int i = 0; i < pool.wallHits; i++)
+		SubEmber_add_burst(pool.sparkPosition);
 }
 
 void Sub_Ember_render(void)
@@ -73,15 +73,8 @@ bool SubFlak_try_fire(SubProjectilePool *pool, const SubFlakConfig *cfg,
 	for (int i = 0; i < cfg->pellets_per_shot; i++) {
 		double offset = ((double)(rand() % 10000) / 10000.0 - 0.5) * 2.0 * spread_rad;
 		double pellet_rad = base_rad + offset;
-		SubProjectile_spawn_pellet(pool, origin, pellet_rad);
-	}
-	/* Apply per-pellet speed variation + volley ID to freshly spawned pellets */
-	for (int i = 0; i < pool->poolSize; i++) {
-		SubProjectile *p = &pool->projectiles[i];
-		if (p->active && p->ticksLived == 0) {
-			p->speedMult = 0.9 + (double)(rand() % 200) / 1000.0;
-			p->volley_id = vid;
-		}
+		double speed_mult = 0.9 + (double)(rand() % 200) / 1000.0;
+		SubProjectile_spawn_pellet_volley(pool, origin, pellet_rad, speed_mult, vid);
 	}
 
 	Audio_play_sample_at(&sampleFire, origin);
@@ -1,9 +1,11 @@
 #include "sub_projectile_core.h"
+#include "bullet_engine.h"
 #include "map.h"
 #include "render.h"
 #include "view.h"
 #include "audio.h"
 #include "color.h"
+#include "timer.h"
 
 #include <SDL2/SDL_mixer.h>
 #include <math.h>
@@ -15,6 +17,11 @@ static Mix_Chunk *sampleFire = 0;
 static Mix_Chunk *sampleHit = 0;
 static uint32_t volleyCounter = 0;
 
+/* Wall test results for the pool being updated */
+static bool wallHit[BULLET_ENGINE_CAPACITY];
+static double wallHitX[BULLET_ENGINE_CAPACITY];
+static double wallHitY[BULLET_ENGINE_CAPACITY];
+
 uint32_t SubProjectile_next_volley_id(void)
 {
 	return ++volleyCounter;
@@ -37,15 +44,79 @@ static double get_radians(double degrees)
 	return degrees * M_PI / 180.0;
 }
 
+/* Remove live projectile i by moving the last live one into its slot */
+static void remove_live(SubProjectilePool *pool, int i)
+{
+	pool->count--;
+	if (i != pool->count)
+		BulletEngine_move(pool->base + i, pool->base + pool->count);
+}
+
+static bool segment_misses(const BulletEngine *be, int s,
+	double minX, double minY, double maxX, double maxY)
+{
+	double x0 = be->prevX[s], x1 = be->x[s];
+	double y0 = be->prevY[s], y1 = be->y[s];
+	return (x0 < minX && x1 < minX) || (x0 > maxX && x1 > maxX)
+		|| (y0 < minY && y1 < minY) || (y0 > maxY && y1 > maxY);
+}
+
+static bool segment_hits(const BulletEngine *be, int s, Rectangle target,
+	double minX, double minY, double maxX, double maxY)
+{
+	if (segment_misses(be, s, minX, minY, maxX, maxY))
+		return false;
+	return Collision_line_aabb_test(be->prevX[s], be->prevY[s],
+		be->x[s], be->y[s], target, NULL);
+}
+
+/* Claim a slot for a new projectile, recycling the oldest when full */
+static int claim_slot(SubProjectilePool *pool, bool warn)
+{
+	if (pool->poolSize <= 0)
+		return -1;
+	if (pool->count < pool->poolSize)
+		return pool->base + pool->count++;
+
+	const BulletEngine *be = BulletEngine_get();
+	int oldest = pool->base;
+	for (int s = pool->base + 1; s < pool->base + pool->count; s++) {
+		if (be->ticksLived[s] > be->ticksLived[oldest])
+			oldest = s;
+	}
+	if (warn)
+		fprintf(stderr, "PROJECTILE: pool exhausted, recycling oldest\n");
+	return oldest;
+}
+
+static void spawn(int s, Position origin, double headingSin, double headingCos,
+	double speedMult, uint32_t volley_id)
+{
+	BulletEngine *be = BulletEngine_get();
+	be->x[s] = be->prevX[s] = origin.x;
+	be->y[s] = be->prevY[s] = origin.y;
+	be->dirX[s] = headingSin * speedMult;
+	be->dirY[s] = headingCos * speedMult;
+	be->ticksLived[s] = 0;
+	be->volley[s] = volley_id;
+}
+
 void SubProjectile_pool_init(SubProjectilePool *pool, int poolSize)
 {
-	pool->poolSize = poolSize;
+	/* Engine ranges are reserved once and reused on re-init */
+	if (pool->capacity < poolSize) {
+		int base = BulletEngine_reserve(poolSize);
+		if (base >= 0) {
+			pool->base = base;
+			pool->capacity = poolSize;
+		}
+	}
+	pool->poolSize = poolSize < pool->capacity ? poolSize : pool->capacity;
+	pool->count = 0;
 	pool->cooldownTimer = 0;
+	pool->wallHits = 0;
 	pool->sparkActive = false;
 	pool->sparkTicksLeft = 0;
-
-	for (int i = 0; i < poolSize; i++)
-		pool->projectiles[i].active = false;
 }
 
 bool SubProjectile_try_fire(SubProjectilePool *pool, const SubProjectileConfig *cfg,
@@ -56,36 +127,13 @@ bool SubProjectile_try_fire(SubProjectilePool *pool, const SubProjectileConfig *
 
 	pool->cooldownTimer = cfg->fire_cooldown_ms;
 
-	/* Find inactive slot */
-	int slot = -1;
-	for (int i = 0; i < pool->poolSize; i++) {
-		if (!pool->projectiles[i].active) {
-			slot = i;
-			break;
-		}
-	}
-	if (slot < 0) {
-		int oldest = 0;
-		for (int i = 1; i < pool->poolSize; i++) {
-			if (pool->projectiles[i].ticksLived > pool->projectiles[oldest].ticksLived)
-				oldest = i;
-		}
-		slot = oldest;
-		fprintf(stderr, "PROJECTILE: pool exhausted, recycling oldest\n");
-	}
-
-	SubProjectile *p = &pool->projectiles[slot];
-	p->active = true;
-	p->ticksLived = 0;
-	p->position = origin;
-	p->prevPosition = origin;
+	int slot = claim_slot(pool, true);
+	if (slot < 0)
+		return false;
 
 	double heading = Position_get_heading(origin, target);
 	double rad = get_radians(heading);
-	p->headingSin = sin(rad);
-	p->headingCos = cos(rad);
-	p->speedMult = 1.0;
-	p->volley_id = SubProjectile_next_volley_id();
+	spawn(slot, origin, sin(rad), cos(rad), 1.0, SubProjectile_next_volley_id());
 
 	Audio_play_sample_at(&sampleFire, origin);
 
@@ -97,38 +145,34 @@ void SubProjectile_update(SubProjectilePool *pool, const SubProjectileConfig *cf
 	if (pool->cooldownTimer > 0)
 		pool->cooldownTimer -= (int)ticks;
 
-	for (int i = 0; i < pool->poolSize; i++) {
-		SubProjectile *p = &pool->projectiles[i];
-		if (!p->active)
-			continue;
+	BulletEngine *be = BulletEngine_get();
+	pool->wallHits = 0;
 
-		p->ticksLived += ticks;
-		if (p->ticksLived > cfg->ttl_ms) {
-			p->active = false;
-			continue;
-		}
+	/* Expire first so dead projectiles are never moved. Walking backwards
+	   keeps swap-removal from skipping anyone. */
+	for (int i = pool->count - 1; i >= 0; i--) {
+		if (be->ticksLived[pool->base + i] + (int)ticks > cfg->ttl_ms)
+			remove_live(pool, i);
+	}
 
-		p->prevPosition = p->position;
-
-		double dt = ticks / 1000.0;
-		double spd = cfg->velocity * p->speedMult;
-		double dx = p->headingSin * spd * dt;
-		double dy = p->headingCos * spd * dt;
-		p->position.x += dx;
-		p->position.y += dy;
-
-		/* Wall collision */
-		double hx, hy;
-		if (Map_line_test_hit(p->prevPosition.x, p->prevPosition.y,
-				p->position.x, p->position.y, &hx, &hy)) {
-			pool->sparkActive = true;
-			pool->sparkPosition.x = hx;
-			pool->sparkPosition.y = hy;
-			pool->sparkTicksLeft = cfg->spark_duration_ms;
-			p->active = false;
-			Position hitPos = {hx, hy};
-			Audio_play_sample_at(&sampleHit, hitPos);
-		}
+	double step = cfg->velocity * (ticks / 1000.0);
+	BulletEngine_integrate(pool->base, pool->count, step, ticks);
+
+	/* Wall collision, walking backwards for the same reason */
+	int hits = BulletEngine_wall_test(pool->base, pool->count,
+		wallHit, wallHitX, wallHitY);
+	for (int i = pool->count - 1; i >= 0 && hits > 0; i--) {
+		if (!wallHit[i])
+			continue;
+		hits--;
+		pool->sparkActive = true;
+		pool->sparkPosition.x = wallHitX[i];
+		pool->sparkPosition.y = wallHitY[i];
+		pool->sparkTicksLeft = cfg->spark_duration_ms;
+		pool->wallHits++;
+		remove_live(pool, i);
+		Position hitPos = {wallHitX[i], wallHitY[i]};
+		Audio_play_sample_at(&sampleHit, hitPos);
 	}
 
 	/* Spark decay */
@@ -141,13 +185,13 @@ void SubProjectile_update(SubProjectilePool *pool, const SubProjectileConfig *cf
 
 double SubProjectile_check_hit(SubProjectilePool *pool, const SubProjectileConfig *cfg, Rectangle target)
 {
-	for (int i = 0; i < pool->poolSize; i++) {
-		SubProjectile *p = &pool->projectiles[i];
-		if (!p->active)
-			continue;
-		if (Collision_line_aabb_test(p->prevPosition.x, p->prevPosition.y,
-				p->position.x, p->position.y, target, NULL)) {
-			p->active = false;
+	const BulletEngine *be = BulletEngine_get();
+	double minX = fmin(target.aX, target.bX), maxX = fmax(target.aX, target.bX);
+	double minY = fmin(target.aY, target.bY), maxY = fmax(target.aY, target.bY);
+
+	for (int i = 0; i < pool->count; i++) {
+		if (segment_hits(be, pool->base + i, target, minX, minY, maxX, maxY)) {
+			remove_live(pool, i);
 			return cfg->damage;
 		}
 	}
@@ -156,13 +200,11 @@ double SubProjectile_check_hit(SubProjectilePool *pool, const SubProjectileConfi
 
 bool SubProjectile_check_nearby(const SubProjectilePool *pool, Position pos, double radius)
 {
+	const BulletEngine *be = BulletEngine_get();
 	double r2 = radius * radius;
-	for (int i = 0; i < pool->poolSize; i++) {
-		const SubProjectile *p = &pool->projectiles[i];
-		if (!p->active)
-			continue;
-		double dx = p->position.x - pos.x;
-		double dy = p->position.y - pos.y;
+	for (int s = pool->base; s < pool->base + pool->count; s++) {
+		double dx = be->x[s] - pos.x;
+		double dy = be->y[s] - pos.y;
 		if (dx * dx + dy * dy < r2)
 			return true;
 	}
@@ -171,8 +213,7 @@ bool SubProjectile_check_nearby(const SubProjectilePool *pool, Position pos, dou
 
 void SubProjectile_deactivate_all(SubProjectilePool *pool)
 {
-	for (int i = 0; i < pool->poolSize; i++)
-		pool->projectiles[i].active = false;
+	pool->count = 0;
 }
 
 float SubProjectile_get_cooldown_fraction(const SubProjectilePool *pool, const SubProjectileConfig *cfg)
@@ -183,101 +224,72 @@ float SubProjectile_get_cooldown_fraction(const SubProjectilePool *pool, const S
 
 bool SubProjectile_spawn_pellet(SubProjectilePool *pool, Position origin, double heading_rad)
 {
-	/* Find inactive slot */
-	int slot = -1;
-	for (int i = 0; i < pool->poolSize; i++) {
-		if (!pool->projectiles[i].active) {
-			slot = i;
-			break;
-		}
-	}
-	if (slot < 0) {
-		/* Recycle oldest */
-		int oldest = 0;
-		for (int i = 1; i < pool->poolSize; i++) {
-			if (pool->projectiles[i].ticksLived > pool->projectiles[oldest].ticksLived)
-				oldest = i;
-		}
-		slot = oldest;
-	}
+	return SubProjectile_spawn_pellet_volley(pool, origin, heading_rad, 1.0, 0);
+}
 
-	SubProjectile *p = &pool->projectiles[slot];
-	p->active = true;
-	p->ticksLived = 0;
-	p->position = origin;
-	p->prevPosition = origin;
-	p->headingSin = sin(heading_rad);
-	p->headingCos = cos(heading_rad);
-	p->speedMult = 1.0;
-	p->volley_id = 0;
+bool SubProjectile_spawn_pellet_volley(SubProjectilePool *pool, Position origin,
+	double heading_rad, double speed_mult, uint32_t volley_id)
+{
+	int slot = claim_slot(pool, false);
+	if (slot < 0)
+		return false;
+	spawn(slot, origin, sin(heading_rad), cos(heading_rad), speed_mult, volley_id);
 	return true;
 }
 
+/* Index of volley_id in result, adding it if there is room; -1 otherwise */
+static int track_volley(SubProjectileHitResult *result, uint32_t volley_id)
+{
+	for (int v = 0; v < result->volley_count; v++) {
+		if (result->volley_ids[v] == volley_id)
+			return v;
+	}
+	if (result->volley_count >= SUB_PROJ_MAX_VOLLEYS)
+		return -1;
+	int vi = result->volley_count++;
+	result->volley_ids[vi] = volley_id;
+	result->volley_hits[vi] = 0;
+	return vi;
+}
+
 SubProjectileHitResult SubProjectile_check_hit_multi(SubProjectilePool *pool,
 	const SubProjectileConfig *cfg, Rectangle target)
 {
-	SubProjectileHitResult result = {0.0, 0, 0, {0}, {0}};
-	for (int i = 0; i < pool->poolSize; i++) {
-		SubProjectile *p = &pool->projectiles[i];
-		if (!p->active)
-			continue;
-		if (Collision_line_aabb_test(p->prevPosition.x, p->prevPosition.y,
-				p->position.x, p->position.y, target, NULL)) {
-			p->active = false;
-			result.damage += cfg->damage;
-			result.hits++;
-
-			/* Track per-volley hits */
-			int vi = -1;
-			for (int v = 0; v < result.volley_count; v++) {
-				if (result.volley_ids[v] == p->volley_id) { vi = v; break; }
-			}
-			if (vi < 0 && result.volley_count < SUB_PROJ_MAX_VOLLEYS) {
-				vi = result.volley_count++;
-				result.volley_ids[vi] = p->volley_id;
-				result.volley_hits[vi] = 0;
-			}
-			if (vi >= 0)
-				result.volley_hits[vi]++;
-		}
-	}
-	return result;
+	return SubProjectile_check_hit_multi_capped(pool, cfg, target, 0);
 }
 
 SubProjectileHitResult SubProjectile_check_hit_multi_capped(SubProjectilePool *pool,
 	const SubProjectileConfig *cfg, Rectangle target, int max_per_volley)
 {
 	SubProjectileHitResult result = {0.0, 0, 0, {0}, {0}};
-	for (int i = 0; i < pool->poolSize; i++) {
-		SubProjectile *p = &pool->projectiles[i];
-		if (!p->active)
+	const BulletEngine *be = BulletEngine_get();
+	double minX = fmin(target.aX, target.bX), maxX = fmax(target.aX, target.bX);
+	double minY = fmin(target.aY, target.bY), maxY = fmax(target.aY, target.bY);
+
+	int i = 0;
+	while (i < pool->count) {
+		int s = pool->base + i;
+		if (!segment_hits(be, s, target, minX, minY, maxX, maxY)) {
+			i++;
 			continue;
-		if (Collision_line_aabb_test(p->prevPosition.x, p->prevPosition.y,
-				p->position.x, p->position.y, target, NULL)) {
-
-			/* Check volley cap before accepting this hit */
-			if (max_per_volley > 0 && p->volley_id != 0) {
-				int vi = -1;
-				for (int v = 0; v < result.volley_count; v++) {
-					if (result.volley_ids[v] == p->volley_id) { vi = v; break; }
-				}
-				if (vi >= 0 && result.volley_hits[vi] >= max_per_volley) {
-					p->active = false; /* projectile consumed but no damage */
-					continue;
-				}
-				if (vi < 0 && result.volley_count < SUB_PROJ_MAX_VOLLEYS) {
-					vi = result.volley_count++;
-					result.volley_ids[vi] = p->volley_id;
-					result.volley_hits[vi] = 0;
-				}
-				if (vi >= 0)
-					result.volley_hits[vi]++;
-			}
+		}
 
-			p->active = false;
-			result.damage += cfg->damage;
-			result.hits++;
+		/* Per-volley tracking; the cap only applies to real volleys */
+		uint32_t volley_id = be->volley[s];
+		bool capped = max_per_volley > 0 && volley_id != 0;
+		if (max_per_volley == 0 || capped) {
+			int vi = track_volley(&result, volley_id);
+			if (capped && vi >= 0 && result.volley_hits[vi] >= max_per_volley) {
+				remove_live(pool, i); /* projectile consumed but no damage */
+				continue;
+			}
+			if (vi >= 0)
+				result.volley_hits[vi]++;
 		}
+
+		remove_live(pool, i);
+		result.damage += cfg->damage;
+		result.hits++;
 	}
 	return result;
 }
@@ -285,23 +297,28 @@ SubProjectileHitResult SubProjectile_check_hit_multi_capped(SubProjectilePool *p
 void SubProjectile_render(const SubProjectilePool *pool, const SubProjectileConfig *cfg)
 {
 	View view = View_get_view();
+	const BulletEngine *be = BulletEngine_get();
 
-	for (int i = 0; i < pool->poolSize; i++) {
-		const SubProjectile *p = &pool->projectiles[i];
-		if (!p->active)
-			continue;
+	double size = cfg->point_size * view.scale;
+	if (size < cfg->min_point_size)
+		size = cfg->min_point_size;
+	ColorFloat color = {cfg->color_r, cfg->color_g, cfg->color_b, 1.0f};
+
+	/* Heads are drawn between the last two simulation steps; the trail
+	   keeps the length of one step behind them */
+	double alpha = timer_render_alpha();
+	for (int s = pool->base; s < pool->base + pool->count; s++) {
+		double stepX = be->x[s] - be->prevX[s];
+		double stepY = be->y[s] - be->prevY[s];
+		Position position = {be->prevX[s] + stepX * alpha, be->prevY[s] + stepY * alpha};
 
 		/* Motion trail */
 		Render_thick_line(
-			(float)p->prevPosition.x, (float)p->prevPosition.y,
-			(float)p->position.x, (float)p->position.y,
+			(float)(position.x - stepX), (float)(position.y - stepY),
+			(float)position.x, (float)position.y,
 			cfg->trail_thickness, cfg->color_r, cfg->color_g, cfg->color_b, cfg->trail_alpha);
 
-		double size = cfg->point_size * view.scale;
-		if (size < cfg->min_point_size)
-			size = cfg->min_point_size;
-		ColorFloat color = {cfg->color_r, cfg->color_g, cfg->color_b, 1.0f};
-		Render_point(&p->position, size, &color);
+		Render_point(&position, size, &color);
 	}
 
 	if (pool->sparkActive) {
@@ -320,12 +337,12 @@ void SubProjectile_render_bloom(const SubProjectilePool *pool, const SubProjecti
 
 void SubProjectile_render_light(const SubProjectilePool *pool, const SubProjectileConfig *cfg)
 {
-	for (int i = 0; i < pool->poolSize; i++) {
-		const SubProjectile *p = &pool->projectiles[i];
-		if (!p->active)
-			continue;
+	const BulletEngine *be = BulletEngine_get();
+	double alpha = timer_render_alpha();
+	for (int s = pool->base; s < pool->base + pool->count; s++) {
 		Render_filled_circle(
-			(float)p->position.x, (float)p->position.y,
+			(float)(be->prevX[s] + (be->x[s] - be->prevX[s]) * alpha),
+			(float)(be->prevY[s] + (be->y[s] - be->prevY[s]) * alpha),
 			cfg->light_proj_radius, 12,
 			cfg->light_proj_r, cfg->light_proj_g, cfg->light_proj_b, cfg->light_proj_a);
 	}
@@ -6,23 +6,15 @@
 #include "position.h"
 #include "collision.h"
 
-#define SUB_PROJ_MAX_POOL 256
-
-typedef struct {
-	bool active;
-	Position position;
-	Position prevPosition;
-	double headingSin;
-	double headingCos;
-	double speedMult;   /* per-pellet speed multiplier (default 1.0) */
-	int ticksLived;
-	uint32_t volley_id; /* identifies which firing event spawned this projectile */
-} SubProjectile;
-
+/* Per-weapon view over the shared bullet engine (bullet_engine.h). Live
+   projectiles are packed at engine slots [base, base + count). */
 typedef struct {
-	SubProjectile projectiles[SUB_PROJ_MAX_POOL];
+	int base;           /* first reserved engine slot */
+	int capacity;       /* reserved slots (0 = not reserved yet) */
+	int count;          /* live projectiles */
 	int poolSize;
 	int cooldownTimer;
+	int wallHits;       /* projectiles that hit a wall during the last update */
 	bool sparkActive;
 	Position sparkPosition;
 	int sparkTicksLeft;
@@ -64,6 +56,9 @@ float SubProjectile_get_cooldown_fraction(const SubProjectilePool *pool, const S
 
 /* Spawn a single pellet at explicit heading (radians). No cooldown/sound. */
 bool SubProjectile_spawn_pellet(SubProjectilePool *pool, Position origin, double heading_rad);
+/* As above with a per-pellet speed multiplier and volley ID */
+bool SubProjectile_spawn_pellet_volley(SubProjectilePool *pool, Position origin,
+	double heading_rad, double speed_mult, uint32_t volley_id);
 
 /* Check hits against ALL projectiles, returns total damage + hit count. */
 #define SUB_PROJ_MAX_VOLLEYS 8  /* max distinct volleys tracked per hit check */
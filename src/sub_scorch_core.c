@@ -3,6 +3,7 @@
 #include "audio.h"
 
 #include <SDL2/SDL_mixer.h>
+#include <stdio.h>
 
 /* --- Config singleton --- */
 
@@ -82,10 +83,16 @@ float SubScorch_get_cooldown_fraction(const SubScorchCore *core, const SubScorch
 
 void SubScorch_pool_init(ScorchFootprintPool *pool, ScorchFootprint *buffer, int max)
 {
+	if (max > HAZARD_GRID_CAPACITY) {
+		printf("WARNING: scorch footprint pool of %d exceeds hazard grid capacity, using %d\n",
+			max, HAZARD_GRID_CAPACITY);
+		max = HAZARD_GRID_CAPACITY;
+	}
 	pool->data = buffer;
 	pool->max = max;
 	for (int i = 0; i < max; i++)
 		buffer[i].active = false;
+	HazardGrid_init(&pool->grid, scorchConfig.footprint_radius * 4.0);
 }
 
 void SubScorch_pool_spawn(ScorchFootprintPool *pool, const SubScorchConfig *cfg, Position pos)
@@ -101,6 +108,7 @@ void SubScorch_pool_spawn(ScorchFootprintPool *pool, const SubScorchConfig *cfg,
 			pool->data[i].burn_tick_ms = 0;
 			Burn_reset(&pool->data[i].burn);
 			Burn_apply(&pool->data[i].burn, cfg->footprint_life_ms);
+			HazardGrid_insert(&pool->grid, i, pos);
 			return;
 		}
 	}
@@ -121,6 +129,7 @@ void SubScorch_pool_update(ScorchFootprintPool *pool, const SubScorchConfig *cfg
 		if (fp->life_ms <= 0) {
 			fp->active = false;
 			Burn_reset(&fp->burn);
+			HazardGrid_remove(&pool->grid, i);
 			continue;
 		}
 
@@ -157,9 +166,13 @@ int SubScorch_pool_check_burn(ScorchFootprintPool *pool, const SubScorchConfig *
 	if (!pool->data)
 		return 0;
 
+	int near[HAZARD_GRID_CAPACITY];
+	int n = HazardGrid_query(&pool->grid, target, cfg->footprint_radius,
+		near, HAZARD_GRID_CAPACITY);
+
 	int hits = 0;
-	for (int i = 0; i < pool->max; i++) {
-		ScorchFootprint *fp = &pool->data[i];
+	for (int k = 0; k < n; k++) {
+		ScorchFootprint *fp = &pool->data[near[k]];
 		if (!fp->active)
 			continue;
 		if (fp->burn_tick_ms > 0)
@@ -182,6 +195,7 @@ void SubScorch_pool_deactivate_all(ScorchFootprintPool *pool)
 		pool->data[i].active = false;
 		Burn_reset(&pool->data[i].burn);
 	}
+	HazardGrid_clear(&pool->grid);
 }
 
 /* --- Pool rendering --- */
@@ -6,6 +6,7 @@
 #include "collision.h"
 #include "burn.h"
 #include "sub_sprint_core.h"
+#include "hazard_grid.h"
 
 /*
  * Sub Scorch Core — Burning sprint trail (fire variant of sprint)
@@ -38,10 +39,12 @@ typedef struct {
 	int footprint_timer;        /* accumulator for deposit spacing */
 } SubScorchCore;
 
-/* Footprint pool handle — each user (player, corruptor) owns one */
+/* Footprint pool handle — each user (player, corruptor) owns one.
+   At most HAZARD_GRID_CAPACITY footprints; live ones are indexed in grid. */
 typedef struct {
 	ScorchFootprint *data;
 	int max;
+	HazardGrid grid;
 } ScorchFootprintPool;
 
 const SubScorchConfig *SubScorch_get_config(void);
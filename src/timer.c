@@ -4,6 +4,11 @@ static unsigned int currentTicks = 0;
 static unsigned int lastTicks = 0;
 static unsigned int ticksThisIteration = 0;
 
+static unsigned int simRate = DEFAULT_SIM_RATE;
+static unsigned int stepMs = 1000 / DEFAULT_SIM_RATE;
+static unsigned int accumulator = 0;
+static double renderAlpha = 1.0;
+
 unsigned int timer_tick(void) {
 	lastTicks = currentTicks;
 	currentTicks = SDL_GetTicks();
@@ -13,4 +18,66 @@ unsigned int timer_tick(void) {
 		return MAX_TICKS;
 	else
 		return ticksThisIteration;
-}
\ No newline at end of file
+}
+
+void timer_set_rate(unsigned int hz)
+{
+	if (hz < 10)
+		hz = 10;
+	if (hz > 1000)
+		hz = 1000;
+	simRate = hz;
+	stepMs = (1000 + hz / 2) / hz;
+}
+
+unsigned int timer_get_rate(void)
+{
+	return simRate;
+}
+
+unsigned int timer_step_ms(void)
+{
+	return stepMs;
+}
+
+int timer_steps_due(void)
+{
+	accumulator += timer_tick();
+
+	unsigned int steps = accumulator / stepMs;
+	if (steps > MAX_STEPS_PER_FRAME) {
+		steps = MAX_STEPS_PER_FRAME;
+		accumulator %= stepMs;
+	} else {
+		accumulator -= steps * stepMs;
+	}
+	return (int)steps;
+}
+
+unsigned int timer_ms_until_step(void)
+{
+	return accumulator < stepMs ? stepMs - accumulator : 0;
+}
+
+void timer_begin_render(void)
+{
+	renderAlpha = (double)accumulator / stepMs;
+}
+
+void timer_end_render(void)
+{
+	renderAlpha = 1.0;
+}
+
+double timer_render_alpha(void)
+{
+	return renderAlpha;
+}
+
+double timer_lap_ms(Uint64 *since)
+{
+	Uint64 now = SDL_GetPerformanceCounter();
+	double ms = (double)(now - *since) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+	*since = now;
+	return ms;
+}
@@ -5,6 +5,31 @@
 
 #define MAX_TICKS 500
 
+/* Simulation runs in fixed steps of 1000 / rate ms (whole milliseconds, so
+   rates that don't divide 1000 round to the nearest step) */
+#define DEFAULT_SIM_RATE 120
+#define MAX_STEPS_PER_FRAME 8
+
 unsigned int timer_tick(void);
 
-#endif
\ No newline at end of file
+void timer_set_rate(unsigned int hz);
+unsigned int timer_get_rate(void);
+unsigned int timer_step_ms(void);
+/* Accumulate real time since the last call; returns the number of fixed
+   steps to simulate this frame. Backlog beyond MAX_STEPS_PER_FRAME is
+   dropped so a slow machine slows down instead of spiralling. */
+int timer_steps_due(void);
+/* Milliseconds until the next step is due */
+unsigned int timer_ms_until_step(void);
+/* Milliseconds since *since (a performance counter value), which is then
+   advanced to now; for timing consecutive phases */
+double timer_lap_ms(Uint64 *since);
+
+/* Interpolation factor between the last two simulation states. Only
+   meaningful inside timer_begin_render/timer_end_render; 1.0 otherwise,
+   so simulation code always sees the latest state. */
+void timer_begin_render(void);
+void timer_end_render(void);
+double timer_render_alpha(void);
+
+#endif
@@ -0,0 +1,214 @@
+#include "timer_wheel.h"
+
+#include <stdio.h>
+
+#define LEVEL0_BITS 8
+#define LEVELN_BITS 6
+#define LEVEL0_SIZE (1 << LEVEL0_BITS)
+#define LEVELN_SIZE (1 << LEVELN_BITS)
+#define LEVEL0_MASK (LEVEL0_SIZE - 1)
+#define LEVELN_MASK (LEVELN_SIZE - 1)
+#define UPPER_LEVELS 3
+/* Delays at or beyond this are filed at the far end of the last level */
+#define MAX_SPAN (1u << (LEVEL0_BITS + UPPER_LEVELS * LEVELN_BITS))
+
+#define LIST_COUNT (LEVEL0_SIZE + UPPER_LEVELS * LEVELN_SIZE)
+
+/* Events live in a fixed pool threaded onto per-slot doubly linked lists
+   so cancel unlinks in O(1); list heads for every level share one array */
+static int heads[LIST_COUNT];
+static int next[TIMER_WHEEL_CAPACITY];
+static int prev[TIMER_WHEEL_CAPACITY];
+static int listOf[TIMER_WHEEL_CAPACITY];	/* -1 = free */
+static unsigned int due[TIMER_WHEEL_CAPACITY];
+static TimerFunc funcs[TIMER_WHEEL_CAPACITY];
+static int args[TIMER_WHEEL_CAPACITY];
+static unsigned int generations[TIMER_WHEEL_CAPACITY];
+
+static int freeEvents[TIMER_WHEEL_CAPACITY];
+static int freeCount = 0;
+static bool ready = false;
+static bool fullWarned = false;
+
+/* now: current time, every event due at or before it has fired.
+   nextTick: first millisecond not yet processed (now + 1). */
+static unsigned int now = 0;
+static unsigned int nextTick = 1;
+
+static TimerWheelStats stats;
+
+static int list_for(unsigned int expires)
+{
+	unsigned int delta = expires - nextTick;
+	if ((int)delta < 0)
+		return (int)(nextTick & LEVEL0_MASK);	/* overdue: next tick */
+	if (delta < LEVEL0_SIZE)
+		return (int)(expires & LEVEL0_MASK);
+	if (delta >= MAX_SPAN)
+		expires = nextTick + MAX_SPAN - 1;
+	for (int level = 1; level <= UPPER_LEVELS; level++) {
+		int shift = LEVEL0_BITS + level * LEVELN_BITS;
+		if (level == UPPER_LEVELS || delta < (1u << shift)) {
+			int slot = (int)((expires >> (shift - LEVELN_BITS)) & LEVELN_MASK);
+			return LEVEL0_SIZE + (level - 1) * LEVELN_SIZE + slot;
+		}
+	}
+	return 0;
+}
+
+static void link_event(int e)
+{
+	int list = list_for(due[e]);
+	listOf[e] = list;
+	prev[e] = -1;
+	next[e] = heads[list];
+	if (heads[list] >= 0)
+		prev[heads[list]] = e;
+	heads[list] = e;
+}
+
+static void unlink_event(int e)
+{
+	if (prev[e] >= 0)
+		next[prev[e]] = next[e];
+	else
+		heads[listOf[e]] = next[e];
+	if (next[e] >= 0)
+		prev[next[e]] = prev[e];
+	listOf[e] = -1;
+}
+
+static void free_event(int e)
+{
+	generations[e]++;
+	freeEvents[freeCount++] = e;
+	stats.pending--;
+}
+
+/* Re-file one upper-level slot; returns the slot so the caller knows
+   whether the next level up has wrapped too */
+static int cascade(int level, int slot)
+{
+	int list = LEVEL0_SIZE + (level - 1) * LEVELN_SIZE + slot;
+	int e = heads[list];
+	heads[list] = -1;
+	while (e >= 0) {
+		int n = next[e];
+		link_event(e);
+		stats.cascaded++;
+		e = n;
+	}
+	return slot;
+}
+
+void TimerWheel_clear(void)
+{
+	/* Generations start at 1 so a zeroed handle is never pending */
+	for (int e = 0; e < TIMER_WHEEL_CAPACITY; e++) {
+		generations[e]++;
+		listOf[e] = -1;
+		freeEvents[e] = TIMER_WHEEL_CAPACITY - 1 - e;
+	}
+	freeCount = TIMER_WHEEL_CAPACITY;
+	for (int l = 0; l < LIST_COUNT; l++)
+		heads[l] = -1;
+	now = 0;
+	nextTick = 1;
+	stats = (TimerWheelStats){0};
+	fullWarned = false;
+	ready = true;
+}
+
+TimerHandle TimerWheel_schedule(unsigned int delay_ms, TimerFunc func, int arg)
+{
+	if (!ready)
+		TimerWheel_clear();
+
+	if (freeCount == 0) {
+		if (!fullWarned)
+			printf("WARNING: Timer wheel full (%d)\n", TIMER_WHEEL_CAPACITY);
+		fullWarned = true;
+		return (TimerHandle){0, 0};
+	}
+
+	int e = freeEvents[--freeCount];
+	due[e] = now + (delay_ms > 0 ? delay_ms : 1);
+	funcs[e] = func;
+	args[e] = arg;
+	link_event(e);
+	stats.scheduled++;
+	stats.pending++;
+	return (TimerHandle){(unsigned int)e, generations[e]};
+}
+
+bool TimerWheel_is_pending(TimerHandle handle)
+{
+	return handle.index < TIMER_WHEEL_CAPACITY && handle.generation != 0 &&
+		generations[handle.index] == handle.generation &&
+		listOf[handle.index] >= 0;
+}
+
+void TimerWheel_cancel(TimerHandle handle)
+{
+	if (!TimerWheel_is_pending(handle))
+		return;
+	unlink_event((int)handle.index);
+	free_event((int)handle.index);
+	stats.cancelled++;
+}
+
+void TimerWheel_advance(unsigned int ticks)
+{
+	if (!ready)
+		TimerWheel_clear();
+
+	int pending = stats.pending;
+	stats = (TimerWheelStats){0};
+	stats.pending = pending;
+
+	unsigned int target = now + ticks;
+	if (pending == 0) {
+		/* Nothing filed anywhere, so there is nothing to cascade either */
+		now = target;
+		nextTick = target + 1;
+		return;
+	}
+
+	while ((int)(target - nextTick) >= 0) {
+		int slot = (int)(nextTick & LEVEL0_MASK);
+		if (slot == 0) {
+			/* Level 0 wrapped: pull the next stretch down from above */
+			for (int level = 1; level <= UPPER_LEVELS; level++) {
+				int shift = LEVEL0_BITS + (level - 1) * LEVELN_BITS;
+				if (cascade(level, (int)((nextTick >> shift) & LEVELN_MASK)) != 0)
+					break;
+			}
+		}
+
+		/* Callbacks see the time they were due and may schedule more; a
+		   new event is due at least a tick later, so it never lands in the
+		   slot being drained */
+		now = nextTick;
+		int e;
+		while ((e = heads[slot]) >= 0) {
+			TimerFunc func = funcs[e];
+			int arg = args[e];
+			unlink_event(e);
+			free_event(e);
+			stats.fired++;
+			func(arg);
+		}
+		nextTick++;
+	}
+	now = target;
+}
+
+unsigned int TimerWheel_now(void)
+{
+	return now;
+}
+
+const TimerWheelStats *TimerWheel_get_stats(void)
+{
+	return &stats;
+}
@@ -0,0 +1,49 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdbool.h>
+
+/*
+ * Hierarchical timer wheel on the simulation clock (whole milliseconds).
+ * Modules schedule one-shot events ("respawn enemy 12 in 30 s") instead of
+ * adding ticks to a counter every frame, so whatever is waiting on an event
+ * is not touched until it fires. Four levels: 256 one-ms slots, then three
+ * levels of 64 slots that cascade down as the clock reaches them, covering
+ * about 18 hours; longer delays are parked in the last level and re-filed.
+ * Scheduling, cancelling and firing are O(1); each event cascades at most
+ * three times.
+ */
+#define TIMER_WHEEL_CAPACITY 32768
+
+typedef void (*TimerFunc)(int arg);
+
+/* Event index plus its generation, like EntityHandle. Goes stale once the
+   event fires or is cancelled; a zeroed handle is never pending. */
+typedef struct {
+	unsigned int index;
+	unsigned int generation;
+} TimerHandle;
+
+/* Counters since the last TimerWheel_advance (see the FPS overlay) */
+typedef struct {
+	int scheduled;   /* events added */
+	int cancelled;   /* removed before firing */
+	int cascaded;    /* re-filed from an upper level into a finer one */
+	int fired;       /* callbacks run */
+	int pending;     /* events waiting in the wheel */
+} TimerWheelStats;
+
+/* Drop every pending event without firing it and restart the clock at 0 */
+void TimerWheel_clear(void);
+/* Fire func(arg) once delay_ms of simulation time has passed (at the next
+   advance for 0). Returns a zeroed handle if the wheel is full. */
+TimerHandle TimerWheel_schedule(unsigned int delay_ms, TimerFunc func, int arg);
+/* No-op if the event already fired or was cancelled */
+void TimerWheel_cancel(TimerHandle handle);
+bool TimerWheel_is_pending(TimerHandle handle);
+/* Run the clock forward, firing due events in order of due time */
+void TimerWheel_advance(unsigned int ticks);
+unsigned int TimerWheel_now(void);
+const TimerWheelStats *TimerWheel_get_stats(void);
+
+#endif
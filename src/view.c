@@ -1,5 +1,6 @@
 #include "view.h"
 #include "graphics.h"
+#include "timer.h"
 #include <math.h>
 
 const double MAX_ZOOM = 4.0;
@@ -10,12 +11,43 @@ const double ZOOM_OUT_RATE = 0.95;
 static double minZoom = 0.25;
 static bool pixelSnapping = true;
 static View view;
+static View prevView;   /* view at the start of the current simulation step */
+
+/* Camera jumps longer than this (warps, respawns) snap instead of sliding.
+   Looser than the entities' INTERP_SNAP_DISTANCE: zoomed-out god mode pans
+   the camera far more than 500 units in a legitimate step. */
+#define VIEW_SNAP_DISTANCE 2000.0
+
+/* The view as seen by the renderer, between the last two simulation steps */
+static View rendered_view(void)
+{
+	double alpha = timer_render_alpha();
+	if (alpha >= 1.0)
+		return view;
+
+	double dx = view.position.x - prevView.position.x;
+	double dy = view.position.y - prevView.position.y;
+	if (dx * dx + dy * dy > VIEW_SNAP_DISTANCE * VIEW_SNAP_DISTANCE)
+		return view;
+
+	View v;
+	v.position.x = prevView.position.x + dx * alpha;
+	v.position.y = prevView.position.y + dy * alpha;
+	v.scale = prevView.scale + (view.scale - prevView.scale) * alpha;
+	return v;
+}
 
 void View_initialize()
 {
 	view.position.x = 0.0;
 	view.position.y = 0.0;
 	view.scale = 0.5;
+	prevView = view;
+}
+
+void View_snapshot(void)
+{
+	prevView = view;
 }
 
 void View_update(const Input *input, const unsigned int ticks)
@@ -33,8 +65,9 @@ void View_update(const Input *input, const unsigned int ticks)
 
 Mat4 View_get_transform(const Screen *screen)
 {
-	double x = (screen->norm_w / 2.0) - (view.position.x * view.scale);
-	double y = (screen->norm_h / 2.0) - (view.position.y * view.scale);
+	View v = rendered_view();
+	double x = (screen->norm_w / 2.0) - (v.position.x * v.scale);
+	double y = (screen->norm_h / 2.0) - (v.position.y * v.scale);
 
 	/* Snap to physical pixel grid to prevent subpixel jitter on thin geometry.
 	   One norm unit != one physical pixel — compute the actual pixel step. */
@@ -48,7 +81,7 @@ Mat4 View_get_transform(const Screen *screen)
 	}
 
 	Mat4 t = Mat4_translate((float)x, (float)y, 0.0f);
-	Mat4 s = Mat4_scale((float)view.scale, (float)view.scale, 1.0f);
+	Mat4 s = Mat4_scale((float)v.scale, (float)v.scale, 1.0f);
 	return Mat4_multiply(&t, &s);
 }
 
@@ -75,7 +108,7 @@ Position View_get_world_position(const Screen *screen, const Position screenPosi
 
 const View View_get_view(void)
 {
-	return view;
+	return rendered_view();
 }
 
 void View_set_position(const Position position)
@@ -14,6 +14,8 @@ typedef struct {
 
 void View_initialize();
 void View_update(const Input *input, const unsigned int ticks);
+/* Record the view at the start of a simulation step for interpolation */
+void View_snapshot(void);
 Mat4 View_get_transform(const Screen *screen);
 Position View_get_world_position(const Screen *screen, const Position uiPosition);
 const View View_get_view(void);
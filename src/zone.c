@@ -18,10 +18,15 @@
 #include "enemy_registry.h"
 #include "fog_of_war.h"
 #include "spatial_grid.h"
+#include "zone_index.h"
+#include "timer.h"
 
+#include <SDL2/SDL.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
+#include <stdint.h>
 
 /* --- Undo system --- */
 
@@ -60,19 +65,84 @@ static Zone zone;
 static UndoEntry undoStack[ZONE_MAX_UNDO];
 static int undoCount = 0;
 static bool zoneDirty = false;
+static ZoneLoadTimings loadTimings;
+
+/* Which spawns passed their probability roll in the last Zone_spawn_enemies;
+   only meaningful for the loaded zone once spawnRollsValid is set */
+static uint8_t spawnRolled[ZONE_MAX_SPAWNS / 8];
+static bool spawnRollsValid = false;
+
+/* Marker lookup for god mode, one index per ZoneMarkerKind. Edits keep it
+   in step; wholesale changes (load, restore, regenerate) mark it stale
+   and it is rebuilt on next use. */
+static ZoneIndexEntry spawnEntries[ZONE_MAX_SPAWNS];
+static ZoneIndexEntry portalEntries[ZONE_MAX_PORTALS];
+static ZoneIndexEntry savepointEntries[ZONE_MAX_SAVEPOINTS];
+static ZoneIndexEntry datanodeEntries[ZONE_MAX_DATANODES];
+static ZoneIndexEntry labelEntries[ZONE_MAX_LABELS];
+static ZoneIndex markerIndex[ZONE_MARKER_KIND_COUNT];
+static bool markerIndexReady = false;
+
+/* --- Checkpoint snapshot ---
+ * The generated zone packed into one buffer: the Zone struct in field
+ * order, with the cell grid narrowed to a byte per cell, only the used
+ * spawn entries, and the per-cell flags as bits. About 1.3 MB against
+ * the struct's 9 MB. */
+
+static struct {
+	bool valid;
+	char path[256];
+	uint8_t *data;
+	size_t size;
+	size_t capacity;
+} snapshot;
+
+static void snapshot_put(const void *src, size_t n)
+{
+	if (snapshot.size + n > snapshot.capacity) {
+		size_t cap = snapshot.capacity ? snapshot.capacity : 1 << 20;
+		while (cap < snapshot.size + n)
+			cap *= 2;
+		uint8_t *grown = realloc(snapshot.data, cap);
+		if (!grown) {
+			printf("WARNING: zone snapshot allocation failed\n");
+			snapshot.valid = false;
+			return;
+		}
+		snapshot.data = grown;
+		snapshot.capacity = cap;
+	}
+	memcpy(snapshot.data + snapshot.size, src, n);
+	snapshot.size += n;
+}
+
+static const uint8_t *snapshot_get(const uint8_t *src, void *dst, size_t n)
+{
+	memcpy(dst, src, n);
+	return src + n;
+}
+
 
 static int find_cell_type(const char *id);
 static void apply_zone_to_world(void);
+static void spawn_enemy(const ZoneSpawn *sp);
 /* Now public — declared in zone.h */
 static void respawn_portals(void);
 static void respawn_savepoints(void);
 static void respawn_datanodes(void);
 static void push_undo(UndoEntry entry);
+static void reset_spawn_rolls(void);
+static ZoneIndex *marker_index(ZoneMarkerKind kind);
+static int find_marker_at(ZoneMarkerKind kind, int grid_x, int grid_y);
+static double grid_to_world(int grid);
 
 /* --- Loading --- */
 
 void Zone_load(const char *path)
 {
+	memset(&loadTimings, 0, sizeof(loadTimings));
+	Uint64 lap = SDL_GetPerformanceCounter();
+
 	FILE *f = fopen(path, "r");
 	if (!f) {
 		printf("Zone_load: failed to open '%s'\n", path);
@@ -81,6 +151,8 @@ void Zone_load(const char *path)
 
 	/* Reset zone state */
 	memset(&zone, 0, sizeof(zone));
+	markerIndexReady = false;
+	reset_spawn_rolls();
 	for (int x = 0; x < MAP_SIZE; x++)
 		for (int y = 0; y < MAP_SIZE; y++)
 			zone.cell_grid[x][y] = -1;
@@ -398,11 +470,15 @@ void Zone_load(const char *path)
 	zone.hand_spawn_count = zone.spawn_count;
 	zone.hand_datanode_count = zone.datanode_count;
 
+	loadTimings.parse = timer_lap_ms(&lap);
+
 	/* Generate procgen terrain before applying to world */
 	if (zone.procgen)
 		Procgen_generate(&zone);
+	loadTimings.procgen = timer_lap_ms(&lap);
 
 	apply_zone_to_world();
+	loadTimings.apply = timer_lap_ms(&lap);
 
 	printf("Zone_load: loaded '%s' (%d cell types, %d spawns, %d portals, %d savepoints)\n",
 		zone.name, zone.cell_type_count, zone.spawn_count, zone.portal_count, zone.savepoint_count);
@@ -423,11 +499,17 @@ void Zone_unload(void)
 	Portal_cleanup();
 	Savepoint_cleanup();
 	DataNode_cleanup();
-	Entity_recalculate_highest_index();
 	memset(&zone, 0, sizeof(zone));
+	markerIndexReady = false;
+	reset_spawn_rolls();
 	undoCount = 0;
 }
 
+const ZoneLoadTimings *Zone_get_load_timings(void)
+{
+	return &loadTimings;
+}
+
 const Zone *Zone_get(void)
 {
 	return &zone;
@@ -444,6 +526,10 @@ void Zone_save(void)
 {
 	if (zone.filepath[0] == '\0') return;
 
+	/* The file is about to diverge from any checkpoint snapshot of it */
+	if (strcmp(snapshot.path, zone.filepath) == 0)
+		snapshot.valid = false;
+
 	FILE *f = fopen(zone.filepath, "w");
 	if (!f) {
 		printf("Zone_save: failed to open '%s' for writing\n", zone.filepath);
@@ -629,6 +715,115 @@ void Zone_save(void)
 	fclose(f);
 }
 
+/* --- Checkpoint snapshot --- */
+
+static void pack_flags(uint8_t *bits, const bool grid[MAP_SIZE][MAP_SIZE])
+{
+	memset(bits, 0, MAP_SIZE * MAP_SIZE / 8);
+	for (int x = 0; x < MAP_SIZE; x++)
+		for (int y = 0; y < MAP_SIZE; y++)
+			if (grid[x][y]) {
+				int bit = x * MAP_SIZE + y;
+				bits[bit >> 3] |= (uint8_t)(1 << (bit & 7));
+			}
+}
+
+static void unpack_flags(bool grid[MAP_SIZE][MAP_SIZE], const uint8_t *bits)
+{
+	for (int x = 0; x < MAP_SIZE; x++)
+		for (int y = 0; y < MAP_SIZE; y++) {
+			int bit = x * MAP_SIZE + y;
+			grid[x][y] = (bits[bit >> 3] >> (bit & 7)) & 1;
+		}
+}
+
+void Zone_capture_snapshot(void)
+{
+	static int8_t cells[MAP_SIZE][MAP_SIZE];
+	static uint8_t flags[MAP_SIZE * MAP_SIZE / 8];
+
+	if (zone.filepath[0] == '\0') return;
+
+	snapshot.valid = true;
+	snapshot.size = 0;
+	strncpy(snapshot.path, zone.filepath, sizeof(snapshot.path) - 1);
+	snapshot.path[sizeof(snapshot.path) - 1] = '\0';
+
+	/* Header: name .. cell types */
+	snapshot_put(&zone, offsetof(Zone, cell_grid));
+
+	/* Cell type indices fit a byte (ZONE_MAX_CELL_TYPES), -1 stays -1 */
+	for (int x = 0; x < MAP_SIZE; x++)
+		for (int y = 0; y < MAP_SIZE; y++)
+			cells[x][y] = (int8_t)zone.cell_grid[x][y];
+	snapshot_put(cells, sizeof(cells));
+
+	/* spawn_count .. noise params, then only the used spawns */
+	snapshot_put((const uint8_t *)&zone + offsetof(Zone, spawn_count),
+		offsetof(Zone, cell_hand_placed) - offsetof(Zone, spawn_count));
+	snapshot_put(zone.spawns, (size_t)zone.spawn_count * sizeof(ZoneSpawn));
+
+	pack_flags(flags, zone.cell_hand_placed);
+	snapshot_put(flags, sizeof(flags));
+	pack_flags(flags, zone.cell_chunk_stamped);
+	snapshot_put(flags, sizeof(flags));
+
+	snapshot_put((const uint8_t *)&zone + offsetof(Zone, wall_type_indices),
+		sizeof(Zone) - offsetof(Zone, wall_type_indices));
+	/* Captured before the zone's spawn pass (e.g. a seeded start
+	   checkpoint) there are no rolls; restore rerolls instead */
+	snapshot_put(&spawnRollsValid, sizeof(spawnRollsValid));
+	snapshot_put(spawnRolled, (size_t)(zone.spawn_count + 7) / 8);
+}
+
+bool Zone_restore_snapshot(const char *path)
+{
+	if (!snapshot.valid || strcmp(snapshot.path, path) != 0)
+		return false;
+
+	memset(&zone, 0, sizeof(zone));
+	markerIndexReady = false;
+	reset_spawn_rolls();
+	const uint8_t *src = snapshot.data;
+	src = snapshot_get(src, &zone, offsetof(Zone, cell_grid));
+
+	for (int x = 0; x < MAP_SIZE; x++)
+		for (int y = 0; y < MAP_SIZE; y++)
+			zone.cell_grid[x][y] = (int8_t)src[x * MAP_SIZE + y];
+	src += MAP_SIZE * MAP_SIZE;
+
+	src = snapshot_get(src, (uint8_t *)&zone + offsetof(Zone, spawn_count),
+		offsetof(Zone, cell_hand_placed) - offsetof(Zone, spawn_count));
+	src = snapshot_get(src, zone.spawns, (size_t)zone.spawn_count * sizeof(ZoneSpawn));
+
+	unpack_flags(zone.cell_hand_placed, src);
+	src += MAP_SIZE * MAP_SIZE / 8;
+	unpack_flags(zone.cell_chunk_stamped, src);
+	src += MAP_SIZE * MAP_SIZE / 8;
+
+	src = snapshot_get(src, (uint8_t *)&zone + offsetof(Zone, wall_type_indices),
+		sizeof(Zone) - offsetof(Zone, wall_type_indices));
+	src = snapshot_get(src, &spawnRollsValid, sizeof(spawnRollsValid));
+	snapshot_get(src, spawnRolled, (size_t)(zone.spawn_count + 7) / 8);
+
+	undoCount = 0;
+	zoneDirty = false;
+
+	apply_zone_to_world();
+
+	/* Same population as the checkpointed visit — no reroll */
+	if (spawnRollsValid) {
+		for (int i = 0; i < zone.spawn_count; i++)
+			if (spawnRolled[i >> 3] & (1 << (i & 7)))
+				spawn_enemy(&zone.spawns[i]);
+	} else {
+		Zone_spawn_enemies();
+	}
+
+	printf("Zone restored from snapshot: %s (%zu KB)\n", zone.name, snapshot.size / 1024);
+	return true;
+}
+
 void Zone_save_if_dirty(void)
 {
 	if (!zoneDirty) return;
@@ -688,6 +883,8 @@ void Zone_place_spawn(const char *enemy_type, double world_x, double world_y)
 {
 	if (zone.spawn_count >= ZONE_MAX_SPAWNS) return;
 
+	ZoneIndex *ix = marker_index(ZONE_MARKER_SPAWN);
+
 	UndoEntry undo;
 	undo.type = UNDO_REMOVE_SPAWN;
 	undo.spawn_index = zone.spawn_count;
@@ -698,6 +895,7 @@ void Zone_place_spawn(const char *enemy_type, double world_x, double world_y)
 	sp->world_x = world_x;
 	sp->world_y = world_y;
 	sp->probability = 1.0f;
+	ZoneIndex_insert(ix, zone.spawn_count, world_x, world_y);
 	zone.spawn_count++;
 
 	/* Spawn in world */
@@ -728,10 +926,10 @@ void Zone_remove_spawn(int index)
 	undo.spawn_index = index;
 	push_undo(undo);
 
-	/* Shift spawns down */
-	for (int i = index; i < zone.spawn_count - 1; i++)
-		zone.spawns[i] = zone.spawns[i + 1];
-	zone.spawn_count--;
+	ZoneIndex_remove(marker_index(ZONE_MARKER_SPAWN), index);
+
+	/* Swap-remove, matching the marker index */
+	zone.spawns[index] = zone.spawns[--zone.spawn_count];
 
 	Zone_rebuild_enemies();
 	zoneDirty = true;
@@ -739,18 +937,22 @@ void Zone_remove_spawn(int index)
 
 int Zone_find_spawn_near(double world_x, double world_y, double radius)
 {
-	double best_dist = radius * radius;
-	int best_index = -1;
-	for (int i = 0; i < zone.spawn_count; i++) {
-		double dx = zone.spawns[i].world_x - world_x;
-		double dy = zone.spawns[i].world_y - world_y;
-		double d2 = dx * dx + dy * dy;
-		if (d2 < best_dist) {
-			best_dist = d2;
-			best_index = i;
-		}
-	}
-	return best_index;
+	return Zone_find_marker_near(ZONE_MARKER_SPAWN, world_x, world_y, radius);
+}
+
+int Zone_query_markers(ZoneMarkerKind kind, double min_x, double min_y,
+	double max_x, double max_y, int *out, int max_out)
+{
+	if (kind < 0 || kind >= ZONE_MARKER_KIND_COUNT) return 0;
+	return ZoneIndex_query(marker_index(kind), min_x, min_y, max_x, max_y,
+		out, max_out);
+}
+
+int Zone_find_marker_near(ZoneMarkerKind kind, double world_x, double world_y,
+	double radius)
+{
+	if (kind < 0 || kind >= ZONE_MARKER_KIND_COUNT) return -1;
+	return ZoneIndex_nearest(marker_index(kind), world_x, world_y, radius);
 }
 
 void Zone_place_portal(int grid_x, int grid_y,
@@ -759,11 +961,8 @@ void Zone_place_portal(int grid_x, int grid_y,
 	if (zone.portal_count >= ZONE_MAX_PORTALS) return;
 
 	/* Check for duplicate at same grid position */
-	for (int i = 0; i < zone.portal_count; i++) {
-		if (zone.portals[i].grid_x == grid_x &&
-		    zone.portals[i].grid_y == grid_y)
-			return;
-	}
+	if (find_marker_at(ZONE_MARKER_PORTAL, grid_x, grid_y) >= 0)
+		return;
 
 	UndoEntry undo;
 	undo.type = UNDO_REMOVE_PORTAL;
@@ -779,6 +978,8 @@ void Zone_place_portal(int grid_x, int grid_y,
 	p->dest_zone[255] = '\0';
 	strncpy(p->dest_portal_id, dest_portal_id, 31);
 	p->dest_portal_id[31] = '\0';
+	ZoneIndex_insert(marker_index(ZONE_MARKER_PORTAL), zone.portal_count,
+		grid_to_world(grid_x), grid_to_world(grid_y));
 	zone.portal_count++;
 
 	/* Spawn in world */
@@ -792,14 +993,7 @@ void Zone_place_portal(int grid_x, int grid_y,
 
 void Zone_remove_portal(int grid_x, int grid_y)
 {
-	int index = -1;
-	for (int i = 0; i < zone.portal_count; i++) {
-		if (zone.portals[i].grid_x == grid_x &&
-		    zone.portals[i].grid_y == grid_y) {
-			index = i;
-			break;
-		}
-	}
+	int index = find_marker_at(ZONE_MARKER_PORTAL, grid_x, grid_y);
 	if (index < 0) return;
 
 	UndoEntry undo;
@@ -808,9 +1002,8 @@ void Zone_remove_portal(int grid_x, int grid_y)
 	undo.portal_index = index;
 	push_undo(undo);
 
-	for (int i = index; i < zone.portal_count - 1; i++)
-		zone.portals[i] = zone.portals[i + 1];
-	zone.portal_count--;
+	ZoneIndex_remove(marker_index(ZONE_MARKER_PORTAL), index);
+	zone.portals[index] = zone.portals[--zone.portal_count];
 
 	respawn_portals();
 	zoneDirty = true;
@@ -821,11 +1014,8 @@ void Zone_place_savepoint(int grid_x, int grid_y, const char *id)
 	if (zone.savepoint_count >= ZONE_MAX_SAVEPOINTS) return;
 
 	/* Check for duplicate at same grid position */
-	for (int i = 0; i < zone.savepoint_count; i++) {
-		if (zone.savepoints[i].grid_x == grid_x &&
-		    zone.savepoints[i].grid_y == grid_y)
-			return;
-	}
+	if (find_marker_at(ZONE_MARKER_SAVEPOINT, grid_x, grid_y) >= 0)
+		return;
 
 	UndoEntry undo;
 	undo.type = UNDO_REMOVE_SAVEPOINT;
@@ -837,6 +1027,8 @@ void Zone_place_savepoint(int grid_x, int grid_y, const char *id)
 	sp->grid_y = grid_y;
 	strncpy(sp->id, id, 31);
 	sp->id[31] = '\0';
+	ZoneIndex_insert(marker_index(ZONE_MARKER_SAVEPOINT), zone.savepoint_count,
+		grid_to_world(grid_x), grid_to_world(grid_y));
 	zone.savepoint_count++;
 
 	/* Spawn in world */
@@ -850,14 +1042,7 @@ void Zone_place_savepoint(int grid_x, int grid_y, const char *id)
 
 void Zone_remove_savepoint(int grid_x, int grid_y)
 {
-	int index = -1;
-	for (int i = 0; i < zone.savepoint_count; i++) {
-		if (zone.savepoints[i].grid_x == grid_x &&
-		    zone.savepoints[i].grid_y == grid_y) {
-			index = i;
-			break;
-		}
-	}
+	int index = find_marker_at(ZONE_MARKER_SAVEPOINT, grid_x, grid_y);
 	if (index < 0) return;
 
 	UndoEntry undo;
@@ -866,9 +1051,8 @@ void Zone_remove_savepoint(int grid_x, int grid_y)
 	undo.savepoint_index = index;
 	push_undo(undo);
 
-	for (int i = index; i < zone.savepoint_count - 1; i++)
-		zone.savepoints[i] = zone.savepoints[i + 1];
-	zone.savepoint_count--;
+	ZoneIndex_remove(marker_index(ZONE_MARKER_SAVEPOINT), index);
+	zone.savepoints[index] = zone.savepoints[--zone.savepoint_count];
 
 	respawn_savepoints();
 	zoneDirty = true;
@@ -880,11 +1064,8 @@ void Zone_place_label(int grid_x, int grid_y, const char *text)
 	if (grid_x < 0 || grid_x >= MAP_SIZE || grid_y < 0 || grid_y >= MAP_SIZE) return;
 
 	/* Check for duplicate at same grid position */
-	for (int i = 0; i < zone.label_count; i++) {
-		if (zone.labels[i].grid_x == grid_x &&
-		    zone.labels[i].grid_y == grid_y)
-			return;
-	}
+	if (find_marker_at(ZONE_MARKER_LABEL, grid_x, grid_y) >= 0)
+		return;
 
 	UndoEntry undo;
 	undo.type = UNDO_REMOVE_LABEL;
@@ -896,6 +1077,8 @@ void Zone_place_label(int grid_x, int grid_y, const char *text)
 	lb->grid_y = grid_y;
 	strncpy(lb->text, text, sizeof(lb->text) - 1);
 	lb->text[sizeof(lb->text) - 1] = '\0';
+	ZoneIndex_insert(marker_index(ZONE_MARKER_LABEL), zone.label_count,
+		grid_to_world(grid_x), grid_to_world(grid_y));
 	zone.label_count++;
 
 	zoneDirty = true;
@@ -903,14 +1086,7 @@ void Zone_place_label(int grid_x, int grid_y, const char *text)
 
 void Zone_remove_label(int grid_x, int grid_y)
 {
-	int index = -1;
-	for (int i = 0; i < zone.label_count; i++) {
-		if (zone.labels[i].grid_x == grid_x &&
-		    zone.labels[i].grid_y == grid_y) {
-			index = i;
-			break;
-		}
-	}
+	int index = find_marker_at(ZONE_MARKER_LABEL, grid_x, grid_y);
 	if (index < 0) return;
 
 	UndoEntry undo;
@@ -919,9 +1095,8 @@ void Zone_remove_label(int grid_x, int grid_y)
 	undo.label_index = index;
 	push_undo(undo);
 
-	for (int i = index; i < zone.label_count - 1; i++)
-		zone.labels[i] = zone.labels[i + 1];
-	zone.label_count--;
+	ZoneIndex_remove(marker_index(ZONE_MARKER_LABEL), index);
+	zone.labels[index] = zone.labels[--zone.label_count];
 
 	zoneDirty = true;
 }
@@ -931,11 +1106,8 @@ void Zone_place_datanode(int grid_x, int grid_y, const char *node_id)
 	if (zone.datanode_count >= ZONE_MAX_DATANODES) return;
 
 	/* Check for duplicate at same grid position */
-	for (int i = 0; i < zone.datanode_count; i++) {
-		if (zone.datanodes[i].grid_x == grid_x &&
-		    zone.datanodes[i].grid_y == grid_y)
-			return;
-	}
+	if (find_marker_at(ZONE_MARKER_DATANODE, grid_x, grid_y) >= 0)
+		return;
 
 	UndoEntry undo;
 	undo.type = UNDO_REMOVE_DATANODE;
@@ -947,6 +1119,8 @@ void Zone_place_datanode(int grid_x, int grid_y, const char *node_id)
 	dn->grid_y = grid_y;
 	strncpy(dn->node_id, node_id, 31);
 	dn->node_id[31] = '\0';
+	ZoneIndex_insert(marker_index(ZONE_MARKER_DATANODE), zone.datanode_count,
+		grid_to_world(grid_x), grid_to_world(grid_y));
 	zone.datanode_count++;
 
 	/* Spawn in world */
@@ -960,14 +1134,7 @@ void Zone_place_datanode(int grid_x, int grid_y, const char *node_id)
 
 void Zone_remove_datanode(int grid_x, int grid_y)
 {
-	int index = -1;
-	for (int i = 0; i < zone.datanode_count; i++) {
-		if (zone.datanodes[i].grid_x == grid_x &&
-		    zone.datanodes[i].grid_y == grid_y) {
-			index = i;
-			break;
-		}
-	}
+	int index = find_marker_at(ZONE_MARKER_DATANODE, grid_x, grid_y);
 	if (index < 0) return;
 
 	UndoEntry undo;
@@ -976,9 +1143,8 @@ void Zone_remove_datanode(int grid_x, int grid_y)
 	undo.datanode_index = index;
 	push_undo(undo);
 
-	for (int i = index; i < zone.datanode_count - 1; i++)
-		zone.datanodes[i] = zone.datanodes[i + 1];
-	zone.datanode_count--;
+	ZoneIndex_remove(marker_index(ZONE_MARKER_DATANODE), index);
+	zone.datanodes[index] = zone.datanodes[--zone.datanode_count];
 
 	respawn_datanodes();
 	zoneDirty = true;
@@ -1053,10 +1219,11 @@ void Zone_undo(void)
 		Map_clear_cell(undo.grid_x, undo.grid_y);
 		break;
 	case UNDO_PLACE_SPAWN:
-		/* Re-insert spawn at original index */
+		/* Re-insert spawn at original index, undoing the swap-remove */
 		if (zone.spawn_count < ZONE_MAX_SPAWNS) {
-			for (int i = zone.spawn_count; i > undo.spawn_index; i--)
-				zone.spawns[i] = zone.spawns[i - 1];
+			ZoneIndex_insert(marker_index(ZONE_MARKER_SPAWN), undo.spawn_index,
+				undo.spawn.world_x, undo.spawn.world_y);
+			zone.spawns[zone.spawn_count] = zone.spawns[undo.spawn_index];
 			zone.spawns[undo.spawn_index] = undo.spawn;
 			zone.spawn_count++;
 		}
@@ -1064,15 +1231,18 @@ void Zone_undo(void)
 		break;
 	case UNDO_REMOVE_SPAWN:
 		/* Remove last spawn */
-		if (zone.spawn_count > undo.spawn_index)
+		if (zone.spawn_count > undo.spawn_index) {
+			ZoneIndex_truncate(marker_index(ZONE_MARKER_SPAWN), undo.spawn_index);
 			zone.spawn_count = undo.spawn_index;
+		}
 		Zone_rebuild_enemies();
 		break;
 	case UNDO_PLACE_PORTAL:
-		/* Re-insert portal at original index */
+		/* Re-insert portal at original index, undoing the swap-remove */
 		if (zone.portal_count < ZONE_MAX_PORTALS) {
-			for (int i = zone.portal_count; i > undo.portal_index; i--)
-				zone.portals[i] = zone.portals[i - 1];
+			ZoneIndex_insert(marker_index(ZONE_MARKER_PORTAL), undo.portal_index,
+				grid_to_world(undo.portal.grid_x), grid_to_world(undo.portal.grid_y));
+			zone.portals[zone.portal_count] = zone.portals[undo.portal_index];
 			zone.portals[undo.portal_index] = undo.portal;
 			zone.portal_count++;
 		}
@@ -1080,15 +1250,18 @@ void Zone_undo(void)
 		break;
 	case UNDO_REMOVE_PORTAL:
 		/* Remove last portal */
-		if (zone.portal_count > undo.portal_index)
+		if (zone.portal_count > undo.portal_index) {
+			ZoneIndex_truncate(marker_index(ZONE_MARKER_PORTAL), undo.portal_index);
 			zone.portal_count = undo.portal_index;
+		}
 		respawn_portals();
 		break;
 	case UNDO_PLACE_SAVEPOINT:
-		/* Re-insert savepoint at original index */
+		/* Re-insert savepoint at original index, undoing the swap-remove */
 		if (zone.savepoint_count < ZONE_MAX_SAVEPOINTS) {
-			for (int i = zone.savepoint_count; i > undo.savepoint_index; i--)
-				zone.savepoints[i] = zone.savepoints[i - 1];
+			ZoneIndex_insert(marker_index(ZONE_MARKER_SAVEPOINT), undo.savepoint_index,
+				grid_to_world(undo.savepoint.grid_x), grid_to_world(undo.savepoint.grid_y));
+			zone.savepoints[zone.savepoint_count] = zone.savepoints[undo.savepoint_index];
 			zone.savepoints[undo.savepoint_index] = undo.savepoint;
 			zone.savepoint_count++;
 		}
@@ -1096,29 +1269,35 @@ void Zone_undo(void)
 		break;
 	case UNDO_REMOVE_SAVEPOINT:
 		/* Remove last savepoint */
-		if (zone.savepoint_count > undo.savepoint_index)
+		if (zone.savepoint_count > undo.savepoint_index) {
+			ZoneIndex_truncate(marker_index(ZONE_MARKER_SAVEPOINT), undo.savepoint_index);
 			zone.savepoint_count = undo.savepoint_index;
+		}
 		respawn_savepoints();
 		break;
 	case UNDO_PLACE_LABEL:
-		/* Re-insert label at original index */
+		/* Re-insert label at original index, undoing the swap-remove */
 		if (zone.label_count < ZONE_MAX_LABELS) {
-			for (int i = zone.label_count; i > undo.label_index; i--)
-				zone.labels[i] = zone.labels[i - 1];
+			ZoneIndex_insert(marker_index(ZONE_MARKER_LABEL), undo.label_index,
+				grid_to_world(undo.label.grid_x), grid_to_world(undo.label.grid_y));
+			zone.labels[zone.label_count] = zone.labels[undo.label_index];
 			zone.labels[undo.label_index] = undo.label;
 			zone.label_count++;
 		}
 		break;
 	case UNDO_REMOVE_LABEL:
 		/* Remove last label */
-		if (zone.label_count > undo.label_index)
+		if (zone.label_count > undo.label_index) {
+			ZoneIndex_truncate(marker_index(ZONE_MARKER_LABEL), undo.label_index);
 			zone.label_count = undo.label_index;
+		}
 		break;
 	case UNDO_PLACE_DATANODE:
-		/* Re-insert datanode at original index */
+		/* Re-insert datanode at original index, undoing the swap-remove */
 		if (zone.datanode_count < ZONE_MAX_DATANODES) {
-			for (int i = zone.datanode_count; i > undo.datanode_index; i--)
-				zone.datanodes[i] = zone.datanodes[i - 1];
+			ZoneIndex_insert(marker_index(ZONE_MARKER_DATANODE), undo.datanode_index,
+				grid_to_world(undo.datanode.grid_x), grid_to_world(undo.datanode.grid_y));
+			zone.datanodes[zone.datanode_count] = zone.datanodes[undo.datanode_index];
 			zone.datanodes[undo.datanode_index] = undo.datanode;
 			zone.datanode_count++;
 		}
@@ -1126,8 +1305,10 @@ void Zone_undo(void)
 		break;
 	case UNDO_REMOVE_DATANODE:
 		/* Remove last datanode */
-		if (zone.datanode_count > undo.datanode_index)
+		if (zone.datanode_count > undo.datanode_index) {
+			ZoneIndex_truncate(marker_index(ZONE_MARKER_DATANODE), undo.datanode_index);
 			zone.datanode_count = undo.datanode_index;
+		}
 		respawn_datanodes();
 		break;
 	}
@@ -1165,6 +1346,7 @@ void Zone_regenerate_procgen(void)
 	zone.savepoint_count = zone.hand_savepoint_count;
 	zone.spawn_count = zone.hand_spawn_count;
 	zone.datanode_count = zone.hand_datanode_count;
+	markerIndexReady = false;
 
 	/* Regenerate from current master seed */
 	Procgen_generate(&zone);
@@ -1198,13 +1380,39 @@ void Zone_rebuild_enemies(void)
 	Corruptor_cleanup();
 	BossPyraxis_cleanup();
 	EnemyRegistry_clear();
-	Entity_recalculate_highest_index();
 	Zone_spawn_enemies();
 }
 
+static void spawn_enemy(const ZoneSpawn *sp)
+{
+	Position pos = {sp->world_x, sp->world_y};
+	if (strcmp(sp->enemy_type, "mine") == 0)
+		Mine_initialize(pos, zone.theme);
+	else if (strcmp(sp->enemy_type, "hunter") == 0)
+		Hunter_initialize(pos, zone.theme);
+	else if (strcmp(sp->enemy_type, "seeker") == 0)
+		Seeker_initialize(pos, zone.theme);
+	else if (strcmp(sp->enemy_type, "defender") == 0)
+		Defender_initialize(pos, zone.theme);
+	else if (strcmp(sp->enemy_type, "stalker") == 0)
+		Stalker_initialize(pos, zone.theme);
+	else if (strcmp(sp->enemy_type, "corruptor") == 0)
+		Corruptor_initialize(pos, zone.theme);
+	else if (strcmp(sp->enemy_type, "boss_pyraxis") == 0)
+		BossPyraxis_initialize(pos);
+}
+
+static void reset_spawn_rolls(void)
+{
+	memset(spawnRolled, 0, sizeof(spawnRolled));
+	spawnRollsValid = false;
+}
+
 /* Spawn enemy entities from zone spawn data */
 void Zone_spawn_enemies(void)
 {
+	reset_spawn_rolls();
+	spawnRollsValid = true;
 	for (int i = 0; i < zone.spawn_count; i++) {
 		ZoneSpawn *sp = &zone.spawns[i];
 
@@ -1215,21 +1423,8 @@ void Zone_spawn_enemies(void)
 				continue;
 		}
 
-		Position pos = {sp->world_x, sp->world_y};
-		if (strcmp(sp->enemy_type, "mine") == 0)
-			Mine_initialize(pos, zone.theme);
-		else if (strcmp(sp->enemy_type, "hunter") == 0)
-			Hunter_initialize(pos, zone.theme);
-		else if (strcmp(sp->enemy_type, "seeker") == 0)
-			Seeker_initialize(pos, zone.theme);
-		else if (strcmp(sp->enemy_type, "defender") == 0)
-			Defender_initialize(pos, zone.theme);
-		else if (strcmp(sp->enemy_type, "stalker") == 0)
-			Stalker_initialize(pos, zone.theme);
-		else if (strcmp(sp->enemy_type, "corruptor") == 0)
-			Corruptor_initialize(pos, zone.theme);
-		else if (strcmp(sp->enemy_type, "boss_pyraxis") == 0)
-			BossPyraxis_initialize(pos);
+		spawnRolled[i >> 3] |= (uint8_t)(1 << (i & 7));
+		spawn_enemy(sp);
 	}
 }
 
@@ -1286,7 +1481,6 @@ static void apply_zone_to_world(void)
 	EnemyRegistry_clear();
 	Portal_cleanup();
 	Savepoint_cleanup();
-	Entity_recalculate_highest_index();
 
 	/* Apply background palette */
 	if (zone.has_bg_colors) {
@@ -1302,18 +1496,15 @@ static void apply_zone_to_world(void)
 	}
 	Background_initialize();
 
-	/* Place cells */
-	for (int x = 0; x < MAP_SIZE; x++) {
-		for (int y = 0; y < MAP_SIZE; y++) {
-			int idx = zone.cell_grid[x][y];
-			if (idx < 0) continue;
-
-			ZoneCellType *ct = &zone.cell_types[idx];
-			MapCell cell = {false, strcmp(ct->pattern, "circuit") == 0,
-				ct->primaryColor, ct->outlineColor};
-			Map_set_cell(x, y, &cell);
-		}
+	/* Place cells — resolve each cell type once, then bulk-load the grid */
+	MapCell types[ZONE_MAX_CELL_TYPES];
+	for (int i = 0; i < zone.cell_type_count; i++) {
+		ZoneCellType *ct = &zone.cell_types[i];
+		types[i] = (MapCell){false, strcmp(ct->pattern, "circuit") == 0,
+			ct->primaryColor, ct->outlineColor};
 	}
+	Map_load_cells((const int (*)[MAP_SIZE])zone.cell_grid,
+		types, zone.cell_type_count);
 
 	/* Enemies are NOT spawned here — callers use Zone_spawn_enemies() */
 
@@ -1349,6 +1540,57 @@ static void apply_zone_to_world(void)
 		MapCell boundary = {false, false, ct->primaryColor, ct->outlineColor};
 		Map_set_boundary_cell(&boundary);
 	}
+
+	/* Build neighbour masks now rather than on the first rendered frame */
+	Map_rebuild_adjacency();
+}
+
+static double grid_to_world(int grid)
+{
+	return (grid - HALF_MAP_SIZE) * MAP_CELL_SIZE;
+}
+
+static void rebuild_marker_indexes(void)
+{
+	ZoneIndex_init(&markerIndex[ZONE_MARKER_SPAWN], spawnEntries, ZONE_MAX_SPAWNS);
+	ZoneIndex_init(&markerIndex[ZONE_MARKER_PORTAL], portalEntries, ZONE_MAX_PORTALS);
+	ZoneIndex_init(&markerIndex[ZONE_MARKER_SAVEPOINT], savepointEntries, ZONE_MAX_SAVEPOINTS);
+	ZoneIndex_init(&markerIndex[ZONE_MARKER_DATANODE], datanodeEntries, ZONE_MAX_DATANODES);
+	ZoneIndex_init(&markerIndex[ZONE_MARKER_LABEL], labelEntries, ZONE_MAX_LABELS);
+
+	for (int i = 0; i < zone.spawn_count; i++)
+		ZoneIndex_insert(&markerIndex[ZONE_MARKER_SPAWN], i,
+			zone.spawns[i].world_x, zone.spawns[i].world_y);
+	for (int i = 0; i < zone.portal_count; i++)
+		ZoneIndex_insert(&markerIndex[ZONE_MARKER_PORTAL], i,
+			grid_to_world(zone.portals[i].grid_x), grid_to_world(zone.portals[i].grid_y));
+	for (int i = 0; i < zone.savepoint_count; i++)
+		ZoneIndex_insert(&markerIndex[ZONE_MARKER_SAVEPOINT], i,
+			grid_to_world(zone.savepoints[i].grid_x), grid_to_world(zone.savepoints[i].grid_y));
+	for (int i = 0; i < zone.datanode_count; i++)
+		ZoneIndex_insert(&markerIndex[ZONE_MARKER_DATANODE], i,
+			grid_to_world(zone.datanodes[i].grid_x), grid_to_world(zone.datanodes[i].grid_y));
+	for (int i = 0; i < zone.label_count; i++)
+		ZoneIndex_insert(&markerIndex[ZONE_MARKER_LABEL], i,
+			grid_to_world(zone.labels[i].grid_x), grid_to_world(zone.labels[i].grid_y));
+
+	markerIndexReady = true;
+}
+
+/* Call before mutating the matching array, so a stale index is rebuilt
+   from the pre-edit state the edit is then applied to */
+static ZoneIndex *marker_index(ZoneMarkerKind kind)
+{
+	if (!markerIndexReady)
+		rebuild_marker_indexes();
+	return &markerIndex[kind];
+}
+
+/* Grid markers sit exactly on cell origins, so half a unit is a match */
+static int find_marker_at(ZoneMarkerKind kind, int grid_x, int grid_y)
+{
+	return ZoneIndex_nearest(marker_index(kind),
+		grid_to_world(grid_x), grid_to_world(grid_y), 0.5);
 }
 
 static void push_undo(UndoEntry entry)
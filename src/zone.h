@@ -187,18 +187,43 @@ typedef struct {
 } Zone;
 
 void Zone_load(const char *path);
+/* Phase timings of the last Zone_load, in milliseconds (see
+   bench/bench_zone.c); procgen's own phases are in Procgen_get_timings */
+typedef struct {
+	double parse;
+	double procgen;
+	double apply;   /* apply_zone_to_world */
+} ZoneLoadTimings;
+const ZoneLoadTimings *Zone_get_load_timings(void);
 void Zone_unload(void);
 void Zone_save(void);
 void Zone_save_if_dirty(void);
 const Zone *Zone_get(void);
 ZoneTheme Zone_get_theme(void);
 
+/* Marker arrays with a spatial index, for god-mode lookups and culling */
+typedef enum {
+	ZONE_MARKER_SPAWN,
+	ZONE_MARKER_PORTAL,
+	ZONE_MARKER_SAVEPOINT,
+	ZONE_MARKER_DATANODE,
+	ZONE_MARKER_LABEL,
+	ZONE_MARKER_KIND_COUNT
+} ZoneMarkerKind;
+
 /* Editing API (for God Mode) */
 void Zone_place_cell(int grid_x, int grid_y, const char *type_id);
 void Zone_remove_cell(int grid_x, int grid_y);
 void Zone_place_spawn(const char *enemy_type, double world_x, double world_y);
 void Zone_remove_spawn(int index);
 int Zone_find_spawn_near(double world_x, double world_y, double radius);
+/* Indices into the kind's array of markers inside the world rectangle
+   (edges inclusive), in no particular order; at most max_out are written */
+int Zone_query_markers(ZoneMarkerKind kind, double min_x, double min_y,
+	double max_x, double max_y, int *out, int max_out);
+/* Nearest marker of the kind strictly within radius, or -1 */
+int Zone_find_marker_near(ZoneMarkerKind kind, double world_x, double world_y,
+	double radius);
 void Zone_place_portal(int grid_x, int grid_y,
 	const char *id, const char *dest_zone, const char *dest_portal_id);
 void Zone_remove_portal(int grid_x, int grid_y);
@@ -216,6 +241,11 @@ const ZoneDestructible *Zone_get_destructible(int grid_x, int grid_y);
 void Zone_spawn_enemies(void);
 void Zone_rebuild_enemies(void);
 
+/* Checkpoint snapshot: in-memory copy of the generated zone and its rolled
+   spawns, so a death respawn skips parsing and procgen */
+void Zone_capture_snapshot(void);
+bool Zone_restore_snapshot(const char *path);
+
 /* Color mutation (for palette editor) */
 void Zone_set_bg_color(int idx, ColorRGB color);
 void Zone_set_celltype_colors(int type_idx, ColorRGB primary, ColorRGB outline);
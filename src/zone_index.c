@@ -0,0 +1,145 @@
+#include "zone_index.h"
+
+#include <math.h>
+
+static int bucket_coord(double v)
+{
+	double b = floor(v / ZONE_INDEX_BUCKET_SIZE) + ZONE_INDEX_BUCKETS_PER_SIDE / 2;
+	if (!(b >= 0.0)) return 0;   /* also catches NaN */
+	if (b >= ZONE_INDEX_BUCKETS_PER_SIDE) return ZONE_INDEX_BUCKETS_PER_SIDE - 1;
+	return (int)b;
+}
+
+static int bucket_of(double x, double y)
+{
+	return bucket_coord(y) * ZONE_INDEX_BUCKETS_PER_SIDE + bucket_coord(x);
+}
+
+static void link_entry(ZoneIndex *ix, int i)
+{
+	ZoneIndexEntry *e = &ix->entries[i];
+	int b = bucket_of(e->x, e->y);
+	e->prev = -1;
+	e->next = ix->head[b];
+	if (e->next >= 0)
+		ix->entries[e->next].prev = i;
+	ix->head[b] = i;
+}
+
+static void unlink_entry(ZoneIndex *ix, int i)
+{
+	ZoneIndexEntry *e = &ix->entries[i];
+	if (e->prev >= 0)
+		ix->entries[e->prev].next = e->next;
+	else
+		ix->head[bucket_of(e->x, e->y)] = e->next;
+	if (e->next >= 0)
+		ix->entries[e->next].prev = e->prev;
+}
+
+/* Move element `from` into the unlinked slot `to`, repointing its neighbours */
+static void move_entry(ZoneIndex *ix, int from, int to)
+{
+	ZoneIndexEntry *e = &ix->entries[to];
+	*e = ix->entries[from];
+	if (e->prev >= 0)
+		ix->entries[e->prev].next = to;
+	else
+		ix->head[bucket_of(e->x, e->y)] = to;
+	if (e->next >= 0)
+		ix->entries[e->next].prev = to;
+}
+
+void ZoneIndex_init(ZoneIndex *ix, ZoneIndexEntry *storage, int capacity)
+{
+	ix->entries = storage;
+	ix->capacity = capacity;
+	ZoneIndex_clear(ix);
+}
+
+void ZoneIndex_clear(ZoneIndex *ix)
+{
+	for (int b = 0; b < ZONE_INDEX_BUCKETS; b++)
+		ix->head[b] = -1;
+	ix->count = 0;
+}
+
+void ZoneIndex_insert(ZoneIndex *ix, int index, double x, double y)
+{
+	if (ix->count >= ix->capacity || index < 0 || index > ix->count)
+		return;
+
+	/* Whatever held the slot moves to the end, undoing a swap-remove */
+	if (index < ix->count)
+		move_entry(ix, index, ix->count);
+
+	ix->entries[index].x = x;
+	ix->entries[index].y = y;
+	link_entry(ix, index);
+	ix->count++;
+}
+
+void ZoneIndex_remove(ZoneIndex *ix, int index)
+{
+	if (index < 0 || index >= ix->count)
+		return;
+
+	unlink_entry(ix, index);
+	ix->count--;
+	if (index < ix->count)
+		move_entry(ix, ix->count, index);
+}
+
+void ZoneIndex_truncate(ZoneIndex *ix, int count)
+{
+	if (count < 0)
+		count = 0;
+	while (ix->count > count)
+		unlink_entry(ix, --ix->count);
+}
+
+int ZoneIndex_query(const ZoneIndex *ix, double min_x, double min_y,
+	double max_x, double max_y, int *out, int max_out)
+{
+	int bx0 = bucket_coord(min_x), bx1 = bucket_coord(max_x);
+	int by0 = bucket_coord(min_y), by1 = bucket_coord(max_y);
+	int n = 0;
+
+	for (int by = by0; by <= by1; by++)
+		for (int bx = bx0; bx <= bx1; bx++) {
+			int i = ix->head[by * ZONE_INDEX_BUCKETS_PER_SIDE + bx];
+			for (; i >= 0; i = ix->entries[i].next) {
+				const ZoneIndexEntry *e = &ix->entries[i];
+				if (e->x < min_x || e->x > max_x || e->y < min_y || e->y > max_y)
+					continue;
+				if (n >= max_out)
+					return n;
+				out[n++] = i;
+			}
+		}
+	return n;
+}
+
+int ZoneIndex_nearest(const ZoneIndex *ix, double x, double y, double radius)
+{
+	int bx0 = bucket_coord(x - radius), bx1 = bucket_coord(x + radius);
+	int by0 = bucket_coord(y - radius), by1 = bucket_coord(y + radius);
+	double best_dist = radius * radius;
+	int best_index = -1;
+
+	for (int by = by0; by <= by1; by++)
+		for (int bx = bx0; bx <= bx1; bx++) {
+			int i = ix->head[by * ZONE_INDEX_BUCKETS_PER_SIDE + bx];
+			for (; i >= 0; i = ix->entries[i].next) {
+				double dx = ix->entries[i].x - x;
+				double dy = ix->entries[i].y - y;
+				double d2 = dx * dx + dy * dy;
+				if (d2 < best_dist ||
+				    (d2 == best_dist && best_index >= 0 && i < best_index)) {
+					best_dist = d2;
+					best_index = i;
+				}
+			}
+		}
+	return best_index;
+}
@@ -0,0 +1,49 @@
+#ifndef ZONE_INDEX_H
+#define ZONE_INDEX_H
+
+#include "map.h"
+
+/*
+ * Grid-bucketed point index over one of the zone's marker arrays (spawns,
+ * portals, labels, ...). Elements are identified by their position in
+ * that array. Removal is a swap-remove (the last element fills the hole)
+ * and insert is its exact inverse, so the zone mirrors both on its own
+ * arrays and every edit and undo stays O(1) with no renumbering.
+ *
+ * Buckets are ZONE_INDEX_BUCKET_SIZE world units square over the map;
+ * points outside the map fall into the edge buckets.
+ */
+#define ZONE_INDEX_BUCKETS_PER_SIDE 64
+#define ZONE_INDEX_BUCKETS (ZONE_INDEX_BUCKETS_PER_SIDE * ZONE_INDEX_BUCKETS_PER_SIDE)
+#define ZONE_INDEX_BUCKET_SIZE (MAP_CELL_SIZE * MAP_SIZE / ZONE_INDEX_BUCKETS_PER_SIDE)
+
+typedef struct {
+	double x, y;
+	int next;           /* next element in the same bucket, or -1 */
+	int prev;           /* previous element in the same bucket, or -1 at the head */
+} ZoneIndexEntry;
+
+typedef struct {
+	int head[ZONE_INDEX_BUCKETS];
+	ZoneIndexEntry *entries;   /* caller storage, one per array slot */
+	int capacity;
+	int count;
+} ZoneIndex;
+
+void ZoneIndex_init(ZoneIndex *ix, ZoneIndexEntry *storage, int capacity);
+void ZoneIndex_clear(ZoneIndex *ix);
+/* Element `index` is now at (x, y); the one it displaces moves to the end */
+void ZoneIndex_insert(ZoneIndex *ix, int index, double x, double y);
+/* Drop element `index`; the last element moves into its slot */
+void ZoneIndex_remove(ZoneIndex *ix, int index);
+/* Drop every element at or after count */
+void ZoneIndex_truncate(ZoneIndex *ix, int count);
+
+/* Indices of elements inside the rectangle (edges inclusive), in no
+   particular order. Returns how many were written, at most max_out. */
+int ZoneIndex_query(const ZoneIndex *ix, double min_x, double min_y,
+	double max_x, double max_y, int *out, int max_out);
+/* Nearest element strictly within radius, lowest index on ties; -1 if none */
+int ZoneIndex_nearest(const ZoneIndex *ix, double x, double y, double radius);
+
+#endif